@@ -51,6 +51,11 @@ parser.add_argument(
     "components",
     help="components of a compound flag, if applicable, joined with :",
 )
+parser.add_argument(
+    "kept",
+    help="whether the flag is kept when only some flags are compiled in "
+    "(True or False)",
+)
 
 args = parser.parse_args()
 
@@ -63,6 +68,7 @@ else:
     print(f'Unrecognized "FMT" value {fmt}', file=sys.stderr)
     sys.exit(1)
 components = args.components.split(":") if args.components else []
+kept = args.kept.lower() == "true"
 
 code = code_formatter()
 
@@ -104,7 +110,7 @@ inline union ${{args.name}}
         "${{args.name}}", "${{args.desc}}", {
             ${{",\\n            ".join(
                 f"(Flag *)&::gem5::debug::{flag}" for flag in components)}}
-        }
+        }, ${{"true" if kept else "false"}}
     };
 } ${{args.name}};
 """
@@ -116,7 +122,8 @@ inline union ${{args.name}}
 {
     ~${{args.name}}() {}
     SimpleFlag ${{args.name}} = {
-        "${{args.name}}", "${{args.desc}}", ${{"true" if fmt else "false"}}
+        "${{args.name}}", "${{args.desc}}", ${{"true" if fmt else "false"}},
+        ${{"true" if kept else "false"}}
     };
 } ${{args.name}};
 """
@@ -129,6 +136,14 @@ code(
 inline constexpr const auto& ${{args.name}} =
     ::gem5::debug::unions::${{args.name}}.${{args.name}};
 
+namespace compiled
+{
+
+inline constexpr bool ${{args.name}} =
+    TRACING_ALL_FLAGS || ${{"true" if kept else "false"}};
+
+} // namespace compiled
+
 } // namespace debug
 } // namespace gem5
 
@@ -775,6 +775,8 @@ def makeDistRoot(
     linkspeed,
     linkdelay,
     dumpfile,
+    transport="tcp",
+    adaptive_sync=False,
 ):
     self = Root(full_system=True)
     self.testsys = testSystem
@@ -788,6 +790,8 @@ def makeDistRoot(
         server_port=server_port,
         sync_start=sync_start,
         sync_repeat=sync_repeat,
+        transport=transport,
+        adaptive_sync=adaptive_sync,
     )
 
     if hasattr(testSystem, "realview"):
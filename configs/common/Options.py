@@ -432,6 +432,19 @@ def addCommonOptions(parser, default_isa: Optional[ISA] = None):
         help="Repeat interval for synchronisation barriers among "
         "dist-gem5 processes\nDEFAULT: --ethernet-linkdelay",
     )
+    parser.add_argument(
+        "--dist-adaptive-sync",
+        action="store_true",
+        help="Move dist-gem5 synchronisation barriers out while all "
+        "processes are idle",
+    )
+    parser.add_argument(
+        "--dist-transport",
+        default="tcp",
+        choices=["tcp", "shm"],
+        help="Transport among dist-gem5 processes, shm requires all of "
+        "them on the same host\nDEFAULT: tcp",
+    )
     parser.add_argument(
         "--dist-sync-start",
         default="5200000000000t",
@@ -643,6 +656,23 @@ def addCommonOptions(parser, default_isa: Optional[ISA] = None):
         default=None,
         help="Number of instructions to fast forward before switching",
     )
+    parser.add_argument(
+        "--functional-warming",
+        action="store_true",
+        default=False,
+        help="""Fast forward with the caches bypassed, and functionally
+                warm them from the accesses of the fast forwarding CPU.""",
+    )
+    parser.add_argument(
+        "--sample-queues",
+        action="store",
+        type=str,
+        default=None,
+        metavar="INTERVAL",
+        help="""Sample the occupancy of the cache and memory controller
+                queues every INTERVAL, e.g. 1us, into
+                queue_occupancy.bin.gz.""",
+    )
     parser.add_argument(
         "-S",
         "--simpoint",
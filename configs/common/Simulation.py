@@ -82,10 +82,16 @@ def setCPUClass(options):
     elif options.fast_forward:
         CPUClass = TmpClass
         CPUISA = ObjectList.cpu_list.get_isa(options.cpu_type)
-        TmpClass = getCPUClass(
-            CpuConfig.isa_string_map[CPUISA] + "AtomicSimpleCPU"
-        )
-        test_mem_mode = "atomic"
+        if options.functional_warming:
+            # The caches are bypassed and only have their tags warmed
+            TmpClass, test_mem_mode = getCPUClass(
+                CpuConfig.isa_string_map[CPUISA] + "NonCachingSimpleCPU"
+            )
+        else:
+            TmpClass = getCPUClass(
+                CpuConfig.isa_string_map[CPUISA] + "AtomicSimpleCPU"
+            )
+            test_mem_mode = "atomic"
 
     # Ruby only supports atomic accesses in noncaching mode
     if test_mem_mode == "atomic" and options.ruby:
@@ -95,6 +101,39 @@ def setCPUClass(options):
     return (TmpClass, test_mem_mode, CPUClass)
 
 
+def addCacheWarmers(system):
+    """Warm the caches of every CPU from its accesses while fast
+    forwarding. The paths go from the first level caches to the L2."""
+    for cpu in system.cpu:
+        if not hasattr(cpu, "icache") or not hasattr(cpu, "dcache"):
+            warn(f"{cpu} has no caches to warm")
+            continue
+        lower = [
+            cache
+            for cache in (
+                getattr(cpu, "l2cache", None),
+                getattr(system, "l2", None),
+            )
+            if cache is not None
+        ]
+        cpu.cache_warmer = CacheWarmer(
+            manager=cpu,
+            icaches=[cpu.icache] + lower,
+            dcaches=[cpu.dcache] + lower,
+        )
+
+
+def addQueueSampler(system, interval):
+    """Sample the queues of all the caches and memory controllers."""
+    objects = list(system.descendants())
+    system.queue_sampler = QueueSampler(
+        caches=[obj for obj in objects if isinstance(obj, BaseCache)],
+        mem_ctrls=[obj for obj in objects if isinstance(obj, MemCtrl)],
+        interval=interval,
+        output="queue_occupancy.bin.gz",
+    )
+
+
 def setMemClass(options):
     """Returns a memory controller class."""
 
@@ -551,6 +590,9 @@ def run(options, root, testsys, cpu_class):
         if options.elastic_trace_en:
             CpuConfig.config_etrace(cpu_class, switch_cpus, options)
 
+        if options.fast_forward and options.functional_warming:
+            addCacheWarmers(testsys)
+
         testsys.switch_cpus = switch_cpus
         switch_cpu_list = [(testsys.cpu[i], switch_cpus[i]) for i in range(np)]
 
@@ -678,6 +720,9 @@ def run(options, root, testsys, cpu_class):
             options, testsys
         )
 
+    if options.sample_queues:
+        addQueueSampler(testsys, options.sample_queues)
+
     checkpoint_dir = None
     if options.checkpoint_restore:
         cpt_starttick, checkpoint_dir = findCptDir(options, cptdir, testsys)
@@ -401,6 +401,8 @@ elif len(bm) == 1 and args.dist:
         args.ethernet_linkspeed,
         args.ethernet_linkdelay,
         args.etherdump,
+        args.dist_transport,
+        args.dist_adaptive_sync,
     )
 elif len(bm) == 1:
     root = Root(full_system=True, system=test_sys)
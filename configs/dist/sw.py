@@ -58,6 +58,8 @@ def build_switch(args):
             sync_repeat=args.dist_sync_repeat,
             is_switch=True,
             num_nodes=args.dist_size,
+            transport=args.dist_transport,
+            adaptive_sync=args.dist_adaptive_sync,
         )
         for i in range(args.dist_size)
     ]
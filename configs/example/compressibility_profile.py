@@ -0,0 +1,99 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+# Profiles how well the memory of a checkpoint compresses with a set of
+# cache compressors, without simulating it:
+#   compressibility_profile.py --checkpoint-dir m5out/cpt.1 \
+#       --compressor CPack --compressor BDI --threads 8
+#
+# Every .pmem store of the checkpoint is streamed through all the
+# compressors, which run in parallel. The summary is written to
+# compressibility.txt and the distribution of the compressed line sizes
+# to compressibility.csv in the output directory.
+#
+# Any compressor can be profiled except FrequentValuesCompressor, which
+# learns its values from the probes of the cache it is attached to.
+
+import argparse
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+group = parser.add_mutually_exclusive_group(required=True)
+group.add_argument("--checkpoint-dir", help="Checkpoint to profile")
+group.add_argument(
+    "--store",
+    action="append",
+    help="Store file to profile, instead of a whole checkpoint",
+)
+parser.add_argument(
+    "--compressor",
+    action="append",
+    default=[],
+    help="Compressor class to profile, e.g. CPack, FPC or BDI. "
+    "FrequentValuesCompressor needs a cache and is not supported",
+)
+parser.add_argument("--cacheline-size", type=int, default=64)
+parser.add_argument(
+    "--threads",
+    type=int,
+    default=0,
+    help="Host threads compressing in parallel, 0 for all host cores",
+)
+parser.add_argument(
+    "--max-lines", type=int, default=0, help="Lines to profile, 0 for all"
+)
+
+args = parser.parse_args()
+
+names = args.compressor or [
+    "ZeroCompressor",
+    "RepeatedQwordsCompressor",
+    "Base64Delta8",
+    "CPack",
+    "FPC",
+    "FPCD",
+    "BDI",
+]
+
+system = System(cache_line_size=args.cacheline_size)
+system.profiler = CompressibilityProfiler(
+    compressors=[getattr(m5.objects, name)() for name in names],
+    checkpoint_dir=args.checkpoint_dir or "",
+    store_files=args.store or [],
+    threads=args.threads,
+    max_lines=args.max_lines,
+)
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+exit_event = m5.simulate()
+print("Exiting @ tick", m5.curTick(), "because", exit_event.getCause())
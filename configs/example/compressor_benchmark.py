@@ -0,0 +1,110 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+# Measures the host speed of cache compressors on a memory image, for
+# example the physical memory store of a checkpoint:
+#   compressor_benchmark.py --dump m5out/cpt.1/system.physmem.store0.pmem \
+#       --compressor CPack --compressor BDI --verify
+#
+# With --verify, every compressor is also run with the fast pattern
+# search of the dictionary compressors disabled, and the compressed size
+# of every line must be the same. The report is written to
+# compressor_benchmark.txt in the output directory.
+
+import argparse
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+parser.add_argument("--dump", required=True, help="Memory image to compress")
+parser.add_argument(
+    "--compressor",
+    action="append",
+    default=[],
+    help="Compressor class to measure, e.g. CPack, FPC or BDI",
+)
+parser.add_argument("--cacheline-size", type=int, default=64)
+parser.add_argument(
+    "--max-lines", type=int, default=0, help="Lines to load, 0 for all"
+)
+parser.add_argument(
+    "--skip-zero-lines",
+    action="store_true",
+    help="Do not measure lines that only contain zeros",
+)
+parser.add_argument(
+    "--repeats", type=int, default=1, help="Times every line is compressed"
+)
+parser.add_argument(
+    "--verify",
+    action="store_true",
+    help="Check the results against the reference pattern search",
+)
+
+args = parser.parse_args()
+
+
+def make_compressor(name, fast):
+    compressor = getattr(m5.objects, name)()
+    children = getattr(compressor, "compressors", [compressor])
+    for child in children:
+        if isinstance(child, BaseDictionaryCompressor):
+            child.fast_pattern_search = fast
+    return compressor
+
+
+names = args.compressor or [
+    "ZeroCompressor",
+    "RepeatedQwordsCompressor",
+    "Base64Delta8",
+    "CPack",
+    "FPC",
+    "FPCD",
+    "BDI",
+]
+
+system = System(cache_line_size=args.cacheline_size)
+system.benchmark = CompressorBenchmark(
+    compressors=[make_compressor(name, True) for name in names],
+    dump_file=args.dump,
+    max_lines=args.max_lines,
+    skip_zero_lines=args.skip_zero_lines,
+    repeats=args.repeats,
+)
+if args.verify:
+    system.benchmark.references = [
+        make_compressor(name, False) for name in names
+    ]
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+exit_event = m5.simulate()
+print("Exiting @ tick", m5.curTick(), "because", exit_event.getCause())
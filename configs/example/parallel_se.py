@@ -0,0 +1,144 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Run a multi-threaded SE workload with each CPU on its own event queue.
+
+Every CPU is a NonCachingSimpleCPU simulated by its own host thread. The
+memory system stays on event queue 0, and the CPU ports are connected to
+it through ThreadBridges, which move accesses to that queue. Instruction
+fetches and plain reads are done through memory backdoors without
+crossing threads at all. Threads created by the workload with clone() are
+woken up on the first free CPU, as in any other SE simulation.
+
+The CPUs only synchronize every --quantum ticks, so the relative timing
+of the threads is less precise than in a single threaded simulation, and
+the results are not deterministic from run to run.
+
+The stores of a CPU are not snooped by the CPUs on other queues, so they
+don't clear their load-linked reservations, and a store-conditional may
+succeed although another thread wrote the line in between. Workloads
+synchronizing with LL/SC rather than with locked read-modify-writes or
+atomic memory operations are not safe in this mode, and gem5 warns when
+it sees one.
+
+Example:
+
+build/X86/gem5.opt configs/example/parallel_se.py --num-cpus 4 \\
+    --cmd tests/test-progs/threads/bin/x86/linux/threads --options 1000
+"""
+
+import argparse
+import shlex
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument("--cmd", required=True, help="Binary to run")
+parser.add_argument(
+    "--options", default="", help="Arguments passed to the binary"
+)
+parser.add_argument(
+    "--num-cpus", type=int, default=2, help="Number of CPUs [Default: 2]"
+)
+parser.add_argument(
+    "--cpu-type",
+    default="X86NonCachingSimpleCPU",
+    help="NonCachingSimpleCPU class to use [Default: X86NonCachingSimpleCPU]",
+)
+parser.add_argument(
+    "--cpu-clock", default="2GHz", help="CPU clock [Default: 2GHz]"
+)
+parser.add_argument(
+    "--mem-size", default="2GiB", help="Memory size [Default: 2GiB]"
+)
+parser.add_argument(
+    "--quantum",
+    default="1us",
+    help="Simulated time between synchronizations of the CPUs "
+    "[Default: 1us]",
+)
+args = parser.parse_args()
+
+system = System()
+system.clk_domain = SrcClockDomain(
+    clock=args.cpu_clock, voltage_domain=VoltageDomain()
+)
+system.mem_mode = "atomic_noncaching"
+system.mem_ranges = [AddrRange(args.mem_size)]
+
+system.membus = SystemXBar()
+system.system_port = system.membus.cpu_side_ports
+system.mem_ctrl = SimpleMemory(range=system.mem_ranges[0])
+system.mem_ctrl.port = system.membus.mem_side_ports
+
+process = Process(cmd=[args.cmd] + shlex.split(args.options))
+system.workload = SEWorkload.init_compatible(args.cmd)
+
+cpu_class = getattr(m5.objects, args.cpu_type)
+system.cpu = [cpu_class(cpu_id=i) for i in range(args.num_cpus)]
+
+
+def bridge(eventq_index, requestor, responder):
+    """Connect two ports through a ThreadBridge on the responder's queue"""
+    br = ThreadBridge(eventq_index=eventq_index)
+    br.in_port = requestor
+    br.out_port = responder
+    return br
+
+
+for i, cpu in enumerate(system.cpu):
+    # Event queue 0 is left to the memory system.
+    cpu.eventq_index = i + 1
+    cpu.workload = process
+    cpu.createThreads()
+    cpu.createInterruptController()
+
+    bridges = [
+        bridge(0, cpu.icache_port, system.membus.cpu_side_ports),
+        bridge(0, cpu.dcache_port, system.membus.cpu_side_ports),
+    ]
+    if hasattr(cpu.interrupts[0], "int_requestor"):
+        intr = cpu.interrupts[0]
+        bridges += [
+            bridge(0, intr.int_requestor, system.membus.cpu_side_ports),
+            bridge(cpu.eventq_index, system.membus.mem_side_ports, intr.pio),
+            bridge(
+                cpu.eventq_index,
+                system.membus.mem_side_ports,
+                intr.int_responder,
+            ),
+        ]
+    cpu.bridges = bridges
+
+root = Root(full_system=False, system=system)
+root.sim_quantum = m5.ticks.fromSeconds(
+    m5.util.convert.anyToLatency(args.quantum)
+)
+
+m5.instantiate()
+exit_event = m5.simulate()
+print(f"Exiting @ tick {m5.curTick()} because {exit_event.getCause()}")
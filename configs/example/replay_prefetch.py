@@ -0,0 +1,187 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+# Replays a packet trace written by MemBinTraceProbe through a single
+# cache, optionally with a hardware prefetcher, backed by a memory that
+# does not store data. Record the trace below the cache level whose
+# prefetcher is evaluated, for example on the L1D to L2 bus, and replay it
+# here with the size and associativity of that level. The prefetcher
+# stats of system.cache then give its accuracy and coverage on the
+# recorded miss stream without simulating a CPU.
+#
+# Prefetcher parameters are passed as NAME=VALUE pairs, for example:
+#   replay_prefetch.py --trace l2.ptrc --prefetcher StridePrefetcher \
+#       --param degree=4 --param table_entries=256
+#
+# util/prefetch_sweep.py runs this script for many configurations.
+
+import argparse
+import ast
+
+import m5
+from m5.objects import *
+from m5.util import (
+    addToPath,
+    fatal,
+)
+
+addToPath("../")
+
+from common import ObjectList
+
+
+def parse_param(option):
+    name, sep, value = option.partition("=")
+    if not sep:
+        raise argparse.ArgumentTypeError(f"'{option}' is not NAME=VALUE")
+    # Let the parameter types convert anything that is not a literal,
+    # such as sizes or latencies with a unit.
+    try:
+        value = ast.literal_eval(value)
+    except (ValueError, SyntaxError):
+        pass
+    return name, value
+
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+parser.add_argument("--trace", required=True, help="Packet trace to replay")
+parser.add_argument(
+    "--prefetcher",
+    choices=ObjectList.hwp_list.get_names(),
+    help="Prefetcher to evaluate, none if not given",
+)
+parser.add_argument(
+    "--param",
+    type=parse_param,
+    action="append",
+    default=[],
+    metavar="NAME=VALUE",
+    help="Set a parameter of the prefetcher",
+)
+parser.add_argument(
+    "--requestor",
+    action="append",
+    default=[],
+    help="Only replay requestors whose name contains this string",
+)
+parser.add_argument(
+    "--no-timing",
+    action="store_true",
+    help="Send a request each cycle instead of at the recorded ticks",
+)
+parser.add_argument(
+    "--max-packets", type=int, default=0, help="Stop after N requests"
+)
+parser.add_argument(
+    "--max-outstanding",
+    type=int,
+    default=16,
+    help="Maximum requests awaiting a response",
+)
+parser.add_argument("--clock", default="2GHz", help="Clock of the cache")
+parser.add_argument("--cacheline-size", type=int, default=64)
+parser.add_argument("--size", default="1MiB", help="Size of the cache")
+parser.add_argument("--assoc", type=int, default=16)
+parser.add_argument("--tag-latency", type=int, default=12)
+parser.add_argument("--data-latency", type=int, default=12)
+parser.add_argument("--response-latency", type=int, default=12)
+parser.add_argument("--mshrs", type=int, default=32)
+parser.add_argument("--tgts-per-mshr", type=int, default=12)
+parser.add_argument("--write-buffers", type=int, default=16)
+parser.add_argument(
+    "--mem-size",
+    default="256GiB",
+    help="Address range of the memory, it has to cover the trace",
+)
+parser.add_argument("--mem-latency", default="50ns")
+parser.add_argument("--mem-bandwidth", default="25.6GiB/s")
+parser.add_argument(
+    "-m",
+    "--maxtick",
+    type=int,
+    default=m5.MaxTick,
+    metavar="T",
+    help="Stop after T ticks",
+)
+
+args = parser.parse_args()
+
+system = System(
+    mem_mode="timing",
+    mem_ranges=[AddrRange(args.mem_size)],
+    cache_line_size=args.cacheline_size,
+)
+system.voltage_domain = VoltageDomain()
+system.clk_domain = SrcClockDomain(
+    clock=args.clock, voltage_domain=system.voltage_domain
+)
+
+system.replayer = BinTraceReplayer(
+    trace_file=args.trace,
+    replay_timing=not args.no_timing,
+    max_outstanding=args.max_outstanding,
+    max_packets=args.max_packets,
+    requestors=args.requestor,
+)
+
+system.cache = Cache(
+    size=args.size,
+    assoc=args.assoc,
+    tag_latency=args.tag_latency,
+    data_latency=args.data_latency,
+    response_latency=args.response_latency,
+    mshrs=args.mshrs,
+    tgts_per_mshr=args.tgts_per_mshr,
+    write_buffers=args.write_buffers,
+)
+if args.prefetcher:
+    prefetcher_class = ObjectList.hwp_list.get(args.prefetcher)
+    system.cache.prefetcher = prefetcher_class(**dict(args.param))
+elif args.param:
+    fatal("--param needs a --prefetcher")
+
+system.membus = SystemXBar()
+system.replayer.port = system.cache.cpu_side
+system.cache.mem_side = system.membus.cpu_side_ports
+system.system_port = system.membus.cpu_side_ports
+
+# The replayed data is meaningless, so do not back the memory.
+system.mem_ctrl = SimpleMemory(
+    range=system.mem_ranges[0],
+    latency=args.mem_latency,
+    bandwidth=args.mem_bandwidth,
+    null=True,
+)
+system.mem_ctrl.port = system.membus.mem_side_ports
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+exit_event = m5.simulate(args.maxtick)
+print("Exiting @ tick", m5.curTick(), "because", exit_event.getCause())
@@ -79,6 +79,14 @@ def define_options(parser):
         default=False,
         help="Should ruby maintain a second copy of memory",
     )
+    parser.add_argument(
+        "--ruby-fast-warmup",
+        action="store_true",
+        default=False,
+        help="Restore the cache contents of a checkpoint by installing "
+        "them directly rather than replaying them, if the protocol "
+        "supports it",
+    )
 
     # Options related to cache structure
     parser.add_argument(
@@ -295,6 +303,8 @@ def create_system(
     ruby._cpu_ports = cpu_sequencers
     ruby.num_of_sequencers = len(cpu_sequencers)
 
+    ruby.fast_warmup = options.ruby_fast_warmup
+
     # Create a backing copy of physical memory in case required
     if options.access_backing_store:
         ruby.access_backing_store = True
@@ -229,6 +229,13 @@ class ThreadContext : public gem5::ThreadContext
 
     void sendFunctional(PacketPtr pkt) override;
 
+    void
+    sendMemBackdoorReq(const MemBackdoorReq &req,
+                       MemBackdoorPtr &backdoor) override
+    {
+        // Memory is accessed through Iris, which has no backdoors.
+    }
+
     Process *
     getProcessPtr() override
     {
@@ -196,6 +196,8 @@ MMU::translateFunctional(ThreadContext *tc, Addr va, Addr &pa)
 void
 MMU::invalidateMiscReg()
 {
+    // The translation regime may have changed.
+    invalidateCachedTranslations();
     s1State.miscRegValid = false;
     s1State.computeAddrTop.flush();
     s2State.computeAddrTop.flush();
@@ -1050,7 +1052,9 @@ MMU::translateAtomic(const RequestPtr &req, ThreadContext *tc, Mode mode,
 Fault
 MMU::translateFunctional(const RequestPtr &req, ThreadContext *tc, Mode mode)
 {
-    return translateFunctional(req, tc, mode, NormalTran, false);
+    return cachedFunctional(req, tc, mode, [&]() {
+        return translateFunctional(req, tc, mode, NormalTran, false);
+    });
 }
 
 Fault
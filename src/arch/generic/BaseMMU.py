@@ -49,6 +49,17 @@ class BaseMMU(SimObject):
     itb = Param.BaseTLB("Instruction TLB")
     dtb = Param.BaseTLB("Data TLB")
 
+    functional_cache_entries = Param.Unsigned(
+        64,
+        "Entries in the cache of functional translations "
+        "(a power of 2, 0 to disable)",
+    )
+    translation_cache_entries = Param.Unsigned(
+        64,
+        "Entries in the cache of atomic and timing translations hitting in "
+        "the TLBs (a power of 2, 0 to disable)",
+    )
+
     @classmethod
     def walkerPorts(cls):
         # This classmethod is used by the BaseCPU. It should return
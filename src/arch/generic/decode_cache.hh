@@ -64,14 +64,10 @@ class BasicDecodeCache
 
         entry.machInst = mach_inst;
 
-        auto iter = instMap.find(mach_inst);
-        if (iter != instMap.end()) {
-            entry.inst = iter->second;
-            return entry.inst;
-        }
-
-        entry.inst = decoder->decodeInst(mach_inst);
-        instMap[mach_inst] = entry.inst;
+        StaticInstPtr &si = instMap.lookup(mach_inst);
+        if (!si)
+            si = decoder->decodeInst(mach_inst);
+        entry.inst = si;
         return entry.inst;
     }
 };
@@ -42,13 +42,29 @@
  */
 
 #include "arch/generic/mmu.hh"
+#include "arch/generic/isa.hh"
 #include "arch/generic/tlb.hh"
+#include "base/intmath.hh"
 #include "cpu/thread_context.hh"
+#include "sim/full_system.hh"
 #include "sim/system.hh"
 
 namespace gem5
 {
 
+BaseMMU::BaseMMU(const Params &p)
+  : SimObject(p), dtb(p.dtb), itb(p.itb),
+    functionalCache(p.functional_cache_entries),
+    translationCache(p.translation_cache_entries)
+{
+    fatal_if(!functionalCache.empty() &&
+             !isPowerOf2(functionalCache.size()),
+             "%s: functional_cache_entries must be a power of 2.", name());
+    fatal_if(!translationCache.empty() &&
+             !isPowerOf2(translationCache.size()),
+             "%s: translation_cache_entries must be a power of 2.", name());
+}
+
 void
 BaseMMU::init()
 {
@@ -75,6 +91,11 @@ BaseMMU::init()
 
     traverse_hierarchy(itb);
     traverse_hierarchy(dtb);
+
+    // Looking the cache up would only be overhead if the TLBs never
+    // report the hits it could serve.
+    if (!itb->reportsFastHits() || !dtb->reportsFastHits())
+        translationCache.clear();
 }
 
 void
@@ -91,34 +112,196 @@ BaseMMU::flushAll()
     for (auto tlb : unified) {
         tlb->flushAll();
     }
+
+    invalidateCachedTranslations();
 }
 
 void
 BaseMMU::demapPage(Addr vaddr, uint64_t asn)
 {
+    invalidateCachedTranslations();
     itb->demapPage(vaddr, asn);
     dtb->demapPage(vaddr, asn);
 }
 
+class BaseMMU::CachingTranslation : public BaseMMU::Translation
+{
+  private:
+    BaseMMU &mmu;
+    BaseTLB *tlb;
+    Translation *translation;
+    const CachedTranslation key;
+    const Request::FlagsType origFlags;
+    bool delayed = false;
+
+  public:
+    CachingTranslation(BaseMMU &_mmu, BaseTLB *_tlb,
+                       Translation *_translation,
+                       const CachedTranslation &_key,
+                       Request::FlagsType orig_flags)
+      : mmu(_mmu), tlb(_tlb), translation(_translation), key(_key),
+        origFlags(orig_flags)
+    {}
+
+    void
+    markDelayed() override
+    {
+        delayed = true;
+        translation->markDelayed();
+    }
+
+    void
+    finish(const Fault &fault, const RequestPtr &req, ThreadContext *tc,
+           Mode mode) override
+    {
+        // A delayed translation missed, and another one may have hit
+        // since, so only look at the TLB report if this one was not.
+        if (!delayed && fault == NoFault)
+            mmu.cacheHit(req, key, origFlags, tlb);
+
+        Translation *const wrapped = translation;
+        delete this;
+        wrapped->finish(fault, req, tc, mode);
+    }
+
+    bool squashed() const override { return translation->squashed(); }
+};
+
 Fault
 BaseMMU::translateAtomic(const RequestPtr &req, ThreadContext *tc,
                          BaseMMU::Mode mode)
 {
-    return getTlb(mode)->translateAtomic(req, tc, mode);
+    BaseTLB *tlb = getTlb(mode);
+    if (translationCache.empty())
+        return tlb->translateAtomic(req, tc, mode);
+
+    const CachedTranslation key = translationKey(req, tc, mode);
+    if (lookupTranslation(req, key, tlb))
+        return NoFault;
+
+    const Request::FlagsType orig_flags = req->getFlags();
+    tlb->clearFastHit();
+    Fault fault = tlb->translateAtomic(req, tc, mode);
+    if (fault == NoFault)
+        cacheHit(req, key, orig_flags, tlb);
+    return fault;
 }
 
 void
 BaseMMU::translateTiming(const RequestPtr &req, ThreadContext *tc,
                          BaseMMU::Translation *translation, BaseMMU::Mode mode)
 {
-    return getTlb(mode)->translateTiming(req, tc, translation, mode);
+    BaseTLB *tlb = getTlb(mode);
+    if (translationCache.empty())
+        return tlb->translateTiming(req, tc, translation, mode);
+
+    const CachedTranslation key = translationKey(req, tc, mode);
+    if (lookupTranslation(req, key, tlb)) {
+        translation->finish(NoFault, req, tc, mode);
+        return;
+    }
+
+    tlb->clearFastHit();
+    tlb->translateTiming(req, tc,
+            new CachingTranslation(*this, tlb, translation, key,
+                                   req->getFlags()),
+            mode);
 }
 
 Fault
 BaseMMU::translateFunctional(const RequestPtr &req, ThreadContext *tc,
                              BaseMMU::Mode mode)
 {
-    return getTlb(mode)->translateFunctional(req, tc, mode);
+    return cachedFunctional(req, tc, mode, [&]() {
+        return getTlb(mode)->translateFunctional(req, tc, mode);
+    });
+}
+
+void
+BaseMMU::translationContext(ThreadContext *tc, Mode mode,
+                            uint64_t &space, uint64_t &priv)
+{
+    space = tc->getIsaPtr()->getExecutingAsid();
+    priv = tc->getIsaPtr()->inUserMode();
+}
+
+BaseMMU::CachedTranslation
+BaseMMU::translationKey(const RequestPtr &req, ThreadContext *tc, Mode mode)
+{
+    CachedTranslation key;
+    key.vpage = req->getVaddr() >> CachedTranslation::PageShift;
+    key.flags = req->getFlags();
+    translationContext(tc, mode, key.space, key.priv);
+    key.process = FullSystem ? nullptr : tc->getProcessPtr();
+    key.cid = tc->contextId();
+    key.mode = mode;
+    return key;
+}
+
+void
+BaseMMU::applyCached(const RequestPtr &req, const CachedTranslation &entry)
+{
+    req->setPaddr(entry.ppage << CachedTranslation::PageShift |
+                  (req->getVaddr() & CachedTranslation::PageMask));
+    if (entry.addedFlags)
+        req->setFlags(entry.addedFlags);
+}
+
+void
+BaseMMU::cacheTranslation(std::vector<CachedTranslation> &cache,
+                          const RequestPtr &req, CachedTranslation key,
+                          Request::FlagsType orig_flags)
+{
+    // Only cache plain translations which apply to a whole page. Requests
+    // handled by a local accessor, or which lost flags, are too special.
+    const Addr vaddr = req->getVaddr();
+    const Addr paddr = req->getPaddr();
+    const Request::FlagsType flags = req->getFlags();
+    if (req->isLocalAccess() ||
+            ((vaddr ^ paddr) & CachedTranslation::PageMask) ||
+            (flags & orig_flags) != orig_flags) {
+        return;
+    }
+
+    key.ppage = paddr >> CachedTranslation::PageShift;
+    key.addedFlags = flags & ~orig_flags;
+    cache[key.vpage & (cache.size() - 1)] = key;
+}
+
+bool
+BaseMMU::lookupTranslation(const RequestPtr &req,
+                           const CachedTranslation &key, BaseTLB *tlb)
+{
+    const CachedTranslation *entry = lookupCached(translationCache, key);
+    if (!entry || entry->generation != tlb->getFastGeneration())
+        return false;
+
+    tlb->touchFastHit(entry->tlbEntry, req, key.mode);
+    applyCached(req, *entry);
+    return true;
+}
+
+void
+BaseMMU::cacheHit(const RequestPtr &req, const CachedTranslation &key,
+                  Request::FlagsType orig_flags, BaseTLB *tlb)
+{
+    void *const entry = tlb->getFastHit();
+    if (!entry)
+        return;
+
+    CachedTranslation hit = key;
+    hit.tlbEntry = entry;
+    hit.generation = tlb->getFastGeneration();
+    cacheTranslation(translationCache, req, hit, orig_flags);
+}
+
+void
+BaseMMU::invalidateCachedTranslations()
+{
+    for (auto &entry : functionalCache)
+        entry = CachedTranslation();
+    for (auto &entry : translationCache)
+        entry = CachedTranslation();
 }
 
 Fault
@@ -169,6 +352,9 @@ BaseMMU::takeOverFrom(BaseMMU *old_mmu)
 
     itb->takeOverFrom(old_mmu->itb);
     dtb->takeOverFrom(old_mmu->dtb);
+
+    invalidateCachedTranslations();
+    old_mmu->invalidateCachedTranslations();
 }
 
 } // namespace gem5
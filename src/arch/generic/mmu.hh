@@ -39,6 +39,7 @@
 #define __ARCH_GENERIC_MMU_HH__
 
 #include <set>
+#include <vector>
 
 #include "mem/request.hh"
 #include "mem/translation_gen.hh"
@@ -87,9 +88,7 @@ class BaseMMU : public SimObject
   protected:
     typedef BaseMMUParams Params;
 
-    BaseMMU(const Params &p)
-      : SimObject(p), dtb(p.dtb), itb(p.itb)
-    {}
+    BaseMMU(const Params &p);
 
     BaseTLB*
     getTlb(Mode mode) const
@@ -158,6 +157,150 @@ class BaseMMU : public SimObject
     BaseTLB* dtb;
     BaseTLB* itb;
 
+  protected:
+    /**
+     * Small direct mapped caches of successful translations, checked
+     * before the TLBs. Atomic and timing CPUs translate every fetch and
+     * data access, and port proxies translate functionally e.g. every
+     * buffer a syscall copies in SE mode, which otherwise looks up, and
+     * on a miss walks, the page tables every time.
+     *
+     * Translations are cached with a 4KiB granularity, the smallest page
+     * size of all ISAs, and keyed by everything the translation depends
+     * on: the request flags, the mode, the process in SE mode and an ISA
+     * defined context (see translationContext()). Both caches are
+     * invalidated whenever the TLBs are flushed or demapped.
+     *
+     * Functional translations don't update the TLB statistics, so any of
+     * them can be cached. Atomic and timing translations are only cached
+     * if the TLB reported them as plain hits (see BaseTLB::fastHit). A
+     * cached translation is only used while the TLB holds the same
+     * entries, and the TLB then updates its statistics and replacement
+     * state as the lookup would have, so what the TLB models is the same
+     * with or without the cache.
+     */
+    struct CachedTranslation
+    {
+        static constexpr Addr PageShift = 12;
+        static constexpr Addr PageMask = (1ULL << PageShift) - 1;
+
+        // Page numbers have their low bits clear once shifted back, so an
+        // invalid entry never matches.
+        Addr vpage = PageMask;
+        Addr ppage = 0;
+        Request::FlagsType flags = 0;
+        uint64_t space = 0;
+        uint64_t priv = 0;
+        const void *process = nullptr;
+        ContextID cid = InvalidContextID;
+        Mode mode = Read;
+
+        /** Flags set on the request by the translation. */
+        Request::FlagsType addedFlags = 0;
+
+        /** TLB entry hit by the translation, and the TLB generation. */
+        void *tlbEntry = nullptr;
+        uint64_t generation = 0;
+
+        bool
+        matches(const CachedTranslation &key) const
+        {
+            return vpage == key.vpage && flags == key.flags &&
+                space == key.space && priv == key.priv &&
+                process == key.process && cid == key.cid &&
+                mode == key.mode;
+        }
+    };
+    std::vector<CachedTranslation> functionalCache;
+    std::vector<CachedTranslation> translationCache;
+
+    /** Wraps a timing translation to cache it if it is a plain hit. */
+    class CachingTranslation;
+
+    /**
+     * The ISA state a translation depends on besides the page tables: an
+     * address space (e.g. an ASID or a page table base) and a privilege
+     * level. The state must be exact, as it is compared rather than
+     * hashed. ISAs which invalidate the caches themselves on every
+     * relevant state change can leave the default, the executing ASID and
+     * whether the CPU is in user mode.
+     */
+    virtual void translationContext(ThreadContext *tc, Mode mode,
+                                    uint64_t &space, uint64_t &priv);
+
+    CachedTranslation translationKey(const RequestPtr &req,
+                                     ThreadContext *tc, Mode mode);
+
+    /**
+     * Find the cached translation of a request.
+     * @return The matching entry, or nullptr.
+     */
+    CachedTranslation *
+    lookupCached(std::vector<CachedTranslation> &cache,
+                 const CachedTranslation &key)
+    {
+        CachedTranslation &entry =
+            cache[key.vpage & (cache.size() - 1)];
+        return entry.matches(key) ? &entry : nullptr;
+    }
+
+    /** Translate a request from a cached translation. */
+    void applyCached(const RequestPtr &req, const CachedTranslation &entry);
+
+    /**
+     * Remember a successful translation.
+     * @param orig_flags The request flags before translation.
+     */
+    void cacheTranslation(std::vector<CachedTranslation> &cache,
+                          const RequestPtr &req, CachedTranslation key,
+                          Request::FlagsType orig_flags);
+
+    /**
+     * Translate a request from the atomic and timing cache, as a hit in
+     * the TLB.
+     * @return Whether the translation was found.
+     */
+    bool lookupTranslation(const RequestPtr &req,
+                           const CachedTranslation &key, BaseTLB *tlb);
+
+    /** Cache a translation the TLB reported as a plain hit, if it did. */
+    void cacheHit(const RequestPtr &req, const CachedTranslation &key,
+                  Request::FlagsType orig_flags, BaseTLB *tlb);
+
+    /**
+     * Translate a request functionally through the cache.
+     * @param translate Callable doing the translation on a miss.
+     */
+    template <typename F>
+    Fault
+    cachedFunctional(const RequestPtr &req, ThreadContext *tc, Mode mode,
+                     F &&translate)
+    {
+        if (functionalCache.empty())
+            return translate();
+
+        const CachedTranslation key = translationKey(req, tc, mode);
+        if (const CachedTranslation *entry =
+                lookupCached(functionalCache, key)) {
+            applyCached(req, *entry);
+            return NoFault;
+        }
+
+        const Request::FlagsType orig_flags = req->getFlags();
+        Fault fault = translate();
+        if (fault == NoFault)
+            cacheTranslation(functionalCache, req, key, orig_flags);
+        return fault;
+    }
+
+  public:
+    /**
+     * Forget all cached translations. This has to be called whenever
+     * translations may change without a TLB flush or demap, and the
+     * context the ISA keys them with does not change either.
+     */
+    void invalidateCachedTranslations();
+
   protected:
     /**
      * It is possible from the MMU to traverse the entire hierarchy of
@@ -66,7 +66,35 @@ class BaseTLB : public SimObject
 
     BaseTLB *_nextLevel;
 
+    /**
+     * Support for the translation cache of BaseMMU, which serves repeated
+     * atomic and timing translations without calling the TLB. A TLB
+     * taking part sets fastHit to the entry a translation used if it was
+     * a plain hit: one which only depended on the page, the request flags
+     * and the context the MMU keys its cache with, and which had no side
+     * effect other than on the statistics and the replacement state. It
+     * bumps fastGeneration whenever entries are inserted, changed or
+     * removed, so that a cached hit never outlives its entry.
+     */
+    void *fastHit = nullptr;
+    uint64_t fastGeneration = 0;
+
   public:
+    /** Whether the TLB reports plain hits through fastHit. */
+    virtual bool reportsFastHits() const { return false; }
+
+    /**
+     * Update the statistics and the replacement state as a lookup hitting
+     * a reported entry would, for a translation served by the MMU.
+     */
+    virtual void
+    touchFastHit(void *entry, const RequestPtr &req, BaseMMU::Mode mode)
+    {}
+
+    void clearFastHit() { fastHit = nullptr; }
+    void *getFastHit() const { return fastHit; }
+    uint64_t getFastGeneration() const { return fastGeneration; }
+
     virtual void demapPage(Addr vaddr, uint64_t asn) = 0;
 
     virtual Fault translateAtomic(
@@ -670,6 +670,8 @@ ISA::setMiscReg(RegIndex idx, RegVal val)
                 }
 
                 setMiscRegNoEffect(idx, res);
+                // Translations are only cached if PMP checks are off
+                tc->getMMUPtr()->invalidateCachedTranslations();
             }
             break;
           case MISCREG_PMPADDR00 ... MISCREG_PMPADDR15:
@@ -682,6 +684,7 @@ ISA::setMiscReg(RegIndex idx, RegVal val)
                 uint32_t pmp_index = idx-MISCREG_PMPADDR00;
                 if (mmu->getPMP()->pmpUpdateAddr(pmp_index, val)) {
                     setMiscRegNoEffect(idx, val);
+                    mmu->invalidateCachedTranslations();
                 }
             }
             break;
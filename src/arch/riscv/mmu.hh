@@ -74,6 +74,22 @@ class MMU : public BaseMMU
         return static_cast<TLB*>(dtb)->getMemPriv(tc, mode);
     }
 
+  protected:
+    void
+    translationContext(ThreadContext *tc, Mode mode,
+                       uint64_t &space, uint64_t &priv) override
+    {
+        // SATP changes don't flush the TLBs until an SFENCE.VMA, and the
+        // effective privilege depends on MSTATUS.MPRV, so use them as the
+        // context rather than relying on flushes.
+        STATUS status = tc->readMiscRegNoEffect(MISCREG_STATUS);
+        MISA misa = tc->readMiscRegNoEffect(MISCREG_ISA);
+        space = tc->readMiscRegNoEffect(MISCREG_SATP);
+        priv = getMemPriv(tc, mode) | status.sum << 2 | status.mxr << 3 |
+            misa.rvs << 4;
+    }
+
+  public:
     Walker *
     getDataWalker()
     {
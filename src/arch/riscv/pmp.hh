@@ -154,7 +154,6 @@ class PMP : public SimObject
      */
     void pmpReset();
 
-  private:
     /**
      * This function is called during a memory
      * access to determine if the pmp table
@@ -165,6 +164,7 @@ class PMP : public SimObject
      */
     bool shouldCheckPMP(RiscvISA::PrivilegeMode pmode, ThreadContext *tc);
 
+  private:
     /**
      * createAddrfault creates an address fault
      * if the pmp checks fail to pass for a given
@@ -145,6 +145,8 @@ TLB::insert(Addr vpn, const TlbEntry &entry)
     DPRINTF(TLB, "insert(vpn=%#x, asid=%#x): ppn=%#x pte=%#x size=%#x\n",
         vpn, entry.asid, entry.paddr, entry.pte, entry.size());
 
+    fastGeneration++;
+
     // If somebody beat us to it, just use that existing entry.
     TlbEntry *newEntry = lookup(vpn, entry.asid, BaseMMU::Read, true);
     if (newEntry) {
@@ -217,6 +219,7 @@ TLB::remove(size_t idx)
     trie.remove(tlb[idx].trieHandle);
     tlb[idx].trieHandle = NULL;
     freeList.push_back(&tlb[idx]);
+    fastGeneration++;
 }
 
 Fault
@@ -253,6 +256,36 @@ TLB::checkPermissions(STATUS status, PrivilegeMode pmode, Addr vaddr,
     return fault;
 }
 
+bool
+TLB::pageUncacheable(Addr paddr) const
+{
+    const AddrRange page(paddr & ~mask(PageShift),
+                         (paddr | mask(PageShift)) + 1);
+    for (const auto &range : pma->uncacheable) {
+        if (range.intersects(page))
+            return true;
+    }
+    return false;
+}
+
+void
+TLB::touchFastHit(void *entry, const RequestPtr &req, BaseMMU::Mode mode)
+{
+    // SE mode translations don't go through the TLB
+    if (!FullSystem)
+        return;
+
+    // As a lookup hitting entry
+    static_cast<TlbEntry *>(entry)->lruSeq = nextSeq();
+    if (mode == BaseMMU::Write) {
+        stats.writeAccesses++;
+        stats.writeHits++;
+    } else {
+        stats.readAccesses++;
+        stats.readHits++;
+    }
+}
+
 Fault
 TLB::createPagefault(Addr vaddr, BaseMMU::Mode mode)
 {
@@ -285,6 +318,7 @@ TLB::doTranslate(const RequestPtr &req, ThreadContext *tc,
     SATP satp = tc->readMiscReg(MISCREG_SATP);
 
     TlbEntry *e = lookup(vaddr, satp.asid, mode, false);
+    bool hit = e != nullptr;
     if (!e) {
         Fault fault = walker->start(tc, translation, req, mode);
         if (translation != nullptr || fault != NoFault) {
@@ -304,6 +338,7 @@ TLB::doTranslate(const RequestPtr &req, ThreadContext *tc,
         // again to update the dirty flag.
         if (mode == BaseMMU::Write && !e->pte.w) {
             DPRINTF(TLB, "Dirty bit not set, repeating PT walk\n");
+            hit = false;
             fault = walker->start(tc, translation, req, mode);
             if (translation != nullptr || fault != NoFault) {
                 delayed = true;
@@ -318,6 +353,8 @@ TLB::doTranslate(const RequestPtr &req, ThreadContext *tc,
     DPRINTF(TLBVerbose, "translate(vpn=%#x, asid=%#x): %#x\n",
             vaddr, satp.asid, paddr);
     req->setPaddr(paddr);
+    if (hit)
+        fastHit = e;
 
     return NoFault;
 }
@@ -382,6 +419,13 @@ TLB::translate(const RequestPtr &req, ThreadContext *tc,
             fault = pmp->pmpCheck(req, mode, pmode, tc);
         }
 
+        // The PMA and PMP checks depend on the size of the access, so
+        // only hits on pages where they have no effect can be reused.
+        if (fastHit && (pmp->shouldCheckPMP(pmode, tc) ||
+                        pageUncacheable(req->getPaddr()))) {
+            fastHit = nullptr;
+        }
+
         return fault;
     } else {
         // In the O3 CPU model, sometimes a memory access will be speculatively
@@ -401,6 +445,11 @@ TLB::translate(const RequestPtr &req, ThreadContext *tc,
         if (fault != NoFault)
             return fault;
 
+        // The page table translation can be reused, except on the last
+        // page where the wrap around check above matters.
+        if (req->getVaddr() < ~mask(PageShift))
+            fastHit = p->pTable;
+
         return NoFault;
     }
 }
@@ -454,7 +503,7 @@ TLB::translateFunctional(const RequestPtr &req, ThreadContext *tc,
     }
     else {
         Process *process = tc->getProcessPtr();
-        const auto *pte = process->pTable->lookup(vaddr);
+        auto pte = process->pTable->lookup(vaddr);
 
         if (!pte && mode != BaseMMU::Execute) {
             // Check if we just need to grow the stack.
@@ -514,6 +563,7 @@ TLB::unserialize(CheckpointIn &cp)
         freeList.pop_front();
 
         newEntry->unserializeSection(cp, csprintf("Entry%d", x));
+        fastGeneration++;
         Addr key = buildKey(newEntry->vaddr, newEntry->asid);
         newEntry->trieHandle = trie.insert(key,
             TlbEntryTrie::MaxBits - newEntry->logBytes, newEntry);
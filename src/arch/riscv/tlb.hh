@@ -101,12 +101,19 @@ class TLB : public BaseTLB
     void flushAll() override;
     void demapPage(Addr vaddr, uint64_t asn) override;
 
+    /** Whether the PMA makes part of the page of paddr uncacheable. */
+    bool pageUncacheable(Addr paddr) const;
+
     Fault checkPermissions(STATUS status, PrivilegeMode pmode, Addr vaddr,
                            BaseMMU::Mode mode, PTESv39 pte);
     Fault createPagefault(Addr vaddr, BaseMMU::Mode mode);
 
     PrivilegeMode getMemPriv(ThreadContext *tc, BaseMMU::Mode mode);
 
+    bool reportsFastHits() const override { return true; }
+    void touchFastHit(void *entry, const RequestPtr &req,
+                      BaseMMU::Mode mode) override;
+
     // Checkpointing
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
@@ -338,6 +338,11 @@ ISA::setMiscReg(RegIndex idx, RegVal val)
         break;
       case misc_reg::Cr8:
         break;
+      case misc_reg::ApicBase:
+        // Moving the local APIC remaps physical addresses after
+        // translation, which cached translations do not check.
+        tc->getMMUPtr()->invalidateCachedTranslations();
+        break;
       case misc_reg::Rflags:
         {
             RFLAGS rflags = val;
@@ -40,8 +40,10 @@
 
 #include "arch/generic/mmu.hh"
 #include "arch/x86/page_size.hh"
+#include "arch/x86/regs/misc.hh"
 #include "arch/x86/tlb.hh"
 
+#include "cpu/thread_context.hh"
 #include "params/X86MMU.hh"
 
 namespace gem5
@@ -59,10 +61,27 @@ class MMU : public BaseMMU
     void
     flushNonGlobal()
     {
+        invalidateCachedTranslations();
         static_cast<TLB*>(itb)->flushNonGlobal();
         static_cast<TLB*>(dtb)->flushNonGlobal();
     }
 
+  protected:
+    void
+    translationContext(ThreadContext *tc, Mode mode,
+                       uint64_t &space, uint64_t &priv) override
+    {
+        // Only paging and protection state which does not flush the TLBs
+        // when it changes: CR3 with its PCID, and the mode, CPL, CR0.WP
+        // and CR4.PCIDE translations are checked against.
+        HandyM5Reg m5reg = tc->readMiscRegNoEffect(misc_reg::M5Reg);
+        CR0 cr0 = tc->readMiscRegNoEffect(misc_reg::Cr0);
+        CR4 cr4 = tc->readMiscRegNoEffect(misc_reg::Cr4);
+        space = tc->readMiscRegNoEffect(misc_reg::Cr3);
+        priv = (uint64_t)m5reg << 2 | cr0.wp << 1 | cr4.pcide;
+    }
+
+  public:
     Walker*
     getDataWalker()
     {
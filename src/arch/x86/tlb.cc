@@ -94,6 +94,7 @@ TLB::evictLRU()
     trie.remove(tlb[lru].trieHandle);
     tlb[lru].trieHandle = NULL;
     freeList.push_back(&tlb[lru]);
+    fastGeneration++;
 }
 
 TlbEntry *
@@ -104,6 +105,7 @@ TLB::insert(Addr vpn, const TlbEntry &entry, uint64_t pcid)
     //tlb do not conflict when using the same
     //virtual addresses
     vpn = concAddrPcid(vpn, pcid);
+    fastGeneration++;
 
     // If somebody beat us to it, just use that existing entry.
     TlbEntry *newEntry = trie.lookup(vpn);
@@ -145,6 +147,7 @@ void
 TLB::flushAll()
 {
     DPRINTF(TLB, "Invalidating all entries.\n");
+    fastGeneration++;
     for (unsigned i = 0; i < size; i++) {
         if (tlb[i].trieHandle) {
             trie.remove(tlb[i].trieHandle);
@@ -164,6 +167,7 @@ void
 TLB::flushNonGlobal()
 {
     DPRINTF(TLB, "Invalidating all non global entries.\n");
+    fastGeneration++;
     for (unsigned i = 0; i < size; i++) {
         if (tlb[i].trieHandle && !tlb[i].global) {
             trie.remove(tlb[i].trieHandle);
@@ -181,6 +185,7 @@ TLB::demapPage(Addr va, uint64_t asn)
         trie.remove(entry->trieHandle);
         entry->trieHandle = NULL;
         freeList.push_back(entry);
+        fastGeneration++;
     }
 }
 
@@ -417,6 +422,7 @@ TLB::translate(const RequestPtr &req,
 
             pageAlignedVaddr = concAddrPcid(pageAlignedVaddr, pcid);
             TlbEntry *entry = lookup(pageAlignedVaddr);
+            const bool hit = entry != nullptr;
 
             if (mode == BaseMMU::Read) {
                 stats.rdAccesses++;
@@ -443,8 +449,7 @@ TLB::translate(const RequestPtr &req,
                     assert(entry);
                 } else {
                     Process *p = tc->getProcessPtr();
-                    const EmulationPageTable::Entry *pte =
-                        p->pTable->lookup(vaddr);
+                    auto pte = p->pTable->lookup(vaddr);
                     if (!pte) {
                         return std::make_shared<PageFault>(vaddr, true, mode,
                                                            true, false);
@@ -488,6 +493,9 @@ TLB::translate(const RequestPtr &req,
             req->setPaddr(paddr);
             if (entry->uncacheable)
                 req->setFlags(Request::UNCACHEABLE | Request::STRICT_ORDER);
+            // Outside of long mode, segment checks depend on the access
+            if (hit && m5Reg.mode == LongMode)
+                fastHit = entry;
         } else {
             //Use the address which already has segmentation applied.
             DPRINTF(TLB, "Paging disabled.\n");
@@ -501,7 +509,26 @@ TLB::translate(const RequestPtr &req,
         req->setPaddr(vaddr);
     }
 
-    return finalizePhysical(req, tc, mode);
+    const Addr paddr = req->getPaddr();
+    Fault fault = finalizePhysical(req, tc, mode);
+    // Remapped and local accesses depend on more than the page
+    if (req->getPaddr() != paddr || req->isLocalAccess())
+        fastHit = nullptr;
+    return fault;
+}
+
+void
+TLB::touchFastHit(void *entry, const RequestPtr &req, BaseMMU::Mode mode)
+{
+    // As translate() hitting entry
+    if (req->isCacheClean())
+        mode = BaseMMU::Read;
+    static_cast<TlbEntry *>(entry)->lruSeq = nextSeq();
+    if (mode == BaseMMU::Read) {
+        stats.rdAccesses++;
+    } else {
+        stats.wrAccesses++;
+    }
 }
 
 Fault
@@ -533,7 +560,7 @@ TLB::translateFunctional(const RequestPtr &req, ThreadContext *tc,
         paddr = insertBits(addr, logBytes - 1, 0, vaddr);
     } else {
         Process *process = tc->getProcessPtr();
-        const auto *pte = process->pTable->lookup(vaddr);
+        auto pte = process->pTable->lookup(vaddr);
 
         if (!pte && mode != BaseMMU::Execute) {
             // Check if we just need to grow the stack.
@@ -621,6 +648,7 @@ TLB::unserialize(CheckpointIn &cp)
         freeList.pop_front();
 
         newEntry->unserializeSection(cp, csprintf("Entry%d", x));
+        fastGeneration++;
         newEntry->trieHandle = trie.insert(newEntry->vaddr,
             TlbEntryTrie::MaxBits - newEntry->logBytes, newEntry);
     }
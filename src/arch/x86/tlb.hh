@@ -145,6 +145,10 @@ namespace X86ISA
             const RequestPtr &req, ThreadContext *tc,
             BaseMMU::Translation *translation, BaseMMU::Mode mode) override;
 
+        bool reportsFastHits() const override { return true; }
+        void touchFastHit(void *entry, const RequestPtr &req,
+                          BaseMMU::Mode mode) override;
+
         /**
          * Do post-translation physical address finalization.
          *
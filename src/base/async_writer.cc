@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/async_writer.hh"
+
+#include <zlib.h>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+AsyncWriter::AsyncWriter(const std::string &path, size_t max_pending,
+                         int compression_level)
+    : stream(path, std::ios::out | std::ios::binary | std::ios::trunc),
+      maxPending(max_pending ? max_pending : 1),
+      compressionLevel(compression_level)
+{
+    fatal_if(!stream.is_open(), "Unable to open %s for writing.", path);
+    thread = std::thread([this]() { run(); });
+}
+
+AsyncWriter::~AsyncWriter()
+{
+    close();
+}
+
+void
+AsyncWriter::write(Block &&block)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    panic_if(closing, "Writing to a closed AsyncWriter.");
+    if (pending.size() >= maxPending) {
+        _stalls++;
+        cond.wait(guard, [this]() { return pending.size() < maxPending; });
+    }
+    pending.push_back(std::move(block));
+    cond.notify_all();
+}
+
+void
+AsyncWriter::flush()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    cond.wait(guard, [this]() { return pending.empty() && !busy; });
+}
+
+void
+AsyncWriter::close()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (closing)
+            return;
+        closing = true;
+        cond.notify_all();
+    }
+    thread.join();
+    stream.close();
+}
+
+void
+AsyncWriter::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        cond.wait(guard, [this]() { return closing || !pending.empty(); });
+        if (pending.empty())
+            return;
+
+        Block block = std::move(pending.front());
+        pending.pop_front();
+        busy = true;
+        cond.notify_all();
+
+        guard.unlock();
+        writeBlock(block);
+        guard.lock();
+
+        busy = false;
+        cond.notify_all();
+    }
+}
+
+void
+AsyncWriter::writeBlock(const Block &block)
+{
+    const uint32_t raw_size = block.size();
+    const uint8_t *data = block.data();
+    uint32_t stored_size = raw_size;
+
+    Block compressed;
+    if (compressionLevel > 0 && raw_size) {
+        uLongf size = compressBound(raw_size);
+        compressed.resize(size);
+        if (compress2(compressed.data(), &size, data, raw_size,
+                      compressionLevel) == Z_OK && size < raw_size) {
+            data = compressed.data();
+            stored_size = size;
+        }
+    }
+
+    // Frame sizes are little endian, like everything else gem5 writes in
+    // its binary traces.
+    uint8_t header[8];
+    for (int i = 0; i < 4; i++) {
+        header[i] = raw_size >> (8 * i);
+        header[4 + i] = stored_size >> (8 * i);
+    }
+    stream.write(reinterpret_cast<const char *>(header), sizeof(header));
+    stream.write(reinterpret_cast<const char *>(data), stored_size);
+}
+
+} // namespace gem5
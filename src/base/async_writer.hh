@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_ASYNC_WRITER_HH__
+#define __BASE_ASYNC_WRITER_HH__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * Writes blocks of binary data to a file from a background thread,
+ * optionally compressing them with zlib on the way. This keeps the cost
+ * of compression and file I/O off the simulation thread for high volume
+ * traces.
+ *
+ * The number of blocks waiting to be written is bounded. When the writer
+ * thread cannot keep up, write() blocks until there is space, so memory
+ * use stays bounded at the expense of simulation speed.
+ *
+ * Every block is framed in the file as a little-endian uint32_t raw
+ * size, a uint32_t stored size and the stored bytes. The bytes are
+ * zlib-compressed if and only if the stored size is smaller than the raw
+ * size. Blocks are written in the order they were queued.
+ */
+class AsyncWriter
+{
+  public:
+    typedef std::vector<uint8_t> Block;
+
+  protected:
+    std::ofstream stream;
+    const size_t maxPending;
+    const int compressionLevel;
+
+    std::mutex lock;
+    std::condition_variable cond;
+    std::deque<Block> pending;
+    bool closing = false;
+    bool busy = false;
+
+    /** Number of times write() had to wait for the writer thread. */
+    uint64_t _stalls = 0;
+
+    std::thread thread;
+
+    void run();
+    void writeBlock(const Block &block);
+
+  public:
+    /**
+     * @param path File to create.
+     * @param max_pending Number of queued blocks before write() blocks.
+     * @param compression_level zlib level, 0 to store blocks as they are.
+     */
+    AsyncWriter(const std::string &path, size_t max_pending = 4,
+                int compression_level = 1);
+    ~AsyncWriter();
+
+    /** Queue a block to be written. The block is moved from. */
+    void write(Block &&block);
+
+    /** Wait until all queued blocks are written. */
+    void flush();
+
+    /** Write all queued blocks and close the file. */
+    void close();
+
+    bool isOpen() const { return stream.is_open(); }
+    uint64_t stalls() const { return _stalls; }
+};
+
+} // namespace gem5
+
+#endif // __BASE_ASYNC_WRITER_HH__
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "base/async_writer.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+typedef AsyncWriter::Block Block;
+
+/** Read back the blocks of a file, decompressing them as needed. */
+std::vector<Block>
+readBlocks(const std::string &path, std::vector<bool> *compressed=nullptr)
+{
+    std::ifstream is(path, std::ios::binary);
+    Block data((std::istreambuf_iterator<char>(is)),
+               std::istreambuf_iterator<char>());
+
+    std::vector<Block> blocks;
+    size_t pos = 0;
+    while (pos + 8 <= data.size()) {
+        uint32_t raw_size = 0, stored_size = 0;
+        for (int i = 0; i < 4; i++) {
+            raw_size |= uint32_t(data[pos + i]) << (8 * i);
+            stored_size |= uint32_t(data[pos + 4 + i]) << (8 * i);
+        }
+        pos += 8;
+
+        Block block(raw_size);
+        if (stored_size < raw_size) {
+            uLongf size = raw_size;
+            EXPECT_EQ(uncompress(block.data(), &size, &data[pos],
+                                 stored_size), Z_OK);
+            EXPECT_EQ(size, raw_size);
+        } else {
+            std::copy(&data[pos], &data[pos] + raw_size, block.begin());
+        }
+        if (compressed)
+            compressed->push_back(stored_size < raw_size);
+        pos += stored_size;
+        blocks.push_back(std::move(block));
+    }
+    EXPECT_EQ(pos, data.size());
+    return blocks;
+}
+
+std::string
+tempPath()
+{
+    return testing::TempDir() + "/async_writer.test." +
+        testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+} // anonymous namespace
+
+/** Test that blocks come back in order, whether compressed or not. */
+TEST(AsyncWriterTest, RoundTrip)
+{
+    const std::string path = tempPath();
+    std::vector<Block> expected;
+    {
+        AsyncWriter writer(path, 2, 1);
+        for (int i = 0; i < 32; i++) {
+            Block block(1000 + i, uint8_t(i));
+            if (i % 2) {
+                // Incompressible data is stored as it is.
+                for (auto &b : block)
+                    b = std::rand();
+            }
+            expected.push_back(block);
+            writer.write(std::move(block));
+        }
+        writer.write(Block());
+        expected.push_back(Block());
+    }
+
+    std::vector<bool> compressed;
+    EXPECT_EQ(readBlocks(path, &compressed), expected);
+    EXPECT_TRUE(compressed[0]);
+    EXPECT_FALSE(compressed[1]);
+    std::remove(path.c_str());
+}
+
+/** Test that a compression level of 0 stores all blocks uncompressed. */
+TEST(AsyncWriterTest, NoCompression)
+{
+    const std::string path = tempPath();
+    AsyncWriter writer(path, 1, 0);
+    writer.write(Block(4096, 0));
+    writer.flush();
+
+    std::vector<bool> compressed;
+    EXPECT_EQ(readBlocks(path, &compressed), std::vector<Block>{
+            Block(4096, 0)});
+    EXPECT_EQ(compressed, std::vector<bool>{false});
+
+    writer.close();
+    EXPECT_FALSE(writer.isOpen());
+    std::remove(path.c_str());
+}
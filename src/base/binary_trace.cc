@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "base/binary_trace.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "base/atomicio.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+namespace
+{
+
+/**
+ * Buffers small writes to a file descriptor on the stack, so that dumping
+ * does not allocate.
+ */
+class FdWriter
+{
+  private:
+    int fd;
+    char buf[512];
+    size_t used = 0;
+
+  public:
+    FdWriter(int _fd) : fd(_fd) {}
+    ~FdWriter() { flush(); }
+
+    void
+    flush()
+    {
+        atomic_write(fd, buf, used);
+        used = 0;
+    }
+
+    void
+    write(const void *data, size_t size)
+    {
+        const char *bytes = static_cast<const char *>(data);
+        while (size) {
+            if (used == sizeof(buf))
+                flush();
+            const size_t chunk = std::min(size, sizeof(buf) - used);
+            std::memcpy(buf + used, bytes, chunk);
+            used += chunk;
+            bytes += chunk;
+            size -= chunk;
+        }
+    }
+
+    template <typename T>
+    void
+    write(const T &value)
+    {
+        write(&value, sizeof(value));
+    }
+};
+
+uint64_t
+roundUpPow2(uint64_t n)
+{
+    uint64_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+std::atomic<uint64_t> nextInstance(1);
+
+} // anonymous namespace
+
+uint32_t
+BinaryTraceBuffer::StringTable::intern(const char *str)
+{
+    auto it = ids.find(str);
+    if (it != ids.end())
+        return it->second;
+
+    const uint32_t id = count.load(std::memory_order_relaxed);
+    panic_if(id == ChunkSize * MaxChunks,
+             "Too many debug flags and formats in the binary trace.");
+    auto &chunk = chunks[id / ChunkSize];
+    if (!chunk)
+        chunk.reset(new std::string[ChunkSize]);
+    chunk[id % ChunkSize] = str;
+    count.store(id + 1, std::memory_order_release);
+
+    ids.emplace(str, id);
+    return id;
+}
+
+BinaryTraceBuffer::BinaryTraceBuffer(size_t entries)
+    : slots(new Slot[roundUpPow2(entries ? entries : 1)]),
+      mask(roundUpPow2(entries ? entries : 1) - 1), head(0),
+      instance(nextInstance.fetch_add(1, std::memory_order_relaxed))
+{
+    for (uint64_t i = 0; i <= mask; ++i)
+        slots[i].seq.store(0, std::memory_order_relaxed);
+}
+
+uint32_t
+BinaryTraceBuffer::lookup(TableId table, const char *str)
+{
+    struct Cached
+    {
+        uint32_t id;
+        const std::string *str;
+    };
+
+    static thread_local struct
+    {
+        uint64_t instance = 0;
+        std::unordered_map<const char *, Cached> ids[NumTables];
+    } cache;
+
+    if (cache.instance != instance) {
+        for (auto &ids : cache.ids)
+            ids.clear();
+        cache.instance = instance;
+    }
+
+    // The same address may be reused for a different string if it was not
+    // a literal, so double-check the contents on a hit.
+    auto it = cache.ids[table].find(str);
+    if (it != cache.ids[table].end() && it->second.str->compare(str) == 0)
+        return it->second.id;
+
+    Cached cached;
+    {
+        std::lock_guard<UncontendedMutex> lock(tableLock);
+        cached.id = tables[table].intern(str);
+        cached.str = &tables[table].get(cached.id);
+    }
+    cache.ids[table][str] = cached;
+    return cached.id;
+}
+
+uint64_t
+BinaryTraceBuffer::claim(Tick when, const std::string &name,
+                         const char *flag, const char *fmt)
+{
+    const uint32_t flag_id = lookup(FlagTable, flag);
+    const uint32_t fmt_id = lookup(FormatTable, fmt);
+
+    const uint64_t seq = head.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = slots[seq & mask];
+
+    // Own the slot first so that a dump racing with this writer never
+    // sees a half-written record. The writer of the record a whole ring
+    // before may still be filling it, and the two records must not mix,
+    // so wait for that one to be published.
+    uint64_t prev = slot.seq.load(std::memory_order_relaxed);
+    do {
+        while (prev == Writing)
+            prev = slot.seq.load(std::memory_order_relaxed);
+    } while (!slot.seq.compare_exchange_weak(prev, Writing,
+                                             std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.when = when;
+    slot.flag = flag_id;
+    slot.fmt = fmt_id;
+    slot.nameSize = std::min(name.size(), MaxNameSize);
+    std::memcpy(slot.payload, name.data(), slot.nameSize);
+    slot.numArgs = 0;
+    slot.truncated = 0;
+    slot.payloadSize = slot.nameSize;
+
+    return seq;
+}
+
+void
+BinaryTraceBuffer::dump(int fd) const
+{
+    FdWriter out(fd);
+    out.write(Magic, sizeof(Magic));
+    out.write<uint32_t>(Version);
+
+    // The tables only grow, and their strings never move, so they can be
+    // read up to their published count without the lock. A string being
+    // interned concurrently is missed, but no surviving record can refer
+    // to it yet.
+    for (const auto &table : tables) {
+        const uint32_t count = table.count.load(std::memory_order_acquire);
+        out.write<uint32_t>(count);
+        for (uint32_t id = 0; id < count; ++id) {
+            const std::string &str = table.get(id);
+            out.write<uint32_t>(str.size());
+            out.write(str.data(), str.size());
+        }
+    }
+
+    const uint64_t end = head.load(std::memory_order_acquire);
+    const uint64_t begin = end > capacity() ? end - capacity() : 0;
+    out.write<uint64_t>(end);
+
+    // Records follow until the end of the file. Each slot is copied
+    // before being written, and skipped if it was overwritten meanwhile.
+    Slot copy;
+    for (uint64_t seq = begin; seq < end; ++seq) {
+        const Slot &slot = slots[seq & mask];
+        if (slot.seq.load(std::memory_order_acquire) != seq + 1)
+            continue;
+        copy.when = slot.when;
+        copy.flag = slot.flag;
+        copy.fmt = slot.fmt;
+        copy.nameSize = slot.nameSize;
+        copy.payloadSize = slot.payloadSize;
+        copy.numArgs = slot.numArgs;
+        copy.truncated = slot.truncated;
+        std::memcpy(copy.payload, slot.payload, sizeof(copy.payload));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq + 1 ||
+                copy.payloadSize > sizeof(copy.payload) ||
+                copy.nameSize > copy.payloadSize) {
+            continue;
+        }
+
+        out.write<uint64_t>(copy.when);
+        out.write<uint32_t>(copy.flag);
+        out.write<uint32_t>(copy.fmt);
+        out.write<uint8_t>(copy.numArgs);
+        out.write<uint8_t>(copy.truncated);
+        out.write<uint16_t>(copy.nameSize);
+        out.write<uint16_t>(copy.payloadSize - copy.nameSize);
+        out.write(copy.payload, copy.payloadSize);
+    }
+}
+
+} // namespace trace
+} // namespace gem5
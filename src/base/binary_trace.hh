@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#include "base/types.hh"
+#include "base/uncontended_mutex.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+/**
+ * A fixed-size ring of binary debug records. Instead of formatting a
+ * message when it is logged, the tick, the object name, the interned
+ * debug flag and format string, and the raw arguments are copied into the
+ * next slot of the ring. Old records are overwritten once the ring wraps,
+ * so the buffer always holds the most recent messages (a flight
+ * recorder).
+ *
+ * Slots are claimed with a single atomic increment, and flags and formats
+ * are looked up by address in a per-thread cache, so several event queue
+ * threads can record concurrently without taking a lock. A writer only
+ * waits if the writer of the record a whole ring before is still filling
+ * the same slot. The ring is rendered to text offline by
+ * util/decode_binary_trace.py from the file written by dump().
+ */
+class BinaryTraceBuffer
+{
+  public:
+    /** Bytes per slot, header included. Longer records are truncated. */
+    static constexpr size_t SlotSize = 256;
+
+    /** Magic number and version at the start of a dumped file. */
+    static constexpr char Magic[8] = {'g', 'e', 'm', '5', 'b', 't', 'r', 0};
+    static constexpr uint32_t Version = 2;
+
+    /** Longest object name kept in a record. */
+    static constexpr size_t MaxNameSize = 128;
+
+    /** Type tags prefixed to each argument in a record payload. */
+    enum ArgType : uint8_t
+    {
+        ArgSigned,    //< int64_t
+        ArgUnsigned,  //< uint64_t
+        ArgFloat,     //< double
+        ArgChar,      //< uint8_t
+        ArgString,    //< uint16_t length followed by the characters
+        ArgPointer,   //< uint64_t
+    };
+
+  protected:
+    /** Sequence of a slot being written, which no record can have. */
+    static constexpr uint64_t Writing = ~uint64_t(0);
+
+    struct Slot
+    {
+        /**
+         * Sequence number + 1 of the record, 0 if the slot is empty and
+         * Writing while a writer owns it.
+         */
+        std::atomic<uint64_t> seq;
+        Tick when;
+        uint32_t flag;
+        uint32_t fmt;
+        /** The payload starts with the nameSize bytes of the name. */
+        uint16_t nameSize;
+        uint16_t payloadSize;
+        uint8_t numArgs;
+        uint8_t truncated;
+        uint8_t payload[SlotSize - 30];
+    };
+    static_assert(sizeof(Slot) == SlotSize, "Unexpected slot padding");
+
+    /** Helper that appends tagged arguments to a slot payload. */
+    class Encoder
+    {
+      private:
+        Slot &slot;
+
+        bool
+        reserve(size_t bytes)
+        {
+            if (slot.truncated ||
+                    slot.payloadSize + bytes > sizeof(slot.payload)) {
+                slot.truncated = 1;
+                return false;
+            }
+            return true;
+        }
+
+        template <typename T>
+        void
+        put(ArgType type, T value)
+        {
+            if (!reserve(1 + sizeof(T)))
+                return;
+            slot.payload[slot.payloadSize++] = type;
+            std::memcpy(&slot.payload[slot.payloadSize], &value, sizeof(T));
+            slot.payloadSize += sizeof(T);
+            ++slot.numArgs;
+        }
+
+        void
+        putString(const char *str, size_t len)
+        {
+            // Strings are cut to whatever is left of the slot rather than
+            // being dropped altogether.
+            if (!reserve(1 + sizeof(uint16_t)))
+                return;
+            const size_t avail =
+                sizeof(slot.payload) - slot.payloadSize - 1 - sizeof(uint16_t);
+            if (len > avail) {
+                len = avail;
+                slot.truncated = 1;
+            }
+            const uint16_t len16 = len;
+            slot.payload[slot.payloadSize++] = ArgString;
+            std::memcpy(&slot.payload[slot.payloadSize], &len16,
+                        sizeof(len16));
+            slot.payloadSize += sizeof(len16);
+            std::memcpy(&slot.payload[slot.payloadSize], str, len);
+            slot.payloadSize += len;
+            ++slot.numArgs;
+        }
+
+      public:
+        Encoder(Slot &_slot) : slot(_slot) {}
+
+        void add(const char *str) { putString(str, std::strlen(str)); }
+        void add(char *str) { add(static_cast<const char *>(str)); }
+        void add(const std::string &s) { putString(s.data(), s.size()); }
+        void add(bool b) { put<uint64_t>(ArgUnsigned, b); }
+        void add(char c) { put<uint8_t>(ArgChar, c); }
+        void add(signed char c) { put<uint8_t>(ArgChar, c); }
+        void add(unsigned char c) { put<uint8_t>(ArgChar, c); }
+
+        template <typename T>
+        void
+        add(const T &arg)
+        {
+            if constexpr (std::is_enum_v<T>) {
+                add(static_cast<std::underlying_type_t<T>>(arg));
+            } else if constexpr (std::is_integral_v<T> &&
+                                 std::is_signed_v<T>) {
+                put<int64_t>(ArgSigned, arg);
+            } else if constexpr (std::is_integral_v<T>) {
+                put<uint64_t>(ArgUnsigned, arg);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                put<double>(ArgFloat, arg);
+            } else if constexpr (std::is_pointer_v<T>) {
+                put<uint64_t>(ArgPointer, reinterpret_cast<uintptr_t>(arg));
+            } else {
+                // Anything else is only printable through operator<<, so
+                // it has to be rendered here, off the fast path.
+                std::ostringstream os;
+                os << arg;
+                add(os.str());
+            }
+        }
+    };
+
+    /**
+     * Interned strings, indexed by the ids stored in the records. The
+     * strings are kept in chunks which are never reallocated, and are
+     * only made visible by publishing the new count, so dump() can read
+     * them without the lock.
+     */
+    struct StringTable
+    {
+        static constexpr uint32_t ChunkSize = 1024;
+        static constexpr uint32_t MaxChunks = 1024;
+
+        std::unique_ptr<std::string[]> chunks[MaxChunks];
+        std::atomic<uint32_t> count{0};
+        std::unordered_map<std::string, uint32_t> ids;
+
+        const std::string &
+        get(uint32_t id) const
+        {
+            return chunks[id / ChunkSize][id % ChunkSize];
+        }
+
+        uint32_t intern(const char *str);
+    };
+
+    enum TableId
+    {
+        FlagTable,
+        FormatTable,
+        NumTables
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    const uint64_t mask;
+    std::atomic<uint64_t> head;
+
+    /** Tells the per-thread caches of different buffers apart. */
+    const uint64_t instance;
+
+    /** Only taken to intern a string a thread has not used before. */
+    UncontendedMutex tableLock;
+    StringTable tables[NumTables];
+
+    /**
+     * Get the id of an interned string. Flags and formats are literals in
+     * almost all cases, so the ids are cached by address in the calling
+     * thread, which only has to compare the contents on a hit.
+     */
+    uint32_t lookup(TableId table, const char *str);
+
+    /**
+     * Claim the next slot and fill in everything but the arguments.
+     * @return The sequence number of the claimed slot.
+     */
+    uint64_t claim(Tick when, const std::string &name, const char *flag,
+                   const char *fmt);
+
+  public:
+    /**
+     * @param entries Number of records kept. Rounded up to a power of two.
+     */
+    BinaryTraceBuffer(size_t entries);
+
+    /** Record a message and its raw arguments. */
+    template <typename ...Args>
+    void
+    record(Tick when, const std::string &name, const char *flag,
+           const char *fmt, const Args &...args)
+    {
+        const uint64_t seq = claim(when, name, flag, fmt);
+        Slot &slot = slots[seq & mask];
+        Encoder enc(slot);
+        (enc.add(args), ...);
+        slot.seq.store(seq + 1, std::memory_order_release);
+    }
+
+    /** Number of slots in the ring. */
+    size_t capacity() const { return mask + 1; }
+
+    /** Total number of records ever written, including overwritten ones. */
+    uint64_t written() const { return head.load(); }
+
+    /**
+     * Write the string tables and the surviving records, oldest first, in
+     * the format understood by util/decode_binary_trace.py. This neither
+     * allocates nor takes a lock, and only writes with write(2), so it
+     * can be called from a fatal signal handler, even if the signal was
+     * raised while recording.
+     *
+     * @param fd File descriptor to write to.
+     */
+    void dump(int fd) const;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_BINARY_TRACE_HH__
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/binary_trace.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Minimal parser of the dump format, mirroring decode_binary_trace.py. */
+struct Dump
+{
+    struct Record
+    {
+        Tick when;
+        uint32_t flag, fmt;
+        uint8_t numArgs, truncated;
+        std::string name;
+        std::string payload;
+    };
+
+    std::vector<std::string> flags, formats;
+    uint64_t written = 0;
+    std::vector<Record> records;
+
+    template <typename T>
+    static T
+    read(std::istream &is)
+    {
+        T value;
+        is.read(reinterpret_cast<char *>(&value), sizeof(value));
+        return value;
+    }
+
+    static std::vector<std::string>
+    readTable(std::istream &is)
+    {
+        std::vector<std::string> table(read<uint32_t>(is));
+        for (auto &str : table) {
+            str.resize(read<uint32_t>(is));
+            is.read(str.data(), str.size());
+        }
+        return table;
+    }
+
+    /** Bytes dumped by the buffer, read back through a temporary file. */
+    static std::string
+    dumpToString(const trace::BinaryTraceBuffer &buffer)
+    {
+        std::FILE *file = std::tmpfile();
+        EXPECT_NE(file, nullptr);
+        buffer.dump(fileno(file));
+
+        std::string data;
+        std::rewind(file);
+        char chunk[4096];
+        size_t size;
+        while ((size = std::fread(chunk, 1, sizeof(chunk), file)))
+            data.append(chunk, size);
+        std::fclose(file);
+        return data;
+    }
+
+    Dump(const trace::BinaryTraceBuffer &buffer)
+    {
+        std::istringstream ss(dumpToString(buffer));
+
+        char magic[8];
+        ss.read(magic, sizeof(magic));
+        EXPECT_EQ(std::memcmp(magic, trace::BinaryTraceBuffer::Magic,
+                              sizeof(magic)), 0);
+        EXPECT_EQ(read<uint32_t>(ss), trace::BinaryTraceBuffer::Version);
+
+        flags = readTable(ss);
+        formats = readTable(ss);
+        written = read<uint64_t>(ss);
+        while (ss.peek() != std::char_traits<char>::eof()) {
+            Record rec;
+            rec.when = read<uint64_t>(ss);
+            rec.flag = read<uint32_t>(ss);
+            rec.fmt = read<uint32_t>(ss);
+            rec.numArgs = read<uint8_t>(ss);
+            rec.truncated = read<uint8_t>(ss);
+            rec.name.resize(read<uint16_t>(ss));
+            rec.payload.resize(read<uint16_t>(ss));
+            ss.read(rec.name.data(), rec.name.size());
+            ss.read(rec.payload.data(), rec.payload.size());
+            records.push_back(rec);
+        }
+    }
+
+    uint64_t dropped() const { return written - records.size(); }
+};
+
+} // anonymous namespace
+
+/** Test that strings are interned and arguments are tagged by type. */
+TEST(BinaryTraceTest, RecordArguments)
+{
+    trace::BinaryTraceBuffer buffer(4);
+    buffer.record(10, "obj", "Flag", "%d %#x %s %c %f\n",
+                  -3, 0x10u, "str", 'c', 1.5);
+    buffer.record(20, "obj", "Flag", "%s\n", std::string("again"));
+
+    Dump dump(buffer);
+    ASSERT_EQ(dump.records.size(), 2u);
+    EXPECT_EQ(dump.dropped(), 0u);
+    EXPECT_EQ(dump.flags, std::vector<std::string>{"Flag"});
+    ASSERT_EQ(dump.formats.size(), 2u);
+
+    const auto &rec = dump.records[0];
+    EXPECT_EQ(rec.when, 10u);
+    EXPECT_EQ(rec.name, "obj");
+    EXPECT_EQ(dump.flags[rec.flag], "Flag");
+    EXPECT_EQ(rec.numArgs, 5u);
+    EXPECT_EQ(rec.truncated, 0u);
+    EXPECT_EQ(dump.formats[rec.fmt], "%d %#x %s %c %f\n");
+
+    const char *p = rec.payload.data();
+    int64_t s;
+    uint64_t u;
+    EXPECT_EQ(*p++, trace::BinaryTraceBuffer::ArgSigned);
+    std::memcpy(&s, p, sizeof(s));
+    p += sizeof(s);
+    EXPECT_EQ(s, -3);
+    EXPECT_EQ(*p++, trace::BinaryTraceBuffer::ArgUnsigned);
+    std::memcpy(&u, p, sizeof(u));
+    p += sizeof(u);
+    EXPECT_EQ(u, 0x10u);
+    EXPECT_EQ(*p++, trace::BinaryTraceBuffer::ArgString);
+    uint16_t len;
+    std::memcpy(&len, p, sizeof(len));
+    p += sizeof(len);
+    EXPECT_EQ(std::string(p, len), "str");
+    p += len;
+    EXPECT_EQ(*p++, trace::BinaryTraceBuffer::ArgChar);
+    EXPECT_EQ(*p++, 'c');
+    EXPECT_EQ(*p++, trace::BinaryTraceBuffer::ArgFloat);
+}
+
+/** Test that only the most recent records survive a wrap of the ring. */
+TEST(BinaryTraceTest, RingWraps)
+{
+    trace::BinaryTraceBuffer buffer(3);
+    ASSERT_EQ(buffer.capacity(), 4u);
+
+    for (int i = 0; i < 10; i++)
+        buffer.record(i, "obj", "Flag", "%d\n", i);
+
+    Dump dump(buffer);
+    EXPECT_EQ(buffer.written(), 10u);
+    EXPECT_EQ(dump.dropped(), 6u);
+    ASSERT_EQ(dump.records.size(), 4u);
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(dump.records[i].when, Tick(6 + i));
+}
+
+/** Test that arguments not fitting in a slot are cut and marked. */
+TEST(BinaryTraceTest, Truncation)
+{
+    trace::BinaryTraceBuffer buffer(1);
+    buffer.record(0, "", "", "%s %d\n",
+                  std::string(trace::BinaryTraceBuffer::SlotSize, 'a'), 1);
+
+    Dump dump(buffer);
+    ASSERT_EQ(dump.records.size(), 1u);
+    EXPECT_EQ(dump.records[0].numArgs, 1u);
+    EXPECT_EQ(dump.records[0].truncated, 1u);
+    EXPECT_LT(dump.records[0].payload.size(),
+              trace::BinaryTraceBuffer::SlotSize);
+}
+
+/** Test that a flag buffer reused for a different string is re-interned. */
+TEST(BinaryTraceTest, ReusedFlagAddress)
+{
+    trace::BinaryTraceBuffer buffer(4);
+    char flag[8] = "First";
+    buffer.record(0, "obj", flag, "%d\n", 0);
+    std::strcpy(flag, "Second");
+    buffer.record(1, "obj", flag, "%d\n", 1);
+
+    Dump dump(buffer);
+    ASSERT_EQ(dump.records.size(), 2u);
+    EXPECT_EQ(dump.flags[dump.records[0].flag], "First");
+    EXPECT_EQ(dump.flags[dump.records[1].flag], "Second");
+    EXPECT_EQ(dump.records[0].fmt, dump.records[1].fmt);
+}
+
+/** Test that long object names are cut to MaxNameSize. */
+TEST(BinaryTraceTest, LongName)
+{
+    trace::BinaryTraceBuffer buffer(1);
+    const std::string name(2 * trace::BinaryTraceBuffer::MaxNameSize, 'n');
+    buffer.record(0, name, "Flag", "%d\n", 1);
+
+    Dump dump(buffer);
+    ASSERT_EQ(dump.records.size(), 1u);
+    EXPECT_EQ(dump.records[0].name,
+              name.substr(0, trace::BinaryTraceBuffer::MaxNameSize));
+    EXPECT_EQ(dump.records[0].numArgs, 1u);
+}
+
+/**
+ * Test that records dumped while several threads overwrite a small ring
+ * are never mixed from two writers.
+ */
+TEST(BinaryTraceTest, ConcurrentWriters)
+{
+    trace::BinaryTraceBuffer buffer(4);
+    const int num_threads = 4;
+    const int num_records = 20000;
+
+    std::atomic<bool> done(false);
+    std::vector<std::thread> writers;
+    for (int t = 0; t < num_threads; t++) {
+        writers.emplace_back([&buffer, t]() {
+            // The name and the argument both identify the writer.
+            const std::string name(t + 1, 'a' + t);
+            for (int i = 0; i < num_records; i++)
+                buffer.record(t * num_records + i, name, "Flag", "%d\n",
+                              t * num_records + i);
+        });
+    }
+    std::thread reader([&]() {
+        while (!done.load()) {
+            Dump dump(buffer);
+            for (const auto &rec : dump.records) {
+                const int t = rec.when / num_records;
+                EXPECT_EQ(rec.name, std::string(t + 1, 'a' + t));
+                ASSERT_EQ(rec.payload.size(), 1 + sizeof(int64_t));
+                int64_t arg;
+                std::memcpy(&arg, rec.payload.data() + 1, sizeof(arg));
+                EXPECT_EQ(arg, int64_t(rec.when));
+            }
+        }
+    });
+
+    for (auto &writer : writers)
+        writer.join();
+    done.store(true);
+    reader.join();
+
+    Dump dump(buffer);
+    EXPECT_EQ(buffer.written(), uint64_t(num_threads * num_records));
+    EXPECT_EQ(dump.records.size(), buffer.capacity());
+}
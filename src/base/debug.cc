@@ -97,8 +97,8 @@ findFlag(const std::string &name)
     return i->second;
 }
 
-Flag::Flag(const char *name, const char *desc)
-    : _name(name), _desc(desc)
+Flag::Flag(const char *name, const char *desc, bool kept)
+    : _name(name), _desc(desc), _kept(kept)
 {
     std::pair<FlagsMap::iterator, bool> result =
         allFlags().insert(std::make_pair(name, this));
@@ -129,8 +129,9 @@ Flag::globalDisable()
         i.second->sync();
 }
 
-SimpleFlag::SimpleFlag(const char *name, const char *desc, bool is_format)
-  : Flag(name, desc), _isFormat(is_format)
+SimpleFlag::SimpleFlag(const char *name, const char *desc, bool is_format,
+                       bool kept)
+  : Flag(name, desc, kept), _isFormat(is_format)
 {
     // Add non-format flags to the special "All" compound flag.
     if (!isFormat())
@@ -68,16 +68,28 @@ class Flag
     const char *_name;
     const char *_desc;
 
+    // DPRINTFs on this flag are kept in builds without TRACING_ON
+    const bool _kept;
+
     virtual void sync() { }
 
   public:
-    Flag(const char *name, const char *desc);
+    Flag(const char *name, const char *desc, bool kept=false);
     virtual ~Flag();
 
     std::string name() const { return _name; }
     std::string desc() const { return _desc; }
 
-    bool tracing() const { return TRACING_ON && _tracing; }
+    /**
+     * Only the flags kept by the build are constructed as kept, so this
+     * is the same in all the objects of a build whatever their
+     * TRACING_ON.
+     */
+    bool
+    tracing() const
+    {
+        return (TRACING_ON || _kept) && _tracing;
+    }
 
     virtual void enable() = 0;
     virtual void disable() = 0;
@@ -99,7 +111,8 @@ class SimpleFlag : public Flag
     void sync() override { _tracing = _globalEnable && _enabled; }
 
   public:
-    SimpleFlag(const char *name, const char *desc, bool is_format=false);
+    SimpleFlag(const char *name, const char *desc, bool is_format=false,
+               bool kept=false);
 
     void enable() override  { _enabled = true;  sync(); }
     void disable() override { _enabled = false; sync(); }
@@ -121,8 +134,8 @@ class CompoundFlag : public Flag
   public:
     template<typename... Args>
     CompoundFlag(const char *name, const char *desc,
-                 std::initializer_list<Flag *> flags)
-        : Flag(name, desc),
+                 std::initializer_list<Flag *> flags, bool kept=false)
+        : Flag(name, desc, kept),
           _kids(flags)
     {
     }
@@ -163,12 +176,40 @@ void clearDebugFlag(const char *string);
 void dumpDebugFlags(std::ostream &os=std::cout);
 
 /**
+ * Whether all debug flags are compiled in. When this is false, e.g. in
+ * gem5.fast, only the DPRINTFs on the flags listed in the
+ * TRACING_FAST_FLAGS build option are kept. The others are compiled to
+ * nothing, which is decided at compile time through the constexpr
+ * debug::compiled::<flag> descriptor generated with each flag.
+ *
+ * TRACING_KEPT_FLAGS is set when some flags are kept that way although
+ * TRACING_ON is not. It only enables the flag-checked DPRINTFs; code under
+ * "#if TRACING_ON" and the unconditional printing macros stay compiled
+ * out.
+ */
+#ifndef TRACING_ALL_FLAGS
+#define TRACING_ALL_FLAGS TRACING_ON
+#endif
+
+#ifndef TRACING_KEPT_FLAGS
+#define TRACING_KEPT_FLAGS 0
+#endif
+
+/**
+ * \def GEM5_DEBUG_TRACING(x)
  * \def DTRACE(x)
  *
+ * GEM5_DEBUG_TRACING(x) checks whether debug flag x is tracing, and is a
+ * constant false if DPRINTFs on x are not compiled in.
+ *
  * @ingroup api_trace
  * @{
  */
-#define DTRACE(x) GEM5_DEPRECATED_MACRO(DTRACE, debug::x, \
+#define GEM5_DEBUG_TRACING(x) \
+    ((TRACING_ON || TRACING_KEPT_FLAGS) && \
+     ::gem5::debug::compiled::x && ::gem5::debug::x)
+
+#define DTRACE(x) GEM5_DEPRECATED_MACRO(DTRACE, GEM5_DEBUG_TRACING(x), \
         "Replace DTRACE(x) with debug::x.")
 /** @} */ // end of api_trace
 
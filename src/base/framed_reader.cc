@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/framed_reader.hh"
+
+#include <zlib.h>
+
+namespace gem5
+{
+
+FramedReader::FramedReader(const std::string &path)
+    : stream(path, std::ios::in | std::ios::binary)
+{
+    if (!stream.is_open())
+        _error = "cannot open " + path;
+}
+
+bool
+FramedReader::read(AsyncWriter::Block &block)
+{
+    block.clear();
+    if (!stream.is_open())
+        return false;
+
+    uint8_t header[8];
+    stream.read(reinterpret_cast<char *>(header), sizeof(header));
+    if (stream.gcount() == 0)
+        return false;
+    if (stream.gcount() != sizeof(header)) {
+        _error = "truncated frame header";
+        return false;
+    }
+
+    uint32_t raw_size = 0, stored_size = 0;
+    for (int i = 0; i < 4; i++) {
+        raw_size |= uint32_t(header[i]) << (8 * i);
+        stored_size |= uint32_t(header[4 + i]) << (8 * i);
+    }
+    if (stored_size > raw_size) {
+        _error = "stored size larger than the block";
+        return false;
+    }
+
+    AsyncWriter::Block stored(stored_size);
+    stream.read(reinterpret_cast<char *>(stored.data()), stored_size);
+    if (stream.gcount() != stored_size) {
+        _error = "truncated frame";
+        return false;
+    }
+
+    if (stored_size == raw_size) {
+        block.swap(stored);
+        return true;
+    }
+
+    block.resize(raw_size);
+    uLongf size = raw_size;
+    if (uncompress(block.data(), &size, stored.data(), stored_size) != Z_OK ||
+            size != raw_size) {
+        _error = "corrupt compressed frame";
+        block.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace gem5
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_FRAMED_READER_HH__
+#define __BASE_FRAMED_READER_HH__
+
+#include <fstream>
+#include <string>
+
+#include "base/async_writer.hh"
+
+namespace gem5
+{
+
+/**
+ * Reads back the blocks of a file written by an AsyncWriter, one at a
+ * time, uncompressing them as needed. Only one block is held in memory,
+ * so traces larger than the host memory can be streamed.
+ */
+class FramedReader
+{
+  protected:
+    std::ifstream stream;
+    std::string _error;
+
+  public:
+    FramedReader(const std::string &path);
+
+    /**
+     * Read the next block.
+     * @return False at the end of the file or on a malformed frame, in
+     *         which case error() describes the problem.
+     */
+    bool read(AsyncWriter::Block &block);
+
+    bool isOpen() const { return stream.is_open(); }
+
+    /** Description of the last error, empty if there was none. */
+    const std::string &error() const { return _error; }
+};
+
+} // namespace gem5
+
+#endif // __BASE_FRAMED_READER_HH__
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "base/async_writer.hh"
+#include "base/framed_reader.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+typedef AsyncWriter::Block Block;
+
+std::string
+tempPath()
+{
+    return testing::TempDir() + "/framed_reader.test." +
+        testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+} // anonymous namespace
+
+/** Test that the blocks of an AsyncWriter are read back in order. */
+TEST(FramedReaderTest, RoundTrip)
+{
+    const std::string path = tempPath();
+    std::vector<Block> expected;
+    {
+        AsyncWriter writer(path, 2, 1);
+        for (int i = 0; i < 16; i++) {
+            Block block(500 + i, uint8_t(i));
+            if (i % 2) {
+                for (auto &b : block)
+                    b = std::rand();
+            }
+            expected.push_back(block);
+            writer.write(std::move(block));
+        }
+        writer.write(Block());
+        expected.push_back(Block());
+    }
+
+    FramedReader reader(path);
+    ASSERT_TRUE(reader.isOpen());
+    std::vector<Block> blocks;
+    Block block;
+    // An empty block still has a frame, so it is read back as well.
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_TRUE(reader.read(block));
+        blocks.push_back(block);
+    }
+    EXPECT_FALSE(reader.read(block));
+    EXPECT_TRUE(reader.error().empty());
+    EXPECT_EQ(blocks, expected);
+    std::remove(path.c_str());
+}
+
+/** Test that a cut off frame is reported as an error. */
+TEST(FramedReaderTest, Truncated)
+{
+    const std::string path = tempPath();
+    {
+        AsyncWriter writer(path, 1, 0);
+        writer.write(Block(64, 1));
+    }
+    {
+        std::ofstream os(path, std::ios::binary | std::ios::app);
+        const char partial[6] = {16, 0, 0, 0, 16, 0};
+        os.write(partial, sizeof(partial));
+    }
+
+    FramedReader reader(path);
+    Block block;
+    EXPECT_TRUE(reader.read(block));
+    EXPECT_EQ(block, Block(64, 1));
+    EXPECT_FALSE(reader.read(block));
+    EXPECT_FALSE(reader.error().empty());
+    std::remove(path.c_str());
+}
+
+/** Test that a missing file is not open and reports an error. */
+TEST(FramedReaderTest, MissingFile)
+{
+    FramedReader reader(tempPath());
+    Block block;
+    EXPECT_FALSE(reader.isOpen());
+    EXPECT_FALSE(reader.read(block));
+    EXPECT_FALSE(reader.error().empty());
+}
@@ -31,6 +31,8 @@
 
 #include "base/trace.hh"
 
+#include <unistd.h>
+
 #include <cctype>
 #include <fstream>
 #include <iostream>
@@ -169,5 +171,47 @@ OstreamLogger::logMessage(Tick when, const std::string &name,
     }
 }
 
+BinaryLogger::BinaryLogger(int fd_, size_t entries)
+    : fd(fd_), buffer(entries), lineBuffer(*this), lineStream(&lineBuffer),
+      flushed(false)
+{
+    binaryBuffer = &buffer;
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    close(fd);
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!isEnabled(name))
+        return;
+
+    buffer.record(when, name, flag.c_str(), "%s", message);
+}
+
+int
+BinaryLogger::LineBuffer::sync()
+{
+    const std::string line = str();
+    if (!line.empty()) {
+        logger.logMessage(curTick(), "", "", line);
+        str("");
+    }
+    return 0;
+}
+
+void
+BinaryLogger::flush()
+{
+    if (flushed.exchange(true))
+        return;
+
+    buffer.dump(fd);
+}
+
 } // namespace trace
 } // namespace gem5
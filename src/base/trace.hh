@@ -32,10 +32,12 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <atomic>
 #include <ostream>
 #include <string>
 #include <sstream>
 
+#include "base/binary_trace.hh"
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
 #include "base/debug.hh"
@@ -64,6 +66,10 @@ class Logger
     /** Name match for objects to activate log */
     ObjectMatch activate;
 
+    /** If set, messages are recorded here unformatted instead of being
+     *  passed to logMessage() */
+    BinaryTraceBuffer *binaryBuffer = nullptr;
+
     bool isEnabled(const std::string &name) const
     {
         if (name.empty()) // Enable the logger with a empty name.
@@ -96,11 +102,29 @@ class Logger
     {
         if (!isEnabled(name))
             return;
+        if (binaryBuffer) {
+            binaryBuffer->record(when, name, flag.c_str(), fmt, args...);
+            return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
     }
 
+    /** Log a single message with a literal flag prefix, which the binary
+     *  buffer can look up by address. */
+    template <typename ...Args>
+    void dprintf_flag(Tick when, const std::string &name,
+            const char *flag, const char *fmt, const Args &...args)
+    {
+        if (binaryBuffer) {
+            if (isEnabled(name))
+                binaryBuffer->record(when, name, flag, fmt, args...);
+            return;
+        }
+        dprintf_flag(when, name, std::string(flag), fmt, args...);
+    }
+
     /** Dump a block of data of length len */
     void dump(Tick when, const std::string &name,
             const void *d, int len, const std::string &flag);
@@ -116,6 +140,10 @@ class Logger
      *  way, or just set to one of std::cout, std::cerr */
     virtual std::ostream &getOstream() = 0;
 
+    /** Write out any messages the logger holds back, e.g. when the
+     *  simulator exits or crashes */
+    virtual void flush() { }
+
     /** Set objects to ignore */
     void setIgnore(ObjectMatch &ignore_) { ignore = ignore_; }
 
@@ -148,6 +176,52 @@ class OstreamLogger : public Logger
     std::ostream &getOstream() override { return stream; }
 };
 
+/** Logger which records messages and their raw arguments in an in-memory
+ *  ring of the most recent messages, written to the stream in binary on
+ *  flush(). Use util/decode_binary_trace.py to render it as text. */
+class BinaryLogger : public Logger
+{
+  protected:
+    /** Turns complete lines written to getOstream() into messages */
+    class LineBuffer : public std::stringbuf
+    {
+      protected:
+        BinaryLogger &logger;
+
+        int sync() override;
+
+      public:
+        LineBuffer(BinaryLogger &logger_) : logger(logger_) { }
+    };
+
+    /** Opened up front, so that the ring can be written from a fatal
+     *  signal handler. */
+    int fd;
+    BinaryTraceBuffer buffer;
+    LineBuffer lineBuffer;
+    std::ostream lineStream;
+    std::atomic<bool> flushed;
+
+  public:
+    /**
+     * @param fd_ File descriptor the ring is written to. The logger
+     *            takes ownership of it.
+     * @param entries Number of records kept.
+     */
+    BinaryLogger(int fd_, size_t entries);
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    std::ostream &getOstream() override { return lineStream; }
+
+    /** Write the ring to the file. Only the first call has an effect so
+     *  that an exit after a dump does not append a second copy. This is
+     *  async-signal-safe. */
+    void flush() override;
+};
+
 /** Get the current global debug logger.  This takes ownership of the given
  *  logger which should be allocated using 'new' */
 Logger *getDebugLogger();
@@ -202,27 +276,27 @@ struct StringWrap
  */
 
 #define DDUMP(x, data, count) do {               \
-    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x))     \
+    if (GEM5_UNLIKELY(GEM5_DEBUG_TRACING(x)))    \
         ::gem5::trace::getDebugLogger()->dump(           \
             ::gem5::curTick(), name(), data, count, #x); \
 } while (0)
 
 #define DPRINTF(x, ...) do {                     \
-    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {   \
+    if (GEM5_UNLIKELY(GEM5_DEBUG_TRACING(x))) {  \
         ::gem5::trace::getDebugLogger()->dprintf_flag(   \
             ::gem5::curTick(), name(), #x, __VA_ARGS__); \
     }                                            \
 } while (0)
 
 #define DPRINTFS(x, s, ...) do {                        \
-    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {          \
+    if (GEM5_UNLIKELY(GEM5_DEBUG_TRACING(x))) {         \
         ::gem5::trace::getDebugLogger()->dprintf_flag(          \
                 ::gem5::curTick(), (s)->name(), #x, __VA_ARGS__); \
     }                                                   \
 } while (0)
 
 #define DPRINTFR(x, ...) do {                          \
-    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {         \
+    if (GEM5_UNLIKELY(GEM5_DEBUG_TRACING(x))) {        \
         ::gem5::trace::getDebugLogger()->dprintf_flag(         \
             (::gem5::Tick)-1, std::string(), #x, __VA_ARGS__); \
     }                                                  \
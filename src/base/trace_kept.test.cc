@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * The flags listed in TRACING_FAST_FLAGS keep their DPRINTFs in the builds
+ * without TRACING_ON. Build this file as such a build would, whatever the
+ * variant the test is built for.
+ */
+#undef TRACING_ON
+#define TRACING_ON 0
+#undef TRACING_ALL_FLAGS
+#define TRACING_ALL_FLAGS 0
+#undef TRACING_KEPT_FLAGS
+#define TRACING_KEPT_FLAGS 1
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/trace.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace gem5
+{
+namespace debug
+{
+/** Debug flag kept by the build. */
+SimpleFlag TraceKeptFlag("TraceKeptFlag",
+    "Debug flag kept in builds without TRACING_ON", false, true);
+/** Debug flag compiled out by the build. */
+SimpleFlag TraceDroppedFlag("TraceDroppedFlag",
+    "Debug flag compiled out in builds without TRACING_ON");
+namespace compiled
+{
+inline constexpr bool TraceKeptFlag = true;
+inline constexpr bool TraceDroppedFlag = false;
+} // namespace compiled
+} // namespace debug
+} // namespace gem5
+
+/** Test that the DPRINTFs on a kept flag print. */
+TEST(TraceKeptTest, KeptFlagPrints)
+{
+    std::stringstream ss;
+    trace::OstreamLogger logger(ss);
+    trace::setDebugLogger(&logger);
+    StringWrap name("Foo");
+
+    trace::enable();
+    EXPECT_TRUE(debug::changeFlag("TraceKeptFlag", true));
+    EXPECT_TRUE(debug::TraceKeptFlag.tracing());
+    DPRINTF(TraceKeptFlag, "Test message");
+    ASSERT_EQ(ss.str(), "      0: Foo: Test message");
+
+    // The flag still obeys its run time switch
+    ss.str("");
+    EXPECT_TRUE(debug::changeFlag("TraceKeptFlag", false));
+    DPRINTF(TraceKeptFlag, "Test message");
+    ASSERT_EQ(ss.str(), "");
+    trace::disable();
+}
+
+/** Test that the DPRINTFs on the other flags are compiled out. */
+TEST(TraceKeptTest, DroppedFlagDoesNotPrint)
+{
+    std::stringstream ss;
+    trace::OstreamLogger logger(ss);
+    trace::setDebugLogger(&logger);
+    StringWrap name("Foo");
+
+    trace::enable();
+    EXPECT_TRUE(debug::changeFlag("TraceDroppedFlag", true));
+    DPRINTF(TraceDroppedFlag, "Test message");
+    ASSERT_EQ(ss.str(), "");
+
+    EXPECT_TRUE(debug::changeFlag("TraceDroppedFlag", false));
+    trace::disable();
+}
@@ -0,0 +1,55 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.InstTracer import InstTracer
+from m5.params import *
+
+
+class InstBinTrace(InstTracer):
+    type = "InstBinTrace"
+    cxx_class = "gem5::trace::InstBinTrace"
+    cxx_header = "cpu/inst_bin_trace.hh"
+
+    file_name = Param.String(
+        "", "Trace output file, in the output directory "
+        "[Default: <name>.itrace]"
+    )
+    pc_ranges = VectorParam.AddrRange(
+        [], "Only trace instructions with a PC in these ranges [Default: all]"
+    )
+    skip_insts = Param.UInt64(0, "Number of instructions to skip")
+    max_insts = Param.UInt64(
+        0, "Number of instructions to trace after skipping, 0 for no limit"
+    )
+    block_size = Param.Unsigned(
+        65536, "Number of instructions compressed together"
+    )
+    max_pending = Param.Unsigned(
+        4, "Number of blocks queued for the writer thread before stalling"
+    )
+    compression_level = Param.Int(
+        1, "zlib compression level of the blocks, 0 to disable"
+    )
@@ -29,10 +29,15 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
-#include <unordered_map>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/intmath.hh"
+#include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -41,9 +46,121 @@ namespace gem5
 namespace decode_cache
 {
 
-/// Hash for decoded instructions.
-template <typename EMI>
-using InstMap = std::unordered_map<EMI, StaticInstPtr>;
+/// Hash for decoded instructions. An open addressing table indexed by a
+/// hash of the machine instruction. It grows until it holds MaxEntries
+/// instructions; past that it is flushed by bumping a generation number
+/// instead of growing without bound.
+template <typename EMI, typename Value = StaticInstPtr>
+class InstMap
+{
+  protected:
+    static constexpr size_t InitialEntries = 1 << 12;
+    static constexpr size_t MaxEntries = 1 << 20;
+    /// Longest run of slots searched for an instruction.
+    static constexpr unsigned MaxProbes = 16;
+
+    struct Entry
+    {
+        EMI machInst{};
+        Value value{};
+        /// The entry is valid if it matches the generation of the map.
+        uint32_t generation = 0;
+    };
+
+    std::vector<Entry> entries;
+    size_t mask;
+    unsigned indexShift;
+    uint32_t generation = 1;
+    size_t used = 0;
+
+    size_t
+    index(const EMI &emi) const
+    {
+        // ISAs often hash their instructions to the identity, so mix the
+        // bits before using the top ones as an index.
+        const uint64_t hash = std::hash<EMI>()(emi);
+        return (hash * 0x9e3779b97f4a7c15ULL) >> indexShift;
+    }
+
+    void
+    resize(size_t size)
+    {
+        std::vector<Entry> old;
+        old.swap(entries);
+        entries.resize(size);
+        mask = size - 1;
+        indexShift = 64 - floorLog2(size);
+        used = 0;
+
+        for (auto &entry : old) {
+            if (entry.generation == generation)
+                insert(entry.machInst) = std::move(entry.value);
+        }
+    }
+
+    /// Find the slot for a new instruction, making room if needed.
+    Value &
+    insert(const EMI &emi)
+    {
+        while (true) {
+            if ((used + 1) * 4 <= entries.size() * 3) {
+                size_t idx = index(emi);
+                for (unsigned probe = 0; probe < MaxProbes; probe++) {
+                    Entry &entry = entries[idx];
+                    if (entry.generation != generation) {
+                        entry.machInst = emi;
+                        entry.value = Value();
+                        entry.generation = generation;
+                        used++;
+                        return entry.value;
+                    }
+                    idx = (idx + 1) & mask;
+                }
+            }
+
+            if (entries.size() < MaxEntries)
+                resize(entries.size() * 2);
+            else
+                invalidate();
+        }
+    }
+
+  public:
+    InstMap() { resize(InitialEntries); }
+
+    /// Find the decoded instruction for a machine instruction.
+    /// @retval A reference to the decoded instruction, which is null if
+    /// it has to be decoded and filled in by the caller. The reference is
+    /// valid until the next lookup.
+    Value &
+    lookup(const EMI &emi)
+    {
+        size_t idx = index(emi);
+        for (unsigned probe = 0; probe < MaxProbes; probe++) {
+            Entry &entry = entries[idx];
+            if (entry.generation != generation)
+                break;
+            if (entry.machInst == emi)
+                return entry.value;
+            idx = (idx + 1) & mask;
+        }
+        return insert(emi);
+    }
+
+    /// Forget all instructions in constant time.
+    void
+    invalidate()
+    {
+        if (GEM5_UNLIKELY(++generation == 0)) {
+            for (auto &entry : entries)
+                entry.generation = 0;
+            generation = 1;
+        }
+        used = 0;
+    }
+
+    size_t size() const { return used; }
+};
 
 /// A sparse map from an Addr to a Value, stored in page chunks.
 template<class Value, Addr CacheChunkShift = 12>
@@ -69,63 +186,102 @@ class AddrMap
     {
         Value items[CacheChunkBytes];
     };
-    // A map of cache chunks which allows a sparse mapping.
-    typedef typename std::unordered_map<Addr, CacheChunk *> ChunkMap;
-    typedef typename ChunkMap::iterator ChunkIt;
-    // Mini cache of recent lookups.
-    ChunkIt recent[2];
-    ChunkMap chunkMap;
-
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
+
+    // Chunks are found through a radix tree of directories, like a page
+    // table. Each level resolves LevelBits of the chunk number.
+    static constexpr unsigned LevelBits = 9;
+    static constexpr unsigned Levels =
+        divCeil(64 - CacheChunkShift, LevelBits);
+
+    struct Directory
+    {
+        // Directories below the last level point to other directories,
+        // the ones at the last level to chunks.
+        std::array<void *, 1 << LevelBits> children{};
+    };
+    Directory root;
+
+    // Direct mapped cache of recent lookups, checked before walking the
+    // directories, and the most recent lookup which catches straight line
+    // code.
+    static constexpr unsigned NumRecent = 256;
+    struct Recent
+    {
+        // Chunk starts are aligned, so this never matches.
+        Addr chunkAddr = CacheChunkBytes - 1;
+        CacheChunk *chunk = nullptr;
+    };
+    std::array<Recent, NumRecent> recent;
+    Recent last;
+
+    static unsigned
+    levelIndex(Addr chunk_num, unsigned level)
+    {
+        return bits(chunk_num, (level + 1) * LevelBits - 1,
+                    level * LevelBits);
+    }
+
+    /// Find the chunk for an address in the directories, creating it and
+    /// the directories leading to it if needed.
+    CacheChunk *
+    walk(Addr chunk_addr)
+    {
+        const Addr chunk_num = chunk_addr >> CacheChunkShift;
+        Directory *dir = &root;
+        for (unsigned level = Levels - 1; level > 0; level--) {
+            void *&child = dir->children[levelIndex(chunk_num, level)];
+            if (!child)
+                child = new Directory;
+            dir = static_cast<Directory *>(child);
+        }
+
+        void *&child = dir->children[levelIndex(chunk_num, 0)];
+        if (!child)
+            child = new CacheChunk;
+        return static_cast<CacheChunk *>(child);
+    }
+
     void
-    update(ChunkIt recentest)
+    destroy(Directory *dir, unsigned level)
     {
-        recent[1] = recent[0];
-        recent[0] = recentest;
+        for (void *child : dir->children) {
+            if (!child)
+                continue;
+            if (level > 0) {
+                destroy(static_cast<Directory *>(child), level - 1);
+                delete static_cast<Directory *>(child);
+            } else {
+                delete static_cast<CacheChunk *>(child);
+            }
+        }
     }
 
     /// Attempt to find the CacheChunk which goes with a particular
-    /// address. First check the small cache of recent results, then
-    /// actually look in the hash map.
+    /// address. First check the most recent result and the cache of recent
+    /// results, then walk the directories.
     /// @param addr The address to look up.
     CacheChunk *
     getChunk(Addr addr)
     {
-        Addr chunk_addr = chunkStart(addr);
-
-        // Check against recent lookups.
-        if (recent[0] != chunkMap.end()) {
-            if (recent[0]->first == chunk_addr)
-                return recent[0]->second;
-            if (recent[1] != chunkMap.end() &&
-                    recent[1]->first == chunk_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
-
-        // Actually look in the hash_map.
-        ChunkIt it = chunkMap.find(chunk_addr);
-        if (it != chunkMap.end()) {
-            update(it);
-            return it->second;
+        const Addr chunk_addr = chunkStart(addr);
+        if (GEM5_LIKELY(last.chunkAddr == chunk_addr))
+            return last.chunk;
+        Recent &entry =
+            recent[(chunk_addr >> CacheChunkShift) & (NumRecent - 1)];
+        if (GEM5_UNLIKELY(entry.chunkAddr != chunk_addr)) {
+            entry.chunk = walk(chunk_addr);
+            entry.chunkAddr = chunk_addr;
         }
-
-        // Didn't find an existing chunk, so add a new one.
-        CacheChunk *newChunk = new CacheChunk;
-        typename ChunkMap::value_type to_insert(chunk_addr, newChunk);
-        update(chunkMap.insert(to_insert).first);
-        return newChunk;
+        last = entry;
+        return entry.chunk;
     }
 
   public:
-    /// Constructor
-    AddrMap()
-    {
-        recent[0] = recent[1] = chunkMap.end();
-    }
+    AddrMap() = default;
+    AddrMap(const AddrMap &) = delete;
+    AddrMap &operator=(const AddrMap &) = delete;
+
+    ~AddrMap() { destroy(&root, Levels - 1); }
 
     Value &
     lookup(Addr addr)
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/inst_bin_trace.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "arch/generic/isa.hh"
+#include "base/output.hh"
+#include "cpu/static_inst.hh"
+#include "cpu/thread_context.hh"
+#include "debug/ExecEnable.hh"
+#include "debug/ExecMicro.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+namespace trace {
+
+namespace
+{
+
+template <typename T>
+void
+append(AsyncWriter::Block &out, T value)
+{
+    // The trace is little endian, like the hosts gem5 runs on.
+    const size_t pos = out.size();
+    out.resize(pos + sizeof(T));
+    std::memcpy(out.data() + pos, &value, sizeof(T));
+}
+
+} // anonymous namespace
+
+void
+InstBinTraceRecord::dump()
+{
+    tracer.record(*this);
+}
+
+InstBinTrace::InstBinTrace(const InstBinTraceParams &p)
+    : InstTracer(p), pcRanges(p.pc_ranges), skipInsts(p.skip_insts),
+      maxInsts(p.max_insts), blockSize(std::max<size_t>(p.block_size, 1))
+{
+    const std::string file_name = p.file_name.empty() ?
+        name() + ".itrace" : p.file_name;
+    writer.reset(new AsyncWriter(simout.resolve(file_name), p.max_pending,
+                                 p.compression_level));
+
+    AsyncWriter::Block header(Magic, Magic + sizeof(Magic));
+    append<uint32_t>(header, Version);
+    append<uint64_t>(header, sim_clock::Frequency);
+    writer->write(std::move(header));
+
+    block.reserve(blockSize);
+
+    registerExitCallback([this]() { close(); });
+}
+
+InstBinTrace::~InstBinTrace()
+{
+    close();
+}
+
+InstBinTraceRecord *
+InstBinTrace::getInstRecord(Tick when, ThreadContext *tc,
+                            const StaticInstPtr si, const PCStateBase &pc,
+                            const StaticInstPtr mi)
+{
+    // Only record the trace if Exec debugging is enabled
+    if (!debug::ExecEnable || !tracing())
+        return nullptr;
+
+    if (!pcRanges.empty()) {
+        const Addr addr = pc.instAddr();
+        auto in_range = [addr](const AddrRange &r) {
+            return r.contains(addr);
+        };
+        if (std::none_of(pcRanges.begin(), pcRanges.end(), in_range))
+            return nullptr;
+    }
+
+    return new InstBinTraceRecord(*this, when, tc, si, pc, mi);
+}
+
+void
+InstBinTrace::record(InstBinTraceRecord &rec)
+{
+    if (!tracing())
+        return;
+
+    const StaticInstPtr &si = rec.staticInst;
+    const bool micro = debug::ExecMicro && si->isMicroop();
+
+    // Without ExecMicro, a macro-op is recorded when its last micro-op
+    // commits. Keep the memory access of the earlier micro-ops so that it
+    // is not lost.
+    if (!micro && si->isMicroop() && !si->isLastMicroop()) {
+        if (rec.mem_valid) {
+            pendingMem[rec.thread] = {rec.addr,
+                                      static_cast<uint32_t>(rec.size), true};
+        }
+        return;
+    }
+
+    // Skipped instructions still count against the limit, so the trace
+    // always covers the same dynamic instruction window.
+    if (!si->isMicroop() || si->isLastMicroop())
+        seen++;
+    if (seen <= skipInsts)
+        return;
+
+    Entry &e = block.emplace_back();
+    e.when = rec.when;
+    e.pc = rec.pc->instAddr();
+    e.microPC = micro ? rec.pc->microPC() : 0;
+    e.cpuId = rec.thread->cpuId();
+    e.flags = 0;
+
+    const StaticInstPtr &bytes_inst =
+        !micro && rec.macroStaticInst ? rec.macroStaticInst : si;
+    e.instSize = std::min(bytes_inst->asBytes(e.inst, sizeof(e.inst)),
+                          sizeof(e.inst));
+
+    if (rec.mem_valid) {
+        e.flags |= MemValid;
+        e.memAddr = rec.addr;
+        e.memSize = rec.size;
+    } else if (!micro && si->isMicroop()) {
+        auto it = pendingMem.find(rec.thread);
+        if (it != pendingMem.end() && it->second.valid) {
+            e.flags |= MemValid;
+            e.memAddr = it->second.addr;
+            e.memSize = it->second.size;
+        }
+    }
+    if (!micro && si->isMicroop())
+        pendingMem.erase(rec.thread);
+
+    switch (rec.dataStatus) {
+      case InstRecord::DataInvalid:
+        break;
+      case InstRecord::DataDouble:
+        e.flags |= DataValid | DataFloat;
+        std::memcpy(&e.data, &rec.data.asDouble, sizeof(e.data));
+        break;
+      case InstRecord::DataReg:
+        e.flags |= DataValid;
+        if (rec.data.asReg.isBlob()) {
+            // Only the low 8 bytes of vector registers are kept.
+            const size_t bytes = std::min<size_t>(
+                    rec.data.asReg.regClass().regBytes(), sizeof(e.data));
+            e.data = 0;
+            std::memcpy(&e.data, rec.data.asReg.asBlob(), bytes);
+            e.flags |= DataWide;
+        } else {
+            e.data = rec.data.asReg.asRegVal();
+        }
+        break;
+      default:
+        e.flags |= DataValid;
+        e.data = rec.data.asInt;
+        break;
+    }
+
+    if (micro)
+        e.flags |= Microop;
+    if (!rec.predicate)
+        e.flags |= PredicatedFalse;
+    if (rec.faulting)
+        e.flags |= Faulting;
+    if (rec.thread->getIsaPtr()->inUserMode())
+        e.flags |= UserMode;
+
+    if (block.size() >= blockSize)
+        writeBlock();
+}
+
+void
+InstBinTrace::writeBlock()
+{
+    if (block.empty())
+        return;
+
+    // Store the block column by column. Similar values end up next to each
+    // other, which compresses far better than whole records would.
+    AsyncWriter::Block out;
+    out.reserve(block.size() * sizeof(Entry));
+
+    append<uint32_t>(out, block.size());
+
+    Tick last_tick = 0;
+    for (const auto &e : block) {
+        append<uint64_t>(out, e.when - last_tick);
+        last_tick = e.when;
+    }
+    Addr last_pc = 0;
+    for (const auto &e : block) {
+        append<uint64_t>(out, e.pc - last_pc);
+        last_pc = e.pc;
+    }
+    for (const auto &e : block)
+        append<uint16_t>(out, e.microPC);
+    for (const auto &e : block)
+        append<uint16_t>(out, e.cpuId);
+    for (const auto &e : block)
+        append<uint8_t>(out, e.flags);
+    for (const auto &e : block)
+        append<uint8_t>(out, e.instSize);
+    for (const auto &e : block)
+        out.insert(out.end(), e.inst, e.inst + e.instSize);
+    for (const auto &e : block) {
+        if (e.flags & MemValid)
+            append<uint64_t>(out, e.memAddr);
+    }
+    for (const auto &e : block) {
+        if (e.flags & MemValid)
+            append<uint32_t>(out, e.memSize);
+    }
+    for (const auto &e : block) {
+        if (e.flags & DataValid)
+            append<uint64_t>(out, e.data);
+    }
+
+    block.clear();
+    writer->write(std::move(out));
+}
+
+void
+InstBinTrace::close()
+{
+    if (!writer)
+        return;
+
+    writeBlock();
+    writer->close();
+    if (writer->stalls()) {
+        warn("%s: Tracing stalled %d times waiting for the trace writer.",
+             name(), writer->stalls());
+    }
+    writer.reset();
+}
+
+} // namespace trace
+} // namespace gem5
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_INST_BIN_TRACE_HH__
+#define __CPU_INST_BIN_TRACE_HH__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/generic/pcstate.hh"
+#include "base/addr_range.hh"
+#include "base/async_writer.hh"
+#include "base/types.hh"
+#include "cpu/static_inst_fwd.hh"
+#include "params/InstBinTrace.hh"
+#include "sim/insttracer.hh"
+
+namespace gem5
+{
+
+class ThreadContext;
+
+namespace trace {
+
+class InstBinTrace;
+
+class InstBinTraceRecord : public InstRecord
+{
+  public:
+    InstBinTraceRecord(InstBinTrace &_tracer, Tick when, ThreadContext *tc,
+                       const StaticInstPtr si, const PCStateBase &pc,
+                       const StaticInstPtr mi=nullptr)
+        : InstRecord(when, tc, si, pc, mi), tracer(_tracer)
+    {}
+
+    void dump() override;
+
+  protected:
+    InstBinTrace &tracer;
+
+    friend class InstBinTrace;
+};
+
+/**
+ * An instruction tracer that writes committed instructions to a compact
+ * binary file instead of formatting them as text. Each record holds the
+ * tick, PC, micro-op index, instruction bytes, the memory access and the
+ * last value the instruction wrote. Records are gathered in blocks which
+ * are stored column by column, with ticks and PCs delta encoded, and are
+ * compressed and written by a background thread.
+ *
+ * Like the other tracers, nothing is recorded unless the ExecEnable debug
+ * flag is set, so --debug-start can be used to trace a region of
+ * interest. Micro-ops are recorded individually if ExecMicro is set,
+ * otherwise one record is written per macro-op. The trace is decoded by
+ * util/decode_binary_inst_trace.py.
+ */
+class InstBinTrace : public InstTracer
+{
+  public:
+    /** Magic number and version in the header block of the file. */
+    static constexpr char Magic[8] = {'g', 'e', 'm', '5', 'i', 't', 'r', 0};
+    static constexpr uint32_t Version = 1;
+
+    /** Bits of the per record flags column. */
+    enum RecordFlags : uint8_t
+    {
+        MemValid = 0x01,
+        DataValid = 0x02,
+        /** The data column holds the first 8 bytes of a wider value. */
+        DataWide = 0x04,
+        DataFloat = 0x08,
+        Microop = 0x10,
+        PredicatedFalse = 0x20,
+        Faulting = 0x40,
+        UserMode = 0x80,
+    };
+
+    InstBinTrace(const InstBinTraceParams &p);
+    ~InstBinTrace();
+
+    InstBinTraceRecord *getInstRecord(Tick when, ThreadContext *tc,
+                                      const StaticInstPtr si,
+                                      const PCStateBase &pc,
+                                      const StaticInstPtr mi=nullptr)
+        override;
+
+  protected:
+    /** A record as kept until its block is written out. */
+    struct Entry
+    {
+        Tick when;
+        Addr pc;
+        Addr memAddr;
+        uint64_t data;
+        uint32_t memSize;
+        uint16_t microPC;
+        uint16_t cpuId;
+        uint8_t flags;
+        uint8_t instSize;
+        uint8_t inst[16];
+    };
+
+    const std::vector<AddrRange> pcRanges;
+    const uint64_t skipInsts;
+    const uint64_t maxInsts;
+    const size_t blockSize;
+
+    /** Number of instructions that passed the PC filter so far. */
+    uint64_t seen = 0;
+
+    std::vector<Entry> block;
+    std::unique_ptr<AsyncWriter> writer;
+
+    /** Memory access of an earlier micro-op of the current macro-op,
+     *  reported with the macro-op when micro-ops are not traced. */
+    struct PendingMem
+    {
+        Addr addr = 0;
+        uint32_t size = 0;
+        bool valid = false;
+    };
+    std::unordered_map<ThreadContext *, PendingMem> pendingMem;
+
+    bool
+    tracing() const
+    {
+        return writer && (!maxInsts || seen < skipInsts + maxInsts);
+    }
+
+    void record(InstBinTraceRecord &rec);
+
+    /** Convert the current block to columns and queue it for writing. */
+    void writeBlock();
+
+    void close();
+
+    friend class InstBinTraceRecord;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __CPU_INST_BIN_TRACE_HH__
@@ -111,6 +111,8 @@ class LSQ : public Named
 
         bool isSnooping() const override { return true; }
 
+        bool isCaching() const override { return false; }
+
         void recvTimingSnoopReq(PacketPtr pkt) override
         { return lsq.recvTimingSnoopReq(pkt); }
 
@@ -116,6 +116,14 @@ class LSQ
          * @return true since we have to snoop
          */
         virtual bool isSnooping() const { return true; }
+
+        /**
+         * The load store queue only watches the snoops, it holds no data
+         * which memory could be stale with respect to.
+         *
+         * @return false since we do not cache
+         */
+        virtual bool isCaching() const { return false; }
     };
 
     /** Memory operation metadata.
@@ -44,6 +44,10 @@ class BaseNonCachingSimpleCPU(BaseAtomicSimpleCPU):
     is as a substitute for hardware virtualized CPUs when
     stress-testing the memory system.
 
+    Instruction fetches and plain data reads are done through memory
+    backdoors when the memory provides them, so threads running on
+    separate event queues rarely need to cross to the memory's queue.
+
     """
 
     type = "BaseNonCachingSimpleCPU"
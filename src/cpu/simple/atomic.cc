@@ -41,6 +41,8 @@
 
 #include "cpu/simple/atomic.hh"
 
+#include <atomic>
+
 #include "arch/generic/decoder.hh"
 #include "base/output.hh"
 #include "cpu/exetrace.hh"
@@ -52,6 +54,7 @@
 #include "mem/packet_access.hh"
 #include "mem/physical.hh"
 #include "params/BaseAtomicSimpleCPU.hh"
+#include "sim/eventq.hh"
 #include "sim/faults.hh"
 #include "sim/full_system.hh"
 #include "sim/system.hh"
@@ -59,6 +62,16 @@
 namespace gem5
 {
 
+namespace
+{
+
+// Line locks shared by all the CPUs, indexed by a hash of the line
+// address. Aliasing lines only cause spurious waits.
+constexpr size_t NumLineLocks = 4096;
+std::atomic<bool> lineLocks[NumLineLocks];
+
+} // anonymous namespace
+
 void
 AtomicSimpleCPU::init()
 {
@@ -268,6 +281,28 @@ AtomicSimpleCPU::suspendContext(ThreadID thread_num)
     BaseCPU::suspendContext(thread_num);
 }
 
+void
+AtomicSimpleCPU::lockLine(Addr paddr)
+{
+    const size_t idx = (paddr / cacheLineSize()) % NumLineLocks;
+    for (size_t held : heldLineLocks) {
+        if (held == idx)
+            return;
+    }
+    while (lineLocks[idx].exchange(true, std::memory_order_acquire)) {
+        while (lineLocks[idx].load(std::memory_order_relaxed));
+    }
+    heldLineLocks.push_back(idx);
+}
+
+void
+AtomicSimpleCPU::unlockLines()
+{
+    for (size_t idx : heldLineLocks)
+        lineLocks[idx].store(false, std::memory_order_release);
+    heldLineLocks.clear();
+}
+
 Tick
 AtomicSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
 {
@@ -398,6 +433,9 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
             if (req->isLocalAccess()) {
                 dcache_latency += req->localAccessor(thread->getTC(), &pkt);
             } else {
+                if (inParallelMode && req->isLockedRMW())
+                    lockLine(req->getPaddr());
+                notifyPktReq(&pkt);
                 dcache_latency += sendPacket(dcachePort, &pkt);
             }
             dcache_access = true;
@@ -406,13 +444,22 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
                     pkt.getAddrRange().to_string(), pkt.print());
 
             if (req->isLLSC()) {
+                // The stores of the CPUs on other event queues are not
+                // snooped, so they don't clear the reservation.
+                warn_if_once(inParallelMode, "%s: Load-linked/store-"
+                        "conditional pairs are not atomic with respect to "
+                        "the CPUs running on other event queues.", name());
                 thread->getIsaPtr()->handleLockedRead(req);
             }
         }
 
         //If there's a fault, return it
-        if (fault != NoFault)
+        if (fault != NoFault) {
+            // Don't keep the line of a locked access which failed half way.
+            if (!locked)
+                unlockLines();
             return req->isPrefetch() ? NoFault : fault;
+        }
 
         // If we don't need to access further cache lines, stop now.
         if (size_left == 0) {
@@ -452,6 +499,21 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
     // use the CPU's statically allocated write request and packet objects
     const RequestPtr &req = data_write_req;
 
+    // The write of a locked RMW ends the sequence its read started, so
+    // drop the line locks however the write finishes, faults included.
+    struct RMWUnlocker
+    {
+        AtomicSimpleCPU *cpu;
+        bool active;
+        ~RMWUnlocker()
+        {
+            if (active) {
+                cpu->locked = false;
+                cpu->unlockLines();
+            }
+        }
+    } rmw_unlocker{this, flags.isSet(Request::LOCKED_RMW)};
+
     if (traceData)
         traceData->setMem(addr, size, flags);
 
@@ -499,7 +561,12 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                     dcache_latency +=
                         req->localAccessor(thread->getTC(), &pkt);
                 } else {
+                    if (inParallelMode)
+                        lockLine(req->getPaddr());
+                    notifyPktReq(&pkt);
                     dcache_latency += sendPacket(dcachePort, &pkt);
+                    if (!locked)
+                        unlockLines();
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
@@ -521,10 +588,8 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
         //If there's a fault or we don't need to access a second cache line,
         //stop now.
         if (fault != NoFault || size_left == 0) {
-            if (req->isLockedRMW() && fault == NoFault) {
+            if (req->isLockedRMW() && fault == NoFault)
                 assert(!req->isMasked());
-                locked = false;
-            }
 
             //Supress faults from prefetches.
             return req->isPrefetch() ? NoFault : fault;
@@ -589,7 +654,12 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
         if (req->isLocalAccess()) {
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
+            if (inParallelMode)
+                lockLine(req->getPaddr());
+            notifyPktReq(&pkt);
             dcache_latency += sendPacket(dcachePort, &pkt);
+            if (!locked)
+                unlockLines();
         }
 
         dcache_access = true;
@@ -749,6 +819,7 @@ AtomicSimpleCPU::fetchInstMem()
     // directly into the CPU object's inst field.
     pkt.dataStatic(decoder->moreBytesPtr());
 
+    notifyPktReq(&pkt);
     Tick latency = sendPacket(icachePort, &pkt);
     panic_if(pkt.isError(), "Instruction fetch (%s) failed: %s",
             pkt.getAddrRange().to_string(), pkt.print());
@@ -763,6 +834,7 @@ AtomicSimpleCPU::regProbePoints()
 
     ppCommit = new ProbePointArg<std::pair<SimpleThread*, const StaticInstPtr>>
                                 (getProbeManager(), "Commit");
+    ppPktReq.reset(new probing::Packet(getProbeManager(), "PktRequest"));
 }
 
 void
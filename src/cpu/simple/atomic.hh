@@ -41,10 +41,13 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <vector>
+
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
 #include "params/BaseAtomicSimpleCPU.hh"
+#include "sim/probe/mem.hh"
 #include "sim/probe/probe.hh"
 
 namespace gem5
@@ -64,6 +67,19 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
     const int width;
     bool locked;
+
+    /**
+     * Line locks held by this CPU. When event queues run in parallel,
+     * CPUs writing to the same line take the same lock, and a locked
+     * read-modify-write keeps it until its write has been done, so that
+     * the pair is atomic with respect to the other CPUs.
+     */
+    std::vector<size_t> heldLineLocks;
+
+    /** Take the lock of the line containing paddr, if not already held. */
+    void lockLine(Addr paddr);
+    /** Release all the line locks held. */
+    void unlockLines();
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
@@ -149,6 +165,8 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
         bool isSnooping() const { return true; }
 
+        bool isCaching() const { return false; }
+
         Addr cacheBlockMask;
       protected:
         BaseSimpleCPU *cpu;
@@ -173,6 +191,16 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     /** Probe Points. */
     ProbePointArg<std::pair<SimpleThread *, const StaticInstPtr>> *ppCommit;
 
+    /** Every memory access of the CPU, whether or not it takes a port. */
+    probing::PacketUPtr ppPktReq;
+
+    void
+    notifyPktReq(const PacketPtr &pkt)
+    {
+        if (ppPktReq->hasListeners())
+            ppPktReq->notify(probing::PacketInfo(pkt));
+    }
+
   protected:
 
     /** Return a reference to the data port. */
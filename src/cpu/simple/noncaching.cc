@@ -40,6 +40,8 @@
 #include <cassert>
 
 #include "arch/generic/decoder.hh"
+#include "mem/packet.hh"
+#include "sim/eventq.hh"
 
 namespace gem5
 {
@@ -65,6 +67,24 @@ NonCachingSimpleCPU::verifyMemoryMode() const
 Tick
 NonCachingSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
 {
+    // With parallel event queues, plain reads are served straight from a
+    // backdoor so that they don't cross threads. Everything else, and
+    // every access otherwise, goes through the memory system, so that
+    // writes are still seen by snoopers, side effects happen where they
+    // are modelled and latencies are unchanged.
+    if (inParallelMode && pkt->cmd == MemCmd::ReadReq &&
+            !pkt->req->isUncacheable() &&
+            !pkt->req->isStrictlyOrdered() && !pkt->req->isMasked()) {
+        auto bd_it = memBackdoors.contains(pkt->getAddrRange());
+        if (bd_it != memBackdoors.end() && bd_it->second->readable()) {
+            auto *bd = bd_it->second;
+            Addr offset = pkt->getAddr() - bd->range().start();
+            pkt->setData(bd->ptr() + offset);
+            pkt->makeResponse();
+            return 0;
+        }
+    }
+
     MemBackdoorPtr bd = nullptr;
     Tick latency = port.sendAtomicBackdoor(pkt, bd);
 
@@ -94,6 +114,11 @@ NonCachingSimpleCPU::fetchInstMem()
     if (bd_it == memBackdoors.end())
         return AtomicSimpleCPU::fetchInstMem();
 
+    if (ppPktReq->hasListeners()) {
+        Packet pkt(ifetch_req, MemCmd::ReadReq);
+        notifyPktReq(&pkt);
+    }
+
     auto &decoder = threadInfo[curThread]->thread->decoder;
 
     auto *bd = bd_it->second;
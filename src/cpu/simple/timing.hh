@@ -241,6 +241,10 @@ class TimingSimpleCPU : public BaseSimpleCPU
             return true;
         }
 
+        virtual bool isCaching() const {
+            return false;
+        }
+
         struct DTickEvent : public TickEvent
         {
             DTickEvent(TimingSimpleCPU *_cpu)
@@ -0,0 +1,57 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+from m5.objects.ClockedObject import ClockedObject
+from m5.params import *
+from m5.proxy import *
+
+
+class BinTraceReplayer(ClockedObject):
+    type = "BinTraceReplayer"
+    cxx_header = "cpu/testers/bin_trace_replay/bin_trace_replayer.hh"
+    cxx_class = "gem5::BinTraceReplayer"
+
+    trace_file = Param.String("Packet trace written by MemBinTraceProbe")
+
+    # Replaying with the recorded inter-arrival times keeps the pressure
+    # on the memory system, and thus the timeliness of prefetches, close
+    # to that of the original run. Otherwise a request is sent each cycle.
+    replay_timing = Param.Bool(True, "Issue requests at the recorded ticks")
+    max_outstanding = Param.Unsigned(
+        16, "Maximum number of requests awaiting a response"
+    )
+    max_packets = Param.Counter(
+        0, "Number of requests to replay before exiting, 0 for all"
+    )
+    requestors = VectorParam.String(
+        [],
+        "Only replay requests from requestors whose name contains one of "
+        "these strings, all requestors if empty",
+    )
+
+    port = RequestPort("Port to the memory system")
+    system = Param.System(Parent.any, "System this replayer is part of")
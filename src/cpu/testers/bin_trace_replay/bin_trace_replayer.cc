@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/bin_trace_replay/bin_trace_replayer.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/BinTraceReplayer.hh"
+#include "sim/core.hh"
+#include "sim/sim_exit.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Cursor over the header block of a trace. */
+class HeaderParser
+{
+  private:
+    const AsyncWriter::Block &block;
+    const std::string &file;
+    size_t pos = 0;
+
+  public:
+    HeaderParser(const AsyncWriter::Block &_block, const std::string &_file)
+        : block(_block), file(_file)
+    { }
+
+    void
+    read(void *out, size_t size)
+    {
+        fatal_if(pos + size > block.size(),
+                 "Truncated header in packet trace %s.", file);
+        std::memcpy(out, block.data() + pos, size);
+        pos += size;
+    }
+
+    template <typename T>
+    T
+    get()
+    {
+        T value;
+        read(&value, sizeof(value));
+        return value;
+    }
+
+    std::string
+    getString()
+    {
+        std::string str(get<uint32_t>(), '\0');
+        read(str.data(), str.size());
+        return str;
+    }
+};
+
+} // anonymous namespace
+
+bool
+BinTraceReplayer::ReplayPort::recvTimingResp(PacketPtr pkt)
+{
+    replayer.completeRequest(pkt);
+    return true;
+}
+
+void
+BinTraceReplayer::ReplayPort::recvReqRetry()
+{
+    replayer.recvRetry();
+}
+
+BinTraceReplayer::BinTraceReplayer(const Params &p)
+    : ClockedObject(p),
+      port(name() + ".port", *this),
+      system(p.system),
+      traceFile(p.trace_file),
+      replayTiming(p.replay_timing),
+      maxOutstanding(std::max(p.max_outstanding, 1u)),
+      maxPackets(p.max_packets),
+      requestorFilter(p.requestors),
+      requestorId(p.system->getRequestorId(this)),
+      blockSize(p.system->cacheLineSize()),
+      reader(p.trace_file),
+      tickEvent([this]{ tick(); }, name()),
+      stats(this)
+{
+    fatal_if(!reader.isOpen(), "%s: %s.", name(), reader.error());
+}
+
+Port &
+BinTraceReplayer::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "port")
+        return port;
+    else
+        return ClockedObject::getPort(if_name, idx);
+}
+
+BinTraceReplayer::
+BinTraceReplayerStats::BinTraceReplayerStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(numReads, statistics::units::Count::get(),
+               "Number of read requests completed"),
+      ADD_STAT(numWrites, statistics::units::Count::get(),
+               "Number of write requests completed"),
+      ADD_STAT(numSkipped, statistics::units::Count::get(),
+               "Number of trace records not replayed"),
+      ADD_STAT(numRetries, statistics::units::Count::get(),
+               "Number of requests refused by the memory system"),
+      ADD_STAT(totalReadLatency, statistics::units::Tick::get(),
+               "Total latency of read requests, from their first send "
+               "attempt"),
+      ADD_STAT(avgReadLatency, statistics::units::Rate<
+                    statistics::units::Tick, statistics::units::Count>::get(),
+               "Avg latency of read requests", totalReadLatency / numReads)
+{
+}
+
+void
+BinTraceReplayer::startup()
+{
+    fatal_if(!system->isTimingMode(),
+             "%s: The trace can only be replayed in timing mode.", name());
+
+    readHeader();
+    replayStart = curTick();
+    advance();
+    scheduleTick();
+    checkDone();
+}
+
+void
+BinTraceReplayer::readHeader()
+{
+    AsyncWriter::Block header;
+    fatal_if(!reader.read(header), "%s: Cannot read the header of %s: %s.",
+             name(), traceFile, reader.error());
+
+    HeaderParser parser(header, traceFile);
+    char magic[sizeof(MemBinTraceProbe::Magic)];
+    parser.read(magic, sizeof(magic));
+    fatal_if(std::memcmp(magic, MemBinTraceProbe::Magic, sizeof(magic)),
+             "%s: %s is not a packet trace.", name(), traceFile);
+    const uint32_t version = parser.get<uint32_t>();
+    fatal_if(version != MemBinTraceProbe::Version,
+             "%s: Unsupported packet trace version %d.", name(), version);
+
+    const uint64_t frequency = parser.get<uint64_t>();
+    fatal_if(!frequency, "%s: Invalid tick frequency in %s.",
+             name(), traceFile);
+    tickScale = double(sim_clock::Frequency) / frequency;
+
+    const uint64_t sample_period = parser.get<uint64_t>();
+    const std::string probe = parser.getString();
+    if (sample_period > 1) {
+        warn("%s: %s only holds one in %d packets seen by %s.", name(),
+             traceFile, sample_period, probe);
+    }
+
+    replayRequestor.resize(parser.get<uint32_t>());
+    for (size_t i = 0; i < replayRequestor.size(); i++) {
+        const std::string requestor = parser.getString();
+        replayRequestor[i] = requestorFilter.empty() ||
+            std::any_of(requestorFilter.begin(), requestorFilter.end(),
+                        [&requestor](const std::string &pattern) {
+                            return requestor.find(pattern) !=
+                                std::string::npos;
+                        });
+        DPRINTF(BinTraceReplayer, "Requestor %d: %s%s\n", i, requestor,
+                replayRequestor[i] ? "" : " (skipped)");
+    }
+}
+
+bool
+BinTraceReplayer::readRecord(Record &rec)
+{
+    while (blockPos + sizeof(Record) > block.size()) {
+        blockPos = 0;
+        if (!reader.read(block)) {
+            fatal_if(!reader.error().empty(), "%s: Error reading %s: %s.",
+                     name(), traceFile, reader.error());
+            return false;
+        }
+    }
+
+    std::memcpy(&rec, block.data() + blockPos, sizeof(Record));
+    blockPos += sizeof(Record);
+    return true;
+}
+
+MemCmd
+BinTraceReplayer::replayCommand(const Record &rec) const
+{
+    if (rec.requestor < replayRequestor.size() ?
+            !replayRequestor[rec.requestor] : !requestorFilter.empty()) {
+        return MemCmd::InvalidCmd;
+    }
+    if (rec.cmd >= MemCmd::NUM_MEM_CMDS || !rec.size)
+        return MemCmd::InvalidCmd;
+
+    // Prefetches of the traced cache are what the evaluated prefetcher
+    // replaces, and clean evictions only update the snoop filters.
+    const MemCmd cmd(rec.cmd);
+    if (cmd.isPrefetch() ||
+            (cmd.isEviction() && cmd != MemCmd::WritebackDirty)) {
+        return MemCmd::InvalidCmd;
+    }
+    if (cmd.isWrite() || cmd.needsWritable())
+        return MemCmd::WriteReq;
+    if (cmd.isRead())
+        return MemCmd::ReadReq;
+    return MemCmd::InvalidCmd;
+}
+
+PacketPtr
+BinTraceReplayer::createPacket(const Record &rec, MemCmd cmd)
+{
+    const Addr offset = rec.addr & (blockSize - 1);
+    const unsigned size = std::min<Addr>(rec.size, blockSize - offset);
+
+    Request::FlagsType flags = rec.flags & Request::SECURE;
+    if (cmd == MemCmd::ReadReq)
+        flags |= rec.flags & Request::INST_FETCH;
+
+    RequestPtr req = std::make_shared<Request>(rec.addr, size, flags,
+                                               requestorId);
+    if (rec.pc)
+        req->setPC(rec.pc);
+
+    PacketPtr pkt = new Packet(req, cmd);
+    pkt->allocate();
+    return pkt;
+}
+
+void
+BinTraceReplayer::advance()
+{
+    haveNext = false;
+    if (maxPackets && sent >= maxPackets)
+        return;
+
+    while (readRecord(next)) {
+        nextCmd = replayCommand(next);
+        if (nextCmd == MemCmd::InvalidCmd) {
+            stats.numSkipped++;
+            continue;
+        }
+
+        if (traceStart == MaxTick)
+            traceStart = next.tick;
+        nextTick = replayTiming && next.tick > traceStart ?
+            replayStart + Tick((next.tick - traceStart) * tickScale) : 0;
+        haveNext = true;
+        return;
+    }
+}
+
+bool
+BinTraceReplayer::trySend(PacketPtr pkt)
+{
+    DPRINTF(BinTraceReplayer, "Sending %s\n", pkt->print());
+    if (!port.sendTimingReq(pkt)) {
+        retryPkt = pkt;
+        stats.numRetries++;
+        return false;
+    }
+
+    sent++;
+    outstanding++;
+    advance();
+    if (!replayTiming)
+        nextTick = clockEdge(Cycles(1));
+    return true;
+}
+
+void
+BinTraceReplayer::tick()
+{
+    assert(!retryPkt);
+    while (haveNext && outstanding < maxOutstanding &&
+            nextTick <= curTick()) {
+        if (!trySend(createPacket(next, nextCmd)))
+            return;
+    }
+    scheduleTick();
+}
+
+void
+BinTraceReplayer::scheduleTick()
+{
+    if (retryPkt || !haveNext || outstanding >= maxOutstanding ||
+            tickEvent.scheduled()) {
+        return;
+    }
+    schedule(tickEvent, std::max(nextTick, clockEdge()));
+}
+
+void
+BinTraceReplayer::recvRetry()
+{
+    assert(retryPkt);
+    PacketPtr pkt = retryPkt;
+    retryPkt = nullptr;
+    if (trySend(pkt))
+        scheduleTick();
+}
+
+void
+BinTraceReplayer::completeRequest(PacketPtr pkt)
+{
+    DPRINTF(BinTraceReplayer, "Completing %s\n", pkt->print());
+    assert(outstanding);
+    outstanding--;
+
+    if (pkt->isRead()) {
+        stats.numReads++;
+        stats.totalReadLatency += curTick() - pkt->req->time();
+    } else {
+        stats.numWrites++;
+    }
+    delete pkt;
+
+    scheduleTick();
+    checkDone();
+}
+
+void
+BinTraceReplayer::checkDone()
+{
+    if (done || haveNext || retryPkt || outstanding)
+        return;
+
+    done = true;
+    exitSimLoop("end of packet trace reached");
+}
+
+} // namespace gem5
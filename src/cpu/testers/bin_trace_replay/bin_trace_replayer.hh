@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_TESTERS_BIN_TRACE_REPLAY_BIN_TRACE_REPLAYER_HH__
+#define __CPU_TESTERS_BIN_TRACE_REPLAY_BIN_TRACE_REPLAYER_HH__
+
+#include <string>
+#include <vector>
+
+#include "base/async_writer.hh"
+#include "base/framed_reader.hh"
+#include "base/statistics.hh"
+#include "mem/port.hh"
+#include "mem/probes/mem_bin_trace.hh"
+#include "params/BinTraceReplayer.hh"
+#include "sim/clocked_object.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+class System;
+
+/**
+ * Replays a packet trace written by MemBinTraceProbe into the memory
+ * system. A trace recorded below a cache holds its miss stream, so
+ * replaying it through a single cache with a prefetcher evaluates the
+ * prefetcher without simulating the CPU and the levels above it.
+ *
+ * Reads become ReadReq packets, and writes, dirty writebacks and
+ * requests for a writable copy become WriteReq packets, with the PC of
+ * the original request when it was recorded. Other commands, such as
+ * clean evictions and prefetches issued by the traced cache itself, are
+ * skipped. Requests are cut at the end of their cache line.
+ */
+class BinTraceReplayer : public ClockedObject
+{
+  public:
+    PARAMS(BinTraceReplayer);
+    BinTraceReplayer(const Params &p);
+
+    void startup() override;
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+  protected:
+    typedef MemBinTraceProbe::Record Record;
+
+    class ReplayPort : public RequestPort
+    {
+        BinTraceReplayer &replayer;
+
+      public:
+        ReplayPort(const std::string &_name, BinTraceReplayer &_replayer)
+            : RequestPort(_name), replayer(_replayer)
+        { }
+
+      protected:
+        bool recvTimingResp(PacketPtr pkt) override;
+
+        void recvReqRetry() override;
+    };
+
+    ReplayPort port;
+
+    System *system;
+    const std::string traceFile;
+    const bool replayTiming;
+    const unsigned maxOutstanding;
+    const uint64_t maxPackets;
+    const std::vector<std::string> requestorFilter;
+
+    /** Request id for all replayed traffic */
+    RequestorID requestorId;
+
+    const Addr blockSize;
+
+    FramedReader reader;
+    AsyncWriter::Block block;
+    size_t blockPos = 0;
+
+    /** Whether each requestor id of the trace is replayed. */
+    std::vector<bool> replayRequestor;
+
+    /** Host ticks per trace tick, if the trace frequency differs. */
+    double tickScale = 1.0;
+    /** First tick of the trace and the tick its replay started at. */
+    Tick traceStart = MaxTick;
+    Tick replayStart = 0;
+
+    /** Next record to replay and the command it is replayed as. */
+    Record next;
+    MemCmd nextCmd;
+    bool haveNext = false;
+    Tick nextTick = 0;
+
+    /** Packet refused by the port, waiting for a retry. */
+    PacketPtr retryPkt = nullptr;
+
+    unsigned outstanding = 0;
+    uint64_t sent = 0;
+    bool done = false;
+
+    void tick();
+
+    EventFunctionWrapper tickEvent;
+
+    /** Parse the header block of the trace. */
+    void readHeader();
+
+    /** Get the next record of the trace. @return False at its end. */
+    bool readRecord(Record &rec);
+
+    /** Command a record is replayed as, InvalidCmd to skip it. */
+    MemCmd replayCommand(const Record &rec) const;
+
+    PacketPtr createPacket(const Record &rec, MemCmd cmd);
+
+    /** Load the next replayed record of the trace. */
+    void advance();
+
+    /** Send a packet. @return False if it has to wait for a retry. */
+    bool trySend(PacketPtr pkt);
+
+    /** Schedule the next send, if it is not blocked. */
+    void scheduleTick();
+
+    void completeRequest(PacketPtr pkt);
+
+    void recvRetry();
+
+    /** Exit the simulation once everything was sent and answered. */
+    void checkDone();
+
+    struct BinTraceReplayerStats : public statistics::Group
+    {
+        BinTraceReplayerStats(statistics::Group *parent);
+
+        statistics::Scalar numReads;
+        statistics::Scalar numWrites;
+        statistics::Scalar numSkipped;
+        statistics::Scalar numRetries;
+        statistics::Scalar totalReadLatency;
+        statistics::Formula avgReadLatency;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TESTERS_BIN_TRACE_REPLAY_BIN_TRACE_REPLAYER_HH__
@@ -63,6 +63,9 @@ class BaseTLB;
 class CheckerCPU;
 class Checkpoint;
 class InstDecoder;
+class MemBackdoor;
+class MemBackdoorReq;
+using MemBackdoorPtr = MemBackdoor *;
 class PortProxy;
 class Process;
 class System;
@@ -144,6 +147,13 @@ class ThreadContext : public PCEventScope
 
     virtual void sendFunctional(PacketPtr pkt);
 
+    /**
+     * Request a functional backdoor through the same path sendFunctional
+     * uses. The backdoor is left as nullptr if there is none.
+     */
+    virtual void sendMemBackdoorReq(const MemBackdoorReq &req,
+                                    MemBackdoorPtr &backdoor);
+
     virtual Process *getProcessPtr() = 0;
 
     virtual void setProcessPtr(Process *p) = 0;
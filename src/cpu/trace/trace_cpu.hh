@@ -281,6 +281,9 @@ class TraceCPU : public ClockedObject
          */
         bool isSnooping() const { return true; }
 
+        /** Snoops are only watched, no data is held. */
+        bool isCaching() const { return false; }
+
       private:
         TraceCPU* owner;
     };
@@ -73,6 +73,10 @@ class EtherLink(SimObject):
     dump = Param.EtherDump(NULL, "dump object")
 
 
+class DistTransport(Enum):
+    vals = ["tcp", "shm"]
+
+
 class DistEtherLink(SimObject):
     type = "DistEtherLink"
     cxx_header = "dev/net/dist_etherlink.hh"
@@ -92,6 +96,15 @@ class DistEtherLink(SimObject):
     is_switch = Param.Bool(False, "true if this a link in etherswitch")
     dist_sync_on_pseudo_op = Param.Bool(False, "Start sync with pseudo_op")
     num_nodes = Param.UInt32("2", "Number of simulate nodes")
+    transport = Param.DistTransport(
+        "tcp",
+        "Message transport, shm requires all processes on the same host",
+    )
+    adaptive_sync = Param.Bool(
+        False,
+        "Move the next sync barrier out while no process can send a "
+        "packet before it (decided by the switch)",
+    )
 
 
 class EtherBus(SimObject):
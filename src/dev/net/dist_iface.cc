@@ -41,6 +41,7 @@
 
 #include "dev/net/dist_iface.hh"
 
+#include <algorithm>
 #include <queue>
 #include <thread>
 
@@ -51,6 +52,7 @@
 #include "debug/DistEthernetPkt.hh"
 #include "dev/net/etherpkt.hh"
 #include "sim/cur_tick.hh"
+#include "sim/eventq.hh"
 #include "sim/sim_exit.hh"
 #include "sim/sim_object.hh"
 #include "sim/system.hh"
@@ -67,7 +69,7 @@ DistIface *DistIface::primary = nullptr;
 bool DistIface::isSwitch = false;
 
 void
-DistIface::Sync::init(Tick start_tick, Tick repeat_tick)
+DistIface::Sync::init(Tick start_tick, Tick repeat_tick, bool adaptive_sync)
 {
     if (start_tick < nextAt) {
         nextAt = start_tick;
@@ -82,6 +84,44 @@ DistIface::Sync::init(Tick start_tick, Tick repeat_tick)
         inform("Dist synchronisation interval is changed to %lu.\n",
                nextRepeat);
     }
+
+    if (adaptive_sync && !adaptive) {
+        adaptive = true;
+        inform("Dist synchronisation interval adapts to idle periods.\n");
+    }
+}
+
+void
+DistIface::Sync::packetSent(Tick send_tick)
+{
+    std::lock_guard<std::mutex> sync_lock(lock);
+    // The receiver gets the packet at least one link delay later, which is
+    // never shorter than the repeat value.
+    Tick arrival = nextRepeat > MaxTick - send_tick ?
+        MaxTick : send_tick + nextRepeat;
+    if (arrival < nextSend)
+        nextSend = arrival;
+}
+
+Tick
+DistIface::Sync::localNextSend()
+{
+    // Nothing can be sent before the next local event, or before a packet
+    // sent in this quantum reaches its destination and triggers a reply.
+    Tick next = nextSend;
+    nextSend = MaxTick;
+
+    // The other event queues may have pending asynchronous insertions we
+    // cannot see from here, so do not look ahead in parallel runs.
+    if (numMainEventQueues > 1)
+        return curTick();
+
+    EventQueue *eq = mainEventQueue[0];
+    eq->lock();
+    if (!eq->empty())
+        next = std::min(next, eq->nextTick());
+    eq->unlock();
+    return next;
 }
 
 void
@@ -107,6 +147,9 @@ DistIface::SyncSwitch::SyncSwitch(int num_nodes)
     nextAt = std::numeric_limits<Tick>::max();
     nextRepeat = std::numeric_limits<Tick>::max();
     isAbort = false;
+    nextSend = MaxTick;
+    quantumEnd = 0;
+    adaptive = false;
 }
 
 DistIface::SyncNode::SyncNode()
@@ -121,6 +164,9 @@ DistIface::SyncNode::SyncNode()
     nextAt = std::numeric_limits<Tick>::max();
     nextRepeat = std::numeric_limits<Tick>::max();
     isAbort = false;
+    nextSend = MaxTick;
+    quantumEnd = 0;
+    adaptive = false;
 }
 
 bool
@@ -136,6 +182,7 @@ DistIface::SyncNode::run(bool same_tick)
     header.msgType = MsgType::cmdSyncReq;
     header.sendTick = curTick();
     header.syncRepeat = nextRepeat;
+    header.nextSendTick = same_tick ? localNextSend() : curTick();
     header.needCkpt = needCkpt;
     header.needStopSync = needStopSync;
     if (needCkpt != ReqType::none)
@@ -174,6 +221,20 @@ DistIface::SyncSwitch::run(bool same_tick)
     header.msgType = MsgType::cmdSyncAck;
     header.sendTick = nextAt;
     header.syncRepeat = nextRepeat;
+    // Move the next sync out if no process can send a packet within the
+    // next repeat interval anyway. A packet sent at next_send or later
+    // arrives at least one repeat later, after the moved sync.
+    quantumEnd = 0;
+    if (same_tick && adaptive) {
+        Tick next_send = localNextSend();
+        if (next_send > curTick() + 1) {
+            quantumEnd = std::min(next_send - 1, MaxTick - nextRepeat) +
+                nextRepeat;
+            DPRINTF(DistEthernet, "Sync quantum grows to %lu ticks\n",
+                    quantumEnd - curTick());
+        }
+    }
+    header.nextSyncTick = quantumEnd;
     if (doCkpt || numCkptReq == numNodes) {
         doCkpt = true;
         header.needCkpt = ReqType::immediate;
@@ -201,6 +262,7 @@ DistIface::SyncSwitch::run(bool same_tick)
 bool
 DistIface::SyncSwitch::progress(Tick send_tick,
                                  Tick sync_repeat,
+                                 Tick next_send,
                                  ReqType need_ckpt,
                                  ReqType need_exit,
                                  ReqType need_stop_sync)
@@ -214,6 +276,8 @@ DistIface::SyncSwitch::progress(Tick send_tick,
         nextAt = send_tick;
     if (nextRepeat > sync_repeat)
         nextRepeat = sync_repeat;
+    if (nextSend > next_send)
+        nextSend = next_send;
 
     if (need_ckpt == ReqType::collective)
         numCkptReq++;
@@ -242,6 +306,7 @@ DistIface::SyncSwitch::progress(Tick send_tick,
 bool
 DistIface::SyncNode::progress(Tick max_send_tick,
                                Tick next_repeat,
+                               Tick next_sync,
                                ReqType do_ckpt,
                                ReqType do_exit,
                                ReqType do_stop_sync)
@@ -253,6 +318,7 @@ DistIface::SyncNode::progress(Tick max_send_tick,
 
     nextAt = max_send_tick;
     nextRepeat = next_repeat;
+    quantumEnd = next_sync;
     doCkpt = (do_ckpt != ReqType::none);
     doExit = (do_exit != ReqType::none);
     doStopSync = (do_stop_sync != ReqType::none);
@@ -425,6 +491,8 @@ DistIface::SyncEvent::process()
     }
     // schedule the next periodic sync
     repeat = DistIface::sync->nextRepeat;
+    if (DistIface::sync->quantumEnd > curTick() + repeat)
+        repeat = DistIface::sync->quantumEnd - curTick();
     schedule(curTick() + repeat);
 }
 
@@ -608,10 +676,10 @@ DistIface::DistIface(unsigned dist_rank,
                      Tick sync_repeat,
                      EventManager *em,
                      bool use_pseudo_op,
-                     bool is_switch, int num_nodes) :
+                     bool is_switch, int num_nodes, bool adaptive_sync) :
     syncStart(sync_start), syncRepeat(sync_repeat),
     recvThread(nullptr), recvScheduler(em), syncStartOnPseudoOp(use_pseudo_op),
-    rank(dist_rank), size(dist_size)
+    adaptiveSync(adaptive_sync), rank(dist_rank), size(dist_size)
 {
     DPRINTF(DistEthernet, "DistIface() ctor rank:%d\n",dist_rank);
     isPrimary = false;
@@ -662,6 +730,7 @@ DistIface::packetOut(EthPacketPtr pkt, Tick send_delay)
 
     // Send out the packet and the meta info.
     sendPacket(header, pkt);
+    sync->packetSent(header.sendTick + send_delay);
 
     DPRINTF(DistEthernetPkt,
             "DistIface::sendDataPacket() done size:%d send_delay:%llu\n",
@@ -705,6 +774,7 @@ DistIface::recvThreadFunc(Event *recv_done, Tick link_delay)
             // everything else must be synchronisation related command
             if (!sync->progress(header.sendTick,
                                 header.syncRepeat,
+                                header.nextSendTick,
                                 header.needCkpt,
                                 header.needExit,
                                 header.needStopSync))
@@ -800,7 +870,7 @@ DistIface::init(const Event *done_event, Tick link_delay)
     // might have different requirements. The singleton sync object
     // will select the minimum values for both params.
     assert(sync != nullptr);
-    sync->init(syncStart, syncRepeat);
+    sync->init(syncStart, syncRepeat, adaptiveSync);
 
     // Initialize the seed for random generator to avoid the same sequence
     // in all gem5 peer processes
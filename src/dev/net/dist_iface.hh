@@ -65,12 +65,17 @@
  * is that no gem5 process can go ahead further than the simulated link
  * transmission delay to ensure that a corresponding receive event can always
  * be scheduled for any message coming in from a peer gem5 process.
- *
+ * With adaptive sync enabled, each process also reports the earliest tick
+ * it could send its next packet, and the switch moves the next barrier
+ * out by the same amount when every process is idle beyond the current
+ * quantum.
  *
  *
  * This interface is an abstract class. It can work with various low level
  * send/receive service implementations (e.g. TCP/IP, MPI,...). A TCP
- * stream socket version is implemented in src/dev/net/tcp_iface.[hh,cc].
+ * stream socket version is implemented in src/dev/net/tcp_iface.[hh,cc],
+ * and a shared memory version for processes running on the same host in
+ * src/dev/net/shm_iface.[hh,cc].
  */
 #ifndef __DEV_DIST_IFACE_HH__
 #define __DEV_DIST_IFACE_HH__
@@ -157,6 +162,32 @@ class DistIface : public Drainable, public Serializable
          *  Flag is set if the sync is aborted (e.g. due to connection lost)
          */
         bool isAbort;
+        /**
+         * Lower bound on the tick of the next data packet. On a node, this
+         * only covers the packets sent in the current quantum, while the
+         * switch collects the minimum reported by all nodes.
+         */
+        Tick nextSend;
+        /**
+         * Tick of the next periodic sync if the last sync moved it out,
+         * zero if the next sync is one repeat away.
+         */
+        Tick quantumEnd;
+        /**
+         * Flag is set if the switch may grow the quantum past the repeat
+         * value when all processes are idle.
+         */
+        bool adaptive;
+
+        /**
+         * Compute the earliest tick any packet may be sent by this process
+         * after the current sync (i.e. the next local event, or the
+         * arrival of a packet sent in the current quantum).
+         *
+         * @note Must be called from the global sync event with the event
+         * queue lock released.
+         */
+        Tick localNextSend();
 
         friend class SyncEvent;
 
@@ -168,7 +199,13 @@ class DistIface : public Drainable, public Serializable
          * @param repeat Frequency of dist synchronisation
          *
          */
-        void init(Tick start, Tick repeat);
+        void init(Tick start, Tick repeat, bool adaptive_sync);
+        /**
+         * Record a data packet sent in the current quantum.
+         *
+         * @param send_tick Tick the packet transmission completes.
+         */
+        void packetSent(Tick send_tick);
         /**
          *  Core method to perform a full dist sync.
          *
@@ -183,6 +220,7 @@ class DistIface : public Drainable, public Serializable
          */
         virtual bool progress(Tick send_tick,
                               Tick next_repeat,
+                              Tick next_tick,
                               ReqType do_ckpt,
                               ReqType do_exit,
                               ReqType do_stop_sync) = 0;
@@ -225,6 +263,7 @@ class DistIface : public Drainable, public Serializable
         bool run(bool same_tick) override;
         bool progress(Tick max_req_tick,
                       Tick next_repeat,
+                      Tick next_tick,
                       ReqType do_ckpt,
                       ReqType do_exit,
                       ReqType do_stop_sync) override;
@@ -264,6 +303,7 @@ class DistIface : public Drainable, public Serializable
         bool run(bool same_tick) override;
         bool progress(Tick max_req_tick,
                       Tick next_repeat,
+                      Tick next_tick,
                       ReqType do_ckpt,
                       ReqType do_exit,
                       ReqType do_stop_sync) override;
@@ -474,6 +514,10 @@ class DistIface : public Drainable, public Serializable
      * Use pseudoOp to start synchronization.
      */
     bool syncStartOnPseudoOp;
+    /**
+     * Grow the sync quantum while all processes are idle.
+     */
+    bool adaptiveSync;
 
   protected:
     /**
@@ -572,6 +616,8 @@ class DistIface : public Drainable, public Serializable
      * @param sync_start Start tick for dist synchronisation
      * @param sync_repeat Frequency for dist synchronisation
      * @param em The event manager associated with the simulated Ethernet link
+     * @param adaptive_sync Grow the sync quantum while all processes are
+     * idle
      */
     DistIface(unsigned dist_rank,
               unsigned dist_size,
@@ -580,7 +626,8 @@ class DistIface : public Drainable, public Serializable
               EventManager *em,
               bool use_pseudo_op,
               bool is_switch,
-              int num_nodes);
+              int num_nodes,
+              bool adaptive_sync = false);
 
     virtual ~DistIface();
     /**
@@ -98,6 +98,19 @@ class DistHeaderPkt
             Tick syncRepeat;
         };
         union
+        {
+            /**
+             * Lower bound on the tick of the next data packet any process
+             * may send (sync request), used by the adaptive sync.
+             */
+            Tick nextSendTick;
+            /**
+             * Tick of the next sync if the switch grew the quantum, zero
+             * otherwise (sync ack).
+             */
+            Tick nextSyncTick;
+        };
+        union
         {
             /**
              * Actual length of the simulated Ethernet packet.
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory transport for dist-gem5 simulations.
+ */
+
+#include "dev/net/shm_iface.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/DistEthernet.hh"
+#include "debug/DistEthernetCmd.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/**
+ * Busy-wait on a ring for a short while, then yield, then sleep so that
+ * idle receiver threads do not hog the cores the simulators need.
+ */
+class Backoff
+{
+  private:
+    unsigned count = 0;
+
+  public:
+    /** @return True once the caller has started sleeping. */
+    bool
+    wait()
+    {
+        if (count < 1024) {
+            count++;
+            return false;
+        }
+        if (count < 1024 + 64) {
+            count++;
+            std::this_thread::yield();
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        return true;
+    }
+};
+
+} // anonymous namespace
+
+std::vector<ShmIface *> ShmIface::ifaceRegistry;
+
+ShmIface::ShmIface(unsigned server_port,
+                   unsigned dist_rank, unsigned dist_size,
+                   Tick sync_start, Tick sync_repeat,
+                   EventManager *em, bool use_pseudo_op, bool is_switch,
+                   int num_nodes, bool adaptive_sync) :
+    DistIface(dist_rank, dist_size, sync_start, sync_repeat, em, use_pseudo_op,
+              is_switch, num_nodes, adaptive_sync),
+    serverPort(server_port), isSwitch(is_switch), segment(nullptr),
+    txRing(nullptr), rxRing(nullptr), peerPid(0)
+{
+}
+
+ShmIface::~ShmIface()
+{
+    // The receiver thread is only joined by the DistIface destructor, so
+    // the segment has to stay mapped until the process exits.
+    if (txRing)
+        txRing->closed.store(1, std::memory_order_release);
+}
+
+std::string
+ShmIface::segmentName(unsigned node_rank, unsigned iface_id) const
+{
+    return csprintf("/gem5-dist-%d-%d-%d-%d", getuid(), serverPort,
+                    node_rank, iface_id);
+}
+
+void
+ShmIface::createSegment()
+{
+    const std::string name = segmentName(rank, distIfaceId);
+
+    // Remove any stale segment left behind by an earlier run.
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    panic_if(fd < 0, "shm_open(%s) failed: %s", name, strerror(errno));
+    panic_if(ftruncate(fd, sizeof(Segment)) != 0,
+             "ftruncate(%s) failed: %s", name, strerror(errno));
+    void *addr = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    panic_if(addr == MAP_FAILED, "mmap(%s) failed: %s", name,
+             strerror(errno));
+    close(fd);
+
+    segment = new (addr) Segment();
+    segment->nodePid = getpid();
+    segment->info.rank = rank;
+    segment->info.distIfaceId = distIfaceId;
+    segment->info.distIfaceNum = distIfaceNum;
+    txRing = &segment->up;
+    rxRing = &segment->down;
+    segment->state.store(Ready, std::memory_order_release);
+
+    DPRINTF(DistEthernet, "Created %s, waiting for the switch\n", name);
+    Backoff backoff;
+    while (segment->state.load(std::memory_order_acquire) != Connected)
+        backoff.wait();
+
+    peerPid = segment->switchPid;
+    assert(segment->info.rank == rank);
+    inform("Link okay  (iface:%d -> switch iface:%d)", distIfaceId,
+           segment->info.distIfaceId);
+}
+
+void
+ShmIface::attachSegment()
+{
+    static unsigned cur_rank = 0;
+    static unsigned cur_id = 0;
+
+    const std::string name = segmentName(cur_rank, cur_id);
+    Backoff backoff;
+    bool waiting = false;
+
+    // The node creates the segment, so keep polling until it shows up
+    // fully initialised.
+    for (;;) {
+        int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd >= 0) {
+            struct stat st;
+            void *addr = MAP_FAILED;
+            if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(Segment)) {
+                addr = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE,
+                            MAP_SHARED, fd, 0);
+                panic_if(addr == MAP_FAILED, "mmap(%s) failed: %s", name,
+                         strerror(errno));
+            }
+            close(fd);
+            if (addr != MAP_FAILED) {
+                segment = static_cast<Segment *>(addr);
+                peerPid = segment->nodePid;
+                if (segment->state.load(std::memory_order_acquire) == Ready &&
+                        peerAlive()) {
+                    break;
+                }
+                munmap(addr, sizeof(Segment));
+                segment = nullptr;
+            }
+        }
+        if (backoff.wait() && !waiting) {
+            inform("Waiting for node %d link %d (%s)", cur_rank, cur_id, name);
+            waiting = true;
+        }
+    }
+
+    const NodeInfo ni = segment->info;
+    assert(ni.rank == cur_rank);
+    assert(ni.distIfaceId == cur_id);
+    inform("Link okay  (iface:%d -> (node:%d, iface:%d))",
+           distIfaceId, ni.rank, ni.distIfaceId);
+    if (ni.distIfaceId < ni.distIfaceNum - 1) {
+        cur_id++;
+    } else {
+        cur_rank++;
+        cur_id = 0;
+    }
+
+    txRing = &segment->down;
+    rxRing = &segment->up;
+    // send ack
+    segment->switchPid = getpid();
+    segment->info.distIfaceId = distIfaceId;
+    segment->info.distIfaceNum = distIfaceNum;
+    segment->state.store(Connected, std::memory_order_release);
+
+    // Both ends have the segment mapped now, so drop the name.
+    shm_unlink(name.c_str());
+}
+
+bool
+ShmIface::peerAlive() const
+{
+    return kill(peerPid, 0) == 0 || errno != ESRCH;
+}
+
+void
+ShmIface::sendShm(const void *buf, unsigned length)
+{
+    auto *src = static_cast<const char *>(buf);
+    Backoff backoff;
+
+    while (length > 0) {
+        const uint64_t head = txRing->head.load(std::memory_order_relaxed);
+        const uint64_t tail = txRing->tail.load(std::memory_order_acquire);
+        const uint64_t space = RingSize - (head - tail);
+        if (space == 0) {
+            if (backoff.wait() &&
+                    (rxRing->closed.load(std::memory_order_acquire) ||
+                     !peerAlive())) {
+                exitSimLoop("Message peer closed connection, simulation "
+                            "is exiting");
+                return;
+            }
+            continue;
+        }
+
+        const uint64_t offset = head % RingSize;
+        const uint64_t n = std::min<uint64_t>({length, space,
+                                               RingSize - offset});
+        std::memcpy(txRing->data + offset, src, n);
+        txRing->head.store(head + n, std::memory_order_release);
+        src += n;
+        length -= n;
+        backoff = Backoff();
+    }
+}
+
+bool
+ShmIface::recvShm(void *buf, unsigned length)
+{
+    auto *dst = static_cast<char *>(buf);
+    Backoff backoff;
+
+    while (length > 0) {
+        const uint64_t tail = rxRing->tail.load(std::memory_order_relaxed);
+        const uint64_t head = rxRing->head.load(std::memory_order_acquire);
+        if (head == tail) {
+            // Check the flag before the head again so that data written
+            // right before closing is not lost.
+            if (rxRing->closed.load(std::memory_order_acquire) &&
+                    rxRing->head.load(std::memory_order_acquire) == tail) {
+                inform("recv(): Connection closed");
+                return false;
+            }
+            if (backoff.wait() && !peerAlive()) {
+                inform("recv(): Peer process exited");
+                return false;
+            }
+            continue;
+        }
+
+        const uint64_t offset = tail % RingSize;
+        const uint64_t n = std::min<uint64_t>({length, head - tail,
+                                               RingSize - offset});
+        std::memcpy(dst, rxRing->data + offset, n);
+        rxRing->tail.store(tail + n, std::memory_order_release);
+        dst += n;
+        length -= n;
+        backoff = Backoff();
+    }
+    return true;
+}
+
+void
+ShmIface::sendPacket(const Header &header, const EthPacketPtr &packet)
+{
+    std::lock_guard<std::mutex> send_lock(sendLock);
+    sendShm(&header, sizeof(header));
+    sendShm(packet->data, packet->length);
+}
+
+void
+ShmIface::sendCmd(const Header &header)
+{
+    DPRINTF(DistEthernetCmd, "ShmIface::sendCmd() type: %d\n",
+            static_cast<int>(header.msgType));
+    // Global commands (i.e. sync request) are always sent by the primary
+    // DistIface, on every link of this process.
+    for (auto *iface : ifaceRegistry) {
+        std::lock_guard<std::mutex> send_lock(iface->sendLock);
+        iface->sendShm(&header, sizeof(header));
+    }
+}
+
+bool
+ShmIface::recvHeader(Header &header)
+{
+    bool ret = recvShm(&header, sizeof(header));
+    DPRINTF(DistEthernetCmd, "ShmIface::recvHeader() type: %d ret: %d\n",
+            static_cast<int>(header.msgType), ret);
+    return ret;
+}
+
+void
+ShmIface::recvPacket(const Header &header, EthPacketPtr &packet)
+{
+    packet = std::make_shared<EthPacketData>(header.dataPacketLength);
+    bool ret = recvShm(packet->data, header.dataPacketLength);
+    panic_if(!ret, "Error while reading shared memory link");
+    packet->simLength = header.simLength;
+    packet->length = header.dataPacketLength;
+}
+
+void
+ShmIface::initTransport()
+{
+    // As with TCP, the links are set up in init() once the number of dist
+    // interfaces in this process is known.
+    if (isSwitch)
+        attachSegment();
+    else
+        createSegment();
+    ifaceRegistry.push_back(this);
+}
+
+} // namespace gem5
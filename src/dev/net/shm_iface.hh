@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory transport for dist-gem5 simulations.
+ *
+ * For a high level description about dist-gem5 see comments in
+ * header file dist_iface.hh.
+ *
+ * When all gem5 processes of a dist run are on the same host, messages can
+ * be passed through shared memory instead of TCP sockets. Each node side
+ * link creates a POSIX shared memory segment named after the server port,
+ * its rank and its link id. The segment holds two single producer, single
+ * consumer byte rings, one per direction. The switch process attaches to
+ * the segments in the same (rank, link id) order as TCPIface accepts
+ * connections, so every node is connected to the same switch port as it
+ * would be over TCP.
+ */
+#ifndef __DEV_NET_SHM_IFACE_HH__
+#define __DEV_NET_SHM_IFACE_HH__
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dev/net/dist_iface.hh"
+
+namespace gem5
+{
+
+class EventManager;
+
+class ShmIface : public DistIface
+{
+  private:
+    /** Size of each message ring in bytes. */
+    static constexpr uint64_t RingSize = 1 << 20;
+
+    struct Ring
+    {
+        /** Bytes ever written, only updated by the producer. */
+        alignas(64) std::atomic<uint64_t> head;
+        /** Bytes ever read, only updated by the consumer. */
+        alignas(64) std::atomic<uint64_t> tail;
+        /** Set by the producer when it stops sending. */
+        std::atomic<uint32_t> closed;
+        alignas(64) char data[RingSize];
+    };
+
+    struct NodeInfo
+    {
+        unsigned rank;
+        unsigned distIfaceId;
+        unsigned distIfaceNum;
+    };
+
+    /** Connection handshake state of a segment. */
+    enum SegmentState : uint32_t { Creating, Ready, Connected };
+
+    struct Segment
+    {
+        std::atomic<uint32_t> state;
+        pid_t nodePid;
+        pid_t switchPid;
+        NodeInfo info;
+        /** Messages from the node to the switch. */
+        Ring up;
+        /** Messages from the switch to the node. */
+        Ring down;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+                  "Shared memory rings need address-free atomics");
+
+    unsigned serverPort;
+    bool isSwitch;
+
+    Segment *segment;
+    Ring *txRing;
+    Ring *rxRing;
+    pid_t peerPid;
+    /**
+     * Serializes the senders so that a header and its packet are written
+     * back-to-back.
+     */
+    std::mutex sendLock;
+
+    /** All shared memory links in this process, used by sendCmd(). */
+    static std::vector<ShmIface *> ifaceRegistry;
+
+    std::string segmentName(unsigned node_rank, unsigned iface_id) const;
+    /** Create this node's segment and wait for the switch to attach. */
+    void createSegment();
+    /** Attach to the next node's segment (switch side). */
+    void attachSegment();
+    bool peerAlive() const;
+
+    /**
+     * Copy a message into the transmit ring, waiting for the consumer to
+     * free up space if necessary.
+     */
+    void sendShm(const void *buf, unsigned length);
+    /**
+     * Copy the next message out of the receive ring.
+     *
+     * @return False if the peer closed the link or exited.
+     */
+    bool recvShm(void *buf, unsigned length);
+
+  protected:
+    void sendPacket(const Header &header,
+                    const EthPacketPtr &packet) override;
+
+    void sendCmd(const Header &header) override;
+
+    bool recvHeader(Header &header) override;
+
+    void recvPacket(const Header &header, EthPacketPtr &packet) override;
+
+    void initTransport() override;
+
+  public:
+    /**
+     * @param server_port Port of the switch, used to tell apart the
+     * segments of concurrent dist runs on the same host.
+     * @param sync_start The tick for the first dist synchronisation.
+     * @param sync_repeat The frequency of dist synchronisation.
+     * @param em The EventManager object associated with the simulated
+     * Ethernet link.
+     */
+    ShmIface(unsigned server_port,
+             unsigned dist_rank, unsigned dist_size,
+             Tick sync_start, Tick sync_repeat, EventManager *em,
+             bool use_pseudo_op, bool is_switch, int num_nodes,
+             bool adaptive_sync);
+
+    ~ShmIface() override;
+};
+
+} // namespace gem5
+
+#endif // __DEV_NET_SHM_IFACE_HH__
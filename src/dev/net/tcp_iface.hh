@@ -144,11 +144,14 @@ class TCPIface : public DistIface
      * @param sync_repeat The frequency of dist synchronisation.
      * @param em The EventManager object associated with the simulated
      * Ethernet link.
+     * @param adaptive_sync Grow the sync quantum while all processes are
+     * idle.
      */
     TCPIface(std::string server_name, unsigned server_port,
              unsigned dist_rank, unsigned dist_size,
              Tick sync_start, Tick sync_repeat, EventManager *em,
-             bool use_pseudo_op, bool is_switch, int num_nodes);
+             bool use_pseudo_op, bool is_switch, int num_nodes,
+             bool adaptive_sync);
 
     ~TCPIface() override;
 };
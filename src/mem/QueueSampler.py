@@ -0,0 +1,51 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.SimObject import SimObject
+
+
+class QueueSampler(SimObject):
+    """Samples the occupancy of the MSHRs, write buffers and packet queues
+    of caches, and of the queues of memory controllers, at a fixed
+    interval. The samples are written to a compact binary time series in
+    the output directory, which util/plot_queue_occupancy.py plots and
+    summarises.
+    """
+
+    type = "QueueSampler"
+    cxx_header = "mem/queue_sampler.hh"
+    cxx_class = "gem5::QueueSampler"
+
+    caches = VectorParam.BaseCache([], "Caches whose queues are sampled")
+    mem_ctrls = VectorParam.MemCtrl(
+        [], "Memory controllers whose queues are sampled"
+    )
+    interval = Param.Latency("1us", "Time between two samples")
+    output = Param.String(
+        "queue_occupancy.bin",
+        "Name of the time series file, compressed if it ends in .gz",
+    )
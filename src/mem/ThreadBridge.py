@@ -40,7 +40,9 @@ class ThreadBridge(SimObject):
     the ThreadBridge is using.
 
     Given that this is only used for simulation speed accelerating, only the
-    atomic and functional access are supported.
+    atomic and functional access are supported. Requests for memory
+    backdoors are forwarded too, so requestors can then access memory
+    without crossing threads at all.
 
     Example:
 
@@ -37,6 +37,7 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from m5.objects.ClockedObject import ClockedObject
+from m5.objects.ReplacementPolicies import *
 from m5.objects.System import System
 from m5.params import *
 from m5.proxy import *
@@ -154,6 +155,16 @@ class SnoopFilter(SimObject):
     # Sanity check on max capacity to track, adjust if needed.
     max_capacity = Param.MemorySize("8MiB", "Maximum capacity of snoop filter")
 
+    # By default the filter tracks every line cached above it. Setting
+    # the number of sets makes it a finite, set-associative structure
+    # that back-invalidates the caches above when it replaces an entry,
+    # like an inclusive directory.
+    sets = Param.Unsigned(0, "Number of sets, 0 for an unbounded filter")
+    assoc = Param.Unsigned(8, "Associativity of a bounded filter")
+    replacement_policy = Param.BaseReplacementPolicy(
+        LRURP(), "Replacement policy of a bounded filter"
+    )
+
 
 # We use a coherent crossbar to connect multiple requestors to the L2
 # caches. Normally this crossbar would be part of the cache itself.
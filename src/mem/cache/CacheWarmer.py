@@ -0,0 +1,51 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.BaseMemProbe import BaseMemProbe
+from m5.params import *
+from m5.proxy import *
+
+
+class CacheWarmer(BaseMemProbe):
+    """Functionally warms the caches of a CPU from the accesses of a CPU
+    fast forwarding with the caches bypassed, for example a
+    NonCachingSimpleCPU in the atomic_noncaching memory mode. The caches
+    are warm when switching to a detailed CPU, without the cost of
+    simulating them in atomic mode."""
+
+    type = "CacheWarmer"
+    cxx_header = "mem/cache/warmer.hh"
+    cxx_class = "gem5::CacheWarmer"
+
+    probe_name = "PktRequest"
+
+    system = Param.System(Parent.any, "System the caches belong to")
+    icaches = VectorParam.BaseCache(
+        [], "Caches on the instruction path, from the CPU down"
+    )
+    dcaches = VectorParam.BaseCache(
+        [], "Caches on the data path, from the CPU down"
+    )
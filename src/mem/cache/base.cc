@@ -89,7 +89,7 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       prefetcher(p.prefetcher),
       writeAllocator(p.write_allocator),
       writebackClean(p.writeback_clean),
-      tempBlockWriteback(nullptr),
+      tempBlockWriteback(nullptr), warming(false),
       writebackTempBlockAtomicEvent([this]{ writebackTempBlockAtomic(); },
                                     name(), false,
                                     EventBase::Delayed_Writeback_Pri),
@@ -717,7 +717,9 @@ BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
 {
     Addr blk_addr = pkt->getBlockAddr(blkSize);
     bool is_secure = pkt->isSecure();
-    CacheBlk *blk = tags->findBlock(pkt->getAddr(), is_secure);
+    // The data of warmed blocks is stale until they are filled
+    CacheBlk *blk = warming ? nullptr :
+        tags->findBlock(pkt->getAddr(), is_secure);
     MSHR *mshr = mshrQueue.findMatch(blk_addr, is_secure);
 
     pkt->pushLabel(name());
@@ -1797,15 +1799,121 @@ BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 void
 BaseCache::memWriteback()
 {
+    // Memory is up to date while warming, and the data is stale
+    if (warming)
+        return;
+
     tags->forEachBlk([this](CacheBlk &blk) { writebackVisitor(blk); });
 }
 
 void
 BaseCache::memInvalidate()
 {
+    if (warming) {
+        tags->forEachBlk([this](CacheBlk &blk) {
+            if (blk.isValid())
+                warmInvalidate(&blk);
+        });
+        warming = false;
+        return;
+    }
+
     tags->forEachBlk([this](CacheBlk &blk) { invalidateVisitor(blk); });
 }
 
+void
+BaseCache::finishWarming()
+{
+    DPRINTF(Cache, "Filling the warmed blocks from below\n");
+
+    tags->forEachBlk([this](CacheBlk &blk) {
+        if (!blk.isValid())
+            return;
+
+        RequestPtr request = std::make_shared<Request>(
+            regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
+        if (blk.isSecure())
+            request->setFlags(Request::SECURE);
+
+        Packet packet(request, MemCmd::ReadReq);
+        packet.dataStatic(blk.data);
+        packet.setBlockCached();
+
+        // Caches below which are still warming ignore their own blocks,
+        // so the data comes from an up-to-date cache or from memory
+        memSidePort.sendFunctional(&packet);
+    });
+    warming = false;
+}
+
+void
+BaseCache::drainResume()
+{
+    ClockedObject::drainResume();
+
+    if (warming && !system->bypassCaches())
+        finishWarming();
+}
+
+CacheBlk*
+BaseCache::warmAccess(const PacketPtr pkt)
+{
+    warming = true;
+
+    Cycles lat;
+    return tags->accessBlock(pkt, lat);
+}
+
+CacheBlk*
+BaseCache::warmFill(const PacketPtr pkt, bool writeback,
+                    std::vector<WarmVictim> &victims)
+{
+    if (!writeback && clusivity == enums::mostly_excl)
+        return nullptr;
+
+    warming = true;
+
+    // Without data, compressed tags see the line as incompressible
+    std::vector<CacheBlk*> evict_blks;
+    CacheBlk *victim = tags->findVictim(pkt->getAddr(), pkt->isSecure(),
+                                        blkSize * 8, evict_blks);
+    if (!victim)
+        return nullptr;
+
+    for (auto *blk : evict_blks) {
+        if (!blk->isValid())
+            continue;
+        if (blk->isSet(CacheBlk::DirtyBit) || writebackClean) {
+            victims.push_back({regenerateBlkAddr(blk), blk->isSecure(),
+                               blk->isSet(CacheBlk::WritableBit),
+                               blk->isSet(CacheBlk::DirtyBit)});
+        }
+        warmInvalidate(blk);
+    }
+
+    tags->insertBlock(pkt, victim);
+    if (compressor)
+        compressor->setSizeBits(victim, blkSize * 8);
+    victim->setCoherenceBits(CacheBlk::ReadableBit);
+
+    return victim;
+}
+
+void
+BaseCache::warmServed(CacheBlk *blk)
+{
+    if (clusivity == enums::mostly_excl && !blk->isSet(CacheBlk::DirtyBit))
+        warmInvalidate(blk);
+}
+
+void
+BaseCache::warmInvalidate(CacheBlk *blk)
+{
+    // Unlike invalidateBlock(), do not expose the stale data to the
+    // probe listeners
+    tags->invalidate(blk);
+}
+
 bool
 BaseCache::isDirty() const
 {
@@ -2002,7 +2110,9 @@ BaseCache::sendWriteQueuePacket(WriteQueueEntry* wq_entry)
 void
 BaseCache::serialize(CheckpointOut &cp) const
 {
-    bool dirty(isDirty());
+    // The dirty blocks of a warming cache are already up to date in
+    // memory
+    bool dirty(!warming && isDirty());
 
     if (dirty) {
         warn("*** The cache still contains dirty data. ***\n");
@@ -2590,6 +2700,19 @@ BaseCache::CpuSidePort::recvAtomic(PacketPtr pkt)
     }
 }
 
+Tick
+BaseCache::CpuSidePort::recvAtomicBackdoor(PacketPtr pkt,
+                                           MemBackdoorPtr &backdoor)
+{
+    if (cache.system->bypassCaches()) {
+        // Nothing is cached in cache bypass mode, so the requestor may
+        // as well access the memory below directly.
+        return cache.memSidePort.sendAtomicBackdoor(pkt, backdoor);
+    } else {
+        return ResponsePort::recvAtomicBackdoor(pkt, backdoor);
+    }
+}
+
 void
 BaseCache::CpuSidePort::recvFunctional(PacketPtr pkt)
 {
@@ -299,6 +299,9 @@ class BaseCache : public ClockedObject
 
         virtual Tick recvAtomic(PacketPtr pkt) override;
 
+        virtual Tick recvAtomicBackdoor(PacketPtr pkt,
+                                        MemBackdoorPtr &backdoor) override;
+
         virtual void recvFunctional(PacketPtr pkt) override;
 
         virtual AddrRangeList getAddrRanges() const override;
@@ -682,6 +685,13 @@ class BaseCache : public ClockedObject
      */
     PacketPtr tempBlockWriteback;
 
+    /**
+     * Whether the tags are being functionally warmed, see warmAccess().
+     * The data of the blocks is then stale, and is ignored until it is
+     * read from below by finishWarming().
+     */
+    bool warming;
+
     /**
      * Send the outstanding tempBlock writeback. To be called after
      * recvAtomic finishes in cases where the block we filled is in
@@ -861,6 +871,17 @@ class BaseCache : public ClockedObject
      */
     virtual void memInvalidate() override;
 
+    /**
+     * Read the data of every warmed block from below, as it is the first
+     * time the cache is used since the system stopped bypassing it. The
+     * reads are flagged as coming from a cache holding the block, so that
+     * the snoop filter below learns about the blocks it has not seen
+     * being requested.
+     */
+    void finishWarming();
+
+    void drainResume() override;
+
     /**
      * Determine if there are any dirty blocks in the cache.
      *
@@ -1169,6 +1190,73 @@ class BaseCache : public ClockedObject
 
     const AddrRangeList &getAddrRanges() const { return addrRanges; }
 
+    /** The MSHRs and the write buffer, for sampling their occupancy. */
+    const MSHRQueue &getMSHRQueue() const { return mshrQueue; }
+    const WriteQueue &getWriteBuffer() const { return writeBuffer; }
+
+    /**
+     * @defgroup FunctionalWarming Functional warming of the tags.
+     *
+     * While the system bypasses the caches, for example when fast
+     * forwarding with a NonCachingSimpleCPU, a CacheWarmer replays the
+     * accesses of the CPUs on the tags of the caches. The tags and the
+     * replacement state are updated, but no data is moved and no timing
+     * is modelled. Memory holds the up-to-date data throughout, so the
+     * warmed blocks are filled from below when the system stops
+     * bypassing the caches.
+     *
+     * The coherence state of the blocks is left to the warmer.
+     * @{
+     */
+
+    /** A block evicted by a warm fill, to be written back below. */
+    struct WarmVictim
+    {
+        Addr addr;
+        bool isSecure;
+        bool writable;
+        bool dirty;
+    };
+
+    /**
+     * Look up an access, updating the replacement state on a hit.
+     *
+     * @param pkt The access, or the writeback of a block from above.
+     * @return The block hit, nullptr on a miss.
+     */
+    CacheBlk *warmAccess(const PacketPtr pkt);
+
+    /** Look up a block without updating the replacement state. */
+    CacheBlk *
+    warmFind(Addr addr, bool is_secure) const
+    {
+        return tags->findBlock(addr, is_secure);
+    }
+
+    /**
+     * Allocate a block for a missing access, following the allocation
+     * policy of the cache. The block is only made readable.
+     *
+     * @param pkt The access.
+     * @param writeback Whether this is the writeback of a block from
+     *        above rather than a fill.
+     * @param victims The evicted blocks the cache would write back.
+     * @return The allocated block, nullptr if the cache does not allocate.
+     */
+    CacheBlk *warmFill(const PacketPtr pkt, bool writeback,
+                       std::vector<WarmVictim> &victims);
+
+    /**
+     * Notify that a block has served a miss of the cache above, which
+     * drops it if this cache is mostly exclusive.
+     */
+    void warmServed(CacheBlk *blk);
+
+    /** Invalidate a warmed block without writing it back. */
+    void warmInvalidate(CacheBlk *blk);
+
+    /** @} */
+
     MSHR *allocateMissBuffer(PacketPtr pkt, Tick time, bool sched_send = true)
     {
         MSHR *mshr = mshrQueue.allocate(pkt->getBlockAddr(blkSize), blkSize,
@@ -0,0 +1,65 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class CompressibilityProfiler(SimObject):
+    """Streams the physical memory stores of a checkpoint through cache
+    compressors and reports, for each compressor, the distribution of the
+    compressed line sizes and its host throughput. The simulation exits
+    once all stores are processed.
+
+    The compressors are not attached to a cache, so those relying on one,
+    such as FrequentValuesCompressor or a MultiCompressor including it,
+    are rejected. All the others are supported."""
+
+    type = "CompressibilityProfiler"
+    cxx_class = "gem5::compression::CompressibilityProfiler"
+    cxx_header = "mem/cache/compressors/profiler.hh"
+
+    compressors = VectorParam.BaseCacheCompressor(
+        "Compressors to profile, which must not need a cache"
+    )
+    checkpoint_dir = Param.String(
+        "", "Checkpoint whose .pmem store files are profiled"
+    )
+    store_files = VectorParam.String(
+        [], "Store files to profile, instead of those of checkpoint_dir"
+    )
+    block_size = Param.Int(Parent.cache_line_size, "Block size in bytes")
+    threads = Param.Unsigned(
+        0, "Host threads compressing in parallel, 0 for all host cores"
+    )
+    batch_lines = Param.Unsigned(
+        65536, "Lines read from the stores before they are compressed"
+    )
+    max_lines = Param.Counter(0, "Lines to profile, 0 for all")
+    output = Param.String(
+        "compressibility", "Prefix of the report files in the output directory"
+    )
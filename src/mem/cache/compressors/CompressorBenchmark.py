@@ -0,0 +1,57 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class CompressorBenchmark(SimObject):
+    """Measures the host time taken by cache compressors to compress the
+    lines of a memory dump, such as the pmem store file of a checkpoint,
+    and exits the simulation. If reference compressors are given, they
+    compress the same lines and every compressed size must match the one
+    of the compressor at the same position."""
+
+    type = "CompressorBenchmark"
+    cxx_class = "gem5::compression::CompressorBenchmark"
+    cxx_header = "mem/cache/compressors/benchmark.hh"
+
+    compressors = VectorParam.BaseCacheCompressor("Compressors to measure")
+    references = VectorParam.BaseCacheCompressor(
+        [], "Compressors whose results must match, position by position"
+    )
+    dump_file = Param.String("Memory image to compress, raw or gzipped")
+    block_size = Param.Int(Parent.cache_line_size, "Block size in bytes")
+    max_lines = Param.Counter(0, "Number of lines to load, 0 for all")
+    skip_zero_lines = Param.Bool(
+        False, "Leave lines that only contain zeros out of the measurements"
+    )
+    repeats = Param.Unsigned(1, "Number of times every line is compressed")
+    output = Param.String(
+        "compressor_benchmark.txt", "Report file in the output directory"
+    )
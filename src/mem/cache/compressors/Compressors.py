@@ -74,6 +74,11 @@ class BaseDictionaryCompressor(BaseCacheCompressor):
     dictionary_size = Param.Int(
         Parent.cache_line_size, "Number of dictionary entries"
     )
+    fast_pattern_search = Param.Bool(
+        True,
+        "Find the pattern of a value without instantiating the candidate "
+        "patterns of every dictionary entry. The results are the same.",
+    )
 
 
 class Base64Delta8(BaseDictionaryCompressor):
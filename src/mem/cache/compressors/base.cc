@@ -118,12 +118,12 @@ Base::toChunks(const uint64_t* data) const
         (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
 
     // Turn a 64-bit array into a chunkSizeBits-array
+    const uint64_t chunk_mask = mask(chunkSizeBits);
     std::vector<Chunk> chunks((blkSize * CHAR_BIT) / chunkSizeBits, 0);
     for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
         const unsigned start = i % num_chunks_per_64;
-        chunks[i] = bits(data[index_64],
-            (start + 1) * chunkSizeBits - 1, start * chunkSizeBits);
+        chunks[i] = (data[i / num_chunks_per_64] >> (start * chunkSizeBits)) &
+            chunk_mask;
     }
 
     return chunks;
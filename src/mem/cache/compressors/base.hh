@@ -205,6 +205,12 @@ class Base : public SimObject
     /** The cache can only be set once. */
     virtual void setCache(BaseCache *_cache);
 
+    /**
+     * Whether the compressor relies on its cache, e.g. to listen to its
+     * probes, and so cannot be used without one.
+     */
+    virtual bool needsCache() const { return false; }
+
     /**
      * Apply the compression process to the cache line. Ignores compression
      * cycles.
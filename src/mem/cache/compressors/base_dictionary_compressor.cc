@@ -42,7 +42,8 @@ namespace compression
 
 BaseDictionaryCompressor::BaseDictionaryCompressor(const Params &p)
   : Base(p), dictionarySize(p.dictionary_size),
-    numEntries(0), dictionaryStats(stats, *this)
+    numEntries(0), fastPatternSearch(p.fast_pattern_search),
+    dictionaryStats(stats, *this)
 {
 }
 
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/compressors/benchmark.hh"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/types.hh"
+#include "mem/cache/compressors/base.hh"
+#include "params/CompressorBenchmark.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace compression
+{
+
+CompressorBenchmark::CompressorBenchmark(const Params &p)
+    : SimObject(p), compressors(p.compressors), references(p.references),
+      dumpFile(p.dump_file), blkSize(p.block_size), maxLines(p.max_lines),
+      skipZeroLines(p.skip_zero_lines),
+      repeats(std::max(p.repeats, 1u)), outputName(p.output),
+      runEvent([this]{ run(); }, name())
+{
+    fatal_if(!references.empty() && references.size() != compressors.size(),
+             "%s: There must be one reference per compressor.", name());
+    fatal_if(blkSize % sizeof(uint64_t),
+             "%s: The block size must be a multiple of 8 bytes.", name());
+}
+
+void
+CompressorBenchmark::startup()
+{
+    schedule(runEvent, curTick());
+}
+
+void
+CompressorBenchmark::loadDump()
+{
+    // gzread reads files which are not gzipped as they are.
+    gzFile file = gzopen(dumpFile.c_str(), "rb");
+    fatal_if(!file, "%s: Cannot open %s.", name(), dumpFile);
+
+    const std::size_t words = blkSize / sizeof(uint64_t);
+    std::vector<uint64_t> line(words);
+    while (!maxLines || numLines < maxLines) {
+        const int bytes = gzread(file, line.data(), blkSize);
+        if (bytes < (int)blkSize)
+            break;
+        if (skipZeroLines &&
+                std::all_of(line.begin(), line.end(),
+                            [](uint64_t word) { return word == 0; })) {
+            skippedLines++;
+            continue;
+        }
+        lines.insert(lines.end(), line.begin(), line.end());
+        numLines++;
+    }
+    gzclose(file);
+
+    fatal_if(!numLines, "%s: No line to compress in %s.", name(), dumpFile);
+}
+
+double
+CompressorBenchmark::measure(Base *compressor,
+                             std::vector<std::size_t> &sizes)
+{
+    const std::size_t words = blkSize / sizeof(uint64_t);
+    sizes.resize(numLines);
+
+    Cycles comp_lat, decomp_lat;
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < repeats; r++) {
+        for (uint64_t i = 0; i < numLines; i++) {
+            sizes[i] = compressor->compress(&lines[i * words], comp_lat,
+                                            decomp_lat)->getSizeBits();
+        }
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void
+CompressorBenchmark::run()
+{
+    loadDump();
+
+    OutputStream *report = simout.create(outputName);
+    std::ostream &os = *report->stream();
+    ccprintf(os, "# %s: %d lines of %d bytes, %d zero lines skipped, "
+             "%d repeats\n", dumpFile, numLines, blkSize, skippedLines,
+             repeats);
+    ccprintf(os, "%-40s %12s %12s %12s %10s %12s\n", "compressor",
+             "ns/line", "MiB/s", "bits/line", "ratio", "ref_speedup");
+
+    const double bytes = double(numLines) * blkSize * repeats;
+    for (std::size_t c = 0; c < compressors.size(); c++) {
+        std::vector<std::size_t> sizes;
+        const double seconds = measure(compressors[c], sizes);
+
+        double ref_speedup = 0;
+        if (!references.empty()) {
+            std::vector<std::size_t> ref_sizes;
+            ref_speedup = measure(references[c], ref_sizes) / seconds;
+            for (uint64_t i = 0; i < numLines; i++) {
+                fatal_if(sizes[i] != ref_sizes[i],
+                         "%s: %s compressed line %d to %d bits, but %s to "
+                         "%d bits.", name(), compressors[c]->name(), i,
+                         sizes[i], references[c]->name(), ref_sizes[i]);
+            }
+        }
+
+        double total_bits = 0;
+        for (const auto size : sizes)
+            total_bits += size;
+        const double bits_per_line = total_bits / numLines;
+
+        ccprintf(os, "%-40s %12.1f %12.1f %12.1f %10.3f %12.2f\n",
+                 compressors[c]->name(), seconds * 1e9 / (numLines * repeats),
+                 bytes / seconds / (1024 * 1024), bits_per_line,
+                 bits_per_line ? blkSize * 8 / bits_per_line : 0,
+                 ref_speedup);
+    }
+    simout.close(report);
+
+    inform("%s: Compressed %d lines with %d compressors, see %s.", name(),
+           numLines, compressors.size(), outputName);
+    exitSimLoop("compressor benchmark done");
+}
+
+} // namespace compression
+} // namespace gem5
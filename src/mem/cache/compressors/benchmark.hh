@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_COMPRESSORS_BENCHMARK_HH__
+#define __MEM_CACHE_COMPRESSORS_BENCHMARK_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+struct CompressorBenchmarkParams;
+
+namespace compression
+{
+
+class Base;
+
+/**
+ * Compresses the lines of a memory image with each of a list of
+ * compressors, reports the host time they took and the compression they
+ * achieved, and exits the simulation. Reference compressors, such as the
+ * same compressors with their fast paths disabled, can be given to check
+ * that the results are identical line by line.
+ */
+class CompressorBenchmark : public SimObject
+{
+  protected:
+    const std::vector<Base*> compressors;
+    const std::vector<Base*> references;
+    const std::string dumpFile;
+    const std::size_t blkSize;
+    const uint64_t maxLines;
+    const bool skipZeroLines;
+    const unsigned repeats;
+    const std::string outputName;
+
+    /** The lines to compress, blkSize / 8 words each. */
+    std::vector<uint64_t> lines;
+    uint64_t numLines = 0;
+    uint64_t skippedLines = 0;
+
+    EventFunctionWrapper runEvent;
+
+    void loadDump();
+
+    /**
+     * Compress every line with a compressor.
+     *
+     * @param compressor The compressor to measure.
+     * @param sizes The compressed size of every line, in bits.
+     * @return The host time taken, in seconds.
+     */
+    double measure(Base *compressor, std::vector<std::size_t> &sizes);
+
+    void run();
+
+  public:
+    typedef CompressorBenchmarkParams Params;
+    CompressorBenchmark(const Params &p);
+
+    void startup() override;
+};
+
+} // namespace compression
+} // namespace gem5
+
+#endif //__MEM_CACHE_COMPRESSORS_BENCHMARK_HH__
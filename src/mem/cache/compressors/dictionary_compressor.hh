@@ -73,6 +73,9 @@ class BaseDictionaryCompressor : public Base
     /** Number of valid entries in the dictionary. */
     std::size_t numEntries;
 
+    /** Whether to search patterns without instantiating candidates. */
+    const bool fastPatternSearch;
+
     struct DictionaryStats : public statistics::Group
     {
         const BaseDictionaryCompressor& compressor;
@@ -142,6 +145,14 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     template <unsigned N>
     class SignExtendedPattern;
 
+    /** A pattern a value matches, found without instantiating it. */
+    struct PatternMatch
+    {
+        /** Position of the pattern in its factory. */
+        unsigned index;
+        std::size_t sizeBits;
+    };
+
     /**
      * Create a factory to determine if input matches a pattern. The if else
      * chains are constructed by recursion. The patterns should be explored
@@ -167,6 +178,72 @@ class DictionaryCompressor : public BaseDictionaryCompressor
                                                     match_location);
             }
         }
+
+        /** Find the first pattern the input matches, as getPattern(). */
+        static PatternMatch
+        match(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
+            const int match_location)
+        {
+            if (Head::isPattern(bytes, dict_bytes, match_location)) {
+                return {0, sizeBits()};
+            }
+            PatternMatch next = Factory<Tail...>::match(bytes, dict_bytes,
+                                                        match_location);
+            next.index++;
+            return next;
+        }
+
+        /** Instantiate the pattern at the given position. */
+        static std::unique_ptr<Pattern>
+        create(unsigned index, const DictionaryEntry& bytes,
+            const int match_location)
+        {
+            if (index == 0) {
+                return std::unique_ptr<Pattern>(
+                            new Head(bytes, match_location));
+            }
+            return Factory<Tail...>::create(index - 1, bytes,
+                                            match_location);
+        }
+
+        /**
+         * Find the smallest pattern of the input over all dictionary
+         * entries. The result is the same as comparing the patterns
+         * instantiated by getPattern() for each entry, but only the chosen
+         * pattern is instantiated.
+         */
+        static std::unique_ptr<Pattern>
+        findPattern(const DictionaryEntry& bytes,
+            const std::vector<DictionaryEntry>& dictionary,
+            const std::size_t num_entries)
+        {
+            PatternMatch best = match(bytes, toDictionaryEntry(0), -1);
+            int best_location = -1;
+            for (std::size_t i = 0; i < num_entries; i++) {
+                const PatternMatch candidate = match(bytes, dictionary[i], i);
+                if (candidate.sizeBits < best.sizeBits) {
+                    best = candidate;
+                    best_location = i;
+                }
+            }
+
+            std::unique_ptr<Pattern> pattern =
+                create(best.index, bytes, best_location);
+            assert(pattern->getSizeBits() == best.sizeBits);
+            return pattern;
+        }
+
+        /**
+         * The size of a newly instantiated pattern only depends on its
+         * type, so it is computed once.
+         */
+        static std::size_t
+        sizeBits()
+        {
+            static const std::size_t size_bits =
+                Head(toDictionaryEntry(0), -1).getSizeBits();
+            return size_bits;
+        }
     };
 
     /**
@@ -188,6 +265,38 @@ class DictionaryCompressor : public BaseDictionaryCompressor
         {
             return std::unique_ptr<Pattern>(new Head(bytes, match_location));
         }
+
+        static PatternMatch
+        match(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
+            const int match_location)
+        {
+            return {0, sizeBits()};
+        }
+
+        static std::unique_ptr<Pattern>
+        create(unsigned index, const DictionaryEntry& bytes,
+            const int match_location)
+        {
+            assert(index == 0);
+            return std::unique_ptr<Pattern>(new Head(bytes, match_location));
+        }
+
+        static std::unique_ptr<Pattern>
+        findPattern(const DictionaryEntry& bytes,
+            const std::vector<DictionaryEntry>& dictionary,
+            const std::size_t num_entries)
+        {
+            // No dictionary entry can yield a smaller pattern
+            return create(0, bytes, -1);
+        }
+
+        static std::size_t
+        sizeBits()
+        {
+            static const std::size_t size_bits =
+                Head(toDictionaryEntry(0), -1).getSizeBits();
+            return size_bits;
+        }
     };
 
     /** The dictionary. */
@@ -202,6 +311,27 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     getPattern(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
         const int match_location) const = 0;
 
+    /**
+     * Find the best pattern for the value among all dictionary entries by
+     * instantiating the candidate pattern of every entry.
+     *
+     * @param bytes The value to be compressed.
+     * @return The smallest pattern found.
+     */
+    std::unique_ptr<Pattern> searchPatterns(const DictionaryEntry& bytes)
+        const;
+
+    /**
+     * Same as searchPatterns(), without instantiating the candidates.
+     * Classes that inherit from this base class should implement it with
+     * their factory's findPattern.
+     */
+    virtual std::unique_ptr<Pattern>
+    findPattern(const DictionaryEntry& bytes) const
+    {
+        return searchPatterns(bytes);
+    }
+
     /**
      * Compress data.
      *
@@ -634,19 +764,15 @@ class DictionaryCompressor<T>::RepeatedValuePattern
     isPattern(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
         const int match_location)
     {
-        // Parse the dictionary entry in a RepT granularity, and if all values
-        // are equal, this is a repeated value pattern. Since the dictionary
-        // is not being used, the match_location is irrelevant
-        T bytes_value = DictionaryCompressor<T>::fromDictionaryEntry(bytes);
+        // If the value is made of copies of its least significant RepT,
+        // it is equal to that RepT broadcast to the whole entry, e.g.,
+        // 0x32 * 0x0101 for a uint8_t repeated in a uint16_t. Since the
+        // dictionary is not being used, the match_location is irrelevant
+        const T bytes_value =
+            DictionaryCompressor<T>::fromDictionaryEntry(bytes);
+        const T ones = static_cast<T>(~T(0)) / static_cast<RepT>(~RepT(0));
         const RepT rep_value = bytes_value;
-        for (int i = 0; i < (sizeof(T) / sizeof(RepT)); i++) {
-            RepT cur_value = bytes_value;
-            if (cur_value != rep_value) {
-                return false;
-            }
-            bytes_value >>= 8 * sizeof(RepT);
-        }
-        return true;
+        return bytes_value == static_cast<T>(rep_value * ones);
     }
 
     DictionaryEntry
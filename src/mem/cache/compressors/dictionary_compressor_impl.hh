@@ -92,11 +92,8 @@ DictionaryCompressor<T>::instantiateDictionaryCompData() const
 
 template <typename T>
 std::unique_ptr<typename DictionaryCompressor<T>::Pattern>
-DictionaryCompressor<T>::compressValue(const T data)
+DictionaryCompressor<T>::searchPatterns(const DictionaryEntry& bytes) const
 {
-    // Split data in bytes
-    const DictionaryEntry bytes = toDictionaryEntry(data);
-
     // Start as a no-match pattern. A negative match location is used so that
     // patterns that depend on the dictionary entry don't match
     std::unique_ptr<Pattern> pattern =
@@ -114,6 +111,19 @@ DictionaryCompressor<T>::compressValue(const T data)
         }
     }
 
+    return pattern;
+}
+
+template <typename T>
+std::unique_ptr<typename DictionaryCompressor<T>::Pattern>
+DictionaryCompressor<T>::compressValue(const T data)
+{
+    // Split data in bytes
+    const DictionaryEntry bytes = toDictionaryEntry(data);
+
+    std::unique_ptr<Pattern> pattern = fastPatternSearch ?
+        findPattern(bytes) : searchPatterns(bytes);
+
     // Update stats
     dictionaryStats.patterns[pattern->getPatternNumber()]++;
 
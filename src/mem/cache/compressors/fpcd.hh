@@ -142,6 +142,12 @@ class FPCD : public DictionaryCompressor<uint32_t>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::unique_ptr<Pattern>
+    findPattern(const DictionaryEntry& bytes) const override
+    {
+        return PatternFactory::findPattern(bytes, dictionary, numEntries);
+    }
+
     void addToDictionary(DictionaryEntry data) override;
 
   public:
@@ -190,6 +190,8 @@ class FrequentValues : public Base
     void probeNotify(const DataUpdate &data_update);
 
     void regProbeListeners() override;
+
+    bool needsCache() const override { return true; }
 };
 
 class FrequentValues::CompData : public CompressionData
@@ -86,6 +86,16 @@ Multi::setCache(BaseCache *_cache)
     }
 }
 
+bool
+Multi::needsCache() const
+{
+    for (const auto& compressor : compressors) {
+        if (compressor->needsCache())
+            return true;
+    }
+    return false;
+}
+
 std::unique_ptr<Base::CompressionData>
 Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     Cycles& decomp_lat)
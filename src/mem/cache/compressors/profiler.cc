@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/compressors/profiler.hh"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <thread>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/types.hh"
+#include "debug/CacheComp.hh"
+#include "mem/cache/compressors/base.hh"
+#include "params/CompressibilityProfiler.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace compression
+{
+
+CompressibilityProfiler::CompressibilityProfiler(const Params &p)
+    : SimObject(p), compressors(p.compressors),
+      checkpointDir(p.checkpoint_dir), storeFiles(p.store_files),
+      blkSize(p.block_size), numThreads(p.threads),
+      batchLines(std::max<uint64_t>(p.batch_lines, 1)),
+      maxLines(p.max_lines), outputName(p.output),
+      profiles(compressors.size()),
+      runEvent([this]{ run(); }, name())
+{
+    fatal_if(compressors.empty(), "%s: No compressor to profile.", name());
+    fatal_if(blkSize % sizeof(uint64_t),
+             "%s: The block size must be a multiple of 8 bytes.", name());
+    fatal_if(storeFiles.empty() && checkpointDir.empty(),
+             "%s: Either a checkpoint or store files must be given.",
+             name());
+    for (const auto *compressor : compressors) {
+        fatal_if(compressor->needsCache(), "%s: %s needs a cache, and "
+                 "cannot be profiled on its own.", name(),
+                 compressor->name());
+    }
+
+    if (!numThreads)
+        numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    numThreads = std::min<std::size_t>(numThreads, compressors.size());
+
+    for (auto &profile : profiles)
+        profile.sizes.resize(blkSize + 1);
+}
+
+void
+CompressibilityProfiler::startup()
+{
+    schedule(runEvent, curTick());
+}
+
+std::vector<std::string>
+CompressibilityProfiler::findStores() const
+{
+    namespace fs = std::filesystem;
+
+    std::error_code ec;
+    std::vector<std::string> stores;
+    for (const auto &entry : fs::directory_iterator(checkpointDir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".pmem")
+            stores.push_back(entry.path().string());
+    }
+    fatal_if(ec, "%s: Cannot list %s: %s.", name(), checkpointDir,
+             ec.message());
+    std::sort(stores.begin(), stores.end());
+    return stores;
+}
+
+void
+CompressibilityProfiler::readBatch(void *file, std::vector<uint64_t> &batch,
+                                   uint64_t limit)
+{
+    const std::size_t words = blkSize / sizeof(uint64_t);
+    const uint64_t lines = std::min(batchLines, limit);
+    batch.resize(lines * words);
+
+    // gzread takes an int, so large batches are read in several calls.
+    const std::size_t max_read =
+        std::numeric_limits<int>::max() / blkSize * blkSize;
+    std::size_t bytes = 0;
+    while (bytes < lines * blkSize) {
+        const int read = gzread((gzFile)file,
+                                (uint8_t *)batch.data() + bytes,
+                                std::min(max_read, lines * blkSize - bytes));
+        fatal_if(read < 0, "%s: Failed to read a store.", name());
+        if (!read)
+            break;
+        bytes += read;
+    }
+    batch.resize(bytes / blkSize * words);
+
+    for (auto it = batch.begin(); it != batch.end(); it += words) {
+        if (std::all_of(it, it + words,
+                        [](uint64_t word) { return word == 0; })) {
+            zeroLines++;
+        }
+    }
+}
+
+void
+CompressibilityProfiler::compressBatch(std::size_t index,
+                                       const std::vector<uint64_t> &batch)
+{
+    const std::size_t words = blkSize / sizeof(uint64_t);
+    Base *compressor = compressors[index];
+    Profile &profile = profiles[index];
+
+    Cycles comp_lat, decomp_lat;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < batch.size(); i += words) {
+        const std::size_t bits = compressor->compress(&batch[i], comp_lat,
+            decomp_lat)->getSizeBits();
+        profile.sizes[std::min((bits + 7) / 8, blkSize)]++;
+        profile.totalBits += bits;
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    profile.seconds += elapsed.count();
+}
+
+void
+CompressibilityProfiler::profileStore(const std::string &path)
+{
+    gzFile file = gzopen(path.c_str(), "rb");
+    fatal_if(!file, "%s: Cannot open %s.", name(), path);
+
+    const uint64_t before = numLines;
+    auto remaining = [this]() {
+        return maxLines ? maxLines - numLines
+                        : std::numeric_limits<uint64_t>::max();
+    };
+
+    const std::size_t words = blkSize / sizeof(uint64_t);
+    std::vector<uint64_t> batch, next;
+    readBatch(file, batch, remaining());
+    while (!batch.empty()) {
+        numLines += batch.size() / words;
+
+        // The compressors print their debug messages with the current
+        // tick, which is only known to the simulation thread.
+        if (debug::CacheComp) {
+            for (std::size_t c = 0; c < compressors.size(); c++)
+                compressBatch(c, batch);
+            readBatch(file, next, remaining());
+        } else {
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < numThreads; t++) {
+                workers.emplace_back([this, t, &batch]() {
+                    for (std::size_t c = t; c < compressors.size();
+                            c += numThreads) {
+                        compressBatch(c, batch);
+                    }
+                });
+            }
+            readBatch(file, next, remaining());
+            for (auto &worker : workers)
+                worker.join();
+        }
+        batch.swap(next);
+    }
+    gzclose(file);
+
+    inform("%s: Profiled %d lines of %s.", name(), numLines - before, path);
+}
+
+void
+CompressibilityProfiler::dump()
+{
+    OutputStream *report = simout.create(outputName + ".txt");
+    std::ostream &os = *report->stream();
+    ccprintf(os, "# %d lines of %d bytes, %d zero lines, %d threads\n",
+             numLines, blkSize, zeroLines, numThreads);
+    ccprintf(os, "%-40s %10s %10s %8s %8s %8s %12s\n", "compressor",
+             "bytes/line", "ratio", "<=1/2", "<=1/4", "<=1/8", "MiB/s");
+
+    const double lines = numLines;
+    for (std::size_t c = 0; c < compressors.size(); c++) {
+        const Profile &profile = profiles[c];
+
+        // Fraction of the lines fitting in a part of the line.
+        auto fraction = [&](std::size_t parts) {
+            uint64_t fit = 0;
+            for (std::size_t size = 0; size <= blkSize / parts; size++)
+                fit += profile.sizes[size];
+            return fit / lines;
+        };
+
+        const double bytes_per_line = profile.totalBits / 8 / lines;
+        ccprintf(os, "%-40s %10.2f %10.3f %8.3f %8.3f %8.3f %12.1f\n",
+                 compressors[c]->name(), bytes_per_line,
+                 bytes_per_line ? blkSize / bytes_per_line : 0,
+                 fraction(2), fraction(4), fraction(8),
+                 profile.seconds ? lines * blkSize / profile.seconds /
+                                   (1024 * 1024) : 0);
+    }
+    simout.close(report);
+
+    OutputStream *csv = simout.create(outputName + ".csv");
+    ccprintf(*csv->stream(), "compressor,size_bytes,lines\n");
+    for (std::size_t c = 0; c < compressors.size(); c++) {
+        for (std::size_t size = 0; size <= blkSize; size++) {
+            if (profiles[c].sizes[size]) {
+                ccprintf(*csv->stream(), "%s,%d,%d\n",
+                         compressors[c]->name(), size,
+                         profiles[c].sizes[size]);
+            }
+        }
+    }
+    simout.close(csv);
+}
+
+void
+CompressibilityProfiler::run()
+{
+    if (storeFiles.empty())
+        storeFiles = findStores();
+    fatal_if(storeFiles.empty(), "%s: No store file in %s.", name(),
+             checkpointDir);
+
+    for (const auto &path : storeFiles) {
+        if (maxLines && numLines >= maxLines)
+            break;
+        profileStore(path);
+    }
+    fatal_if(!numLines, "%s: No line to profile.", name());
+
+    dump();
+
+    inform("%s: Profiled %d lines with %d compressors, see %s.txt.",
+           name(), numLines, compressors.size(), outputName);
+    exitSimLoop("compressibility profile done");
+}
+
+} // namespace compression
+} // namespace gem5
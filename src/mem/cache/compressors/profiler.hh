@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_COMPRESSORS_PROFILER_HH__
+#define __MEM_CACHE_COMPRESSORS_PROFILER_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+struct CompressibilityProfilerParams;
+
+namespace compression
+{
+
+class Base;
+
+/**
+ * Measures how well the contents of a memory image compress. The physical
+ * memory stores of a checkpoint, as written by
+ * PhysicalMemory::serializeStore, are streamed in batches of lines through
+ * every compressor. The compressors of a batch run in parallel on host
+ * threads while the next batch is being read. For each compressor, the
+ * distribution of the compressed line sizes and the host throughput are
+ * reported, then the simulation exits.
+ */
+class CompressibilityProfiler : public SimObject
+{
+  protected:
+    /** What is gathered about a compressor. */
+    struct Profile
+    {
+        /** Number of lines per compressed size, in bytes. */
+        std::vector<uint64_t> sizes;
+        double totalBits = 0;
+        /** Host time spent compressing, in seconds. */
+        double seconds = 0;
+    };
+
+    const std::vector<Base*> compressors;
+    const std::string checkpointDir;
+    std::vector<std::string> storeFiles;
+    const std::size_t blkSize;
+    unsigned numThreads;
+    const uint64_t batchLines;
+    const uint64_t maxLines;
+    const std::string outputName;
+
+    std::vector<Profile> profiles;
+    uint64_t numLines = 0;
+    uint64_t zeroLines = 0;
+
+    EventFunctionWrapper runEvent;
+
+    /** The store files of the checkpoint, sorted by name. */
+    std::vector<std::string> findStores() const;
+
+    /**
+     * Read the next lines of a store.
+     *
+     * @param file The gzipped store.
+     * @param batch Where the lines are read to. Resized to the whole lines
+     *        read, at most batchLines of them.
+     * @param limit Maximum number of lines to read.
+     */
+    void readBatch(void *file, std::vector<uint64_t> &batch, uint64_t limit);
+
+    /** Compress every line of a batch with one compressor. */
+    void compressBatch(std::size_t index,
+                       const std::vector<uint64_t> &batch);
+
+    void profileStore(const std::string &path);
+
+    void dump();
+
+    void run();
+
+  public:
+    typedef CompressibilityProfilerParams Params;
+    CompressibilityProfiler(const Params &p);
+
+    void startup() override;
+};
+
+} // namespace compression
+} // namespace gem5
+
+#endif //__MEM_CACHE_COMPRESSORS_PROFILER_HH__
@@ -94,6 +94,12 @@ class RepeatedQwords : public DictionaryCompressor<uint64_t>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::unique_ptr<Pattern>
+    findPattern(const DictionaryEntry& bytes) const override
+    {
+        return PatternFactory::findPattern(bytes, dictionary, numEntries);
+    }
+
     void addToDictionary(DictionaryEntry data) override;
 
     std::unique_ptr<Base::CompressionData> compress(
@@ -97,8 +97,117 @@ Queued::DeferredPacket::finish(const Fault &fault,
     owner->translationComplete(this, failed, *cache);
 }
 
+Queued::DeferredQueue::Index::iterator
+Queued::DeferredQueue::findIndex(const DeferredPacket &dp)
+{
+    auto range = index.equal_range(key(dp.pfInfo));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (&*it->second == &dp)
+            return it;
+    }
+    panic("Prefetch to %#x is not in %s\n", dp.pfInfo.getAddr(), name);
+}
+
+Queued::DeferredPacket *
+Queued::DeferredQueue::find(const PrefetchInfo &pfi)
+{
+    auto it = index.find(key(pfi));
+    return it == index.end() ? nullptr : &*it->second;
+}
+
+Queued::DeferredPacket *
+Queued::DeferredQueue::victim()
+{
+    for (auto bucket = buckets.rbegin(); bucket != buckets.rend();
+         ++bucket) {
+        for (auto &dp : bucket->second) {
+            if (!dp.ongoingTranslation)
+                return &dp;
+        }
+    }
+    return nullptr;
+}
+
+void
+Queued::DeferredQueue::push(const DeferredPacket &dp)
+{
+    Bucket &bucket = buckets[dp.priority];
+    auto it = bucket.insert(bucket.end(), dp);
+    index.emplace(key(dp.pfInfo), it);
+    _size++;
+}
+
+void
+Queued::DeferredQueue::erase(DeferredPacket &dp)
+{
+    auto idx = findIndex(dp);
+    auto bucket = buckets.find(dp.priority);
+    assert(bucket != buckets.end());
+    iterator it = idx->second;
+    index.erase(idx);
+    bucket->second.erase(it);
+    if (bucket->second.empty())
+        buckets.erase(bucket);
+    _size--;
+}
+
+void
+Queued::DeferredQueue::setPriority(DeferredPacket &dp, int32_t priority)
+{
+    iterator it = findIndex(dp)->second;
+    auto from = buckets.find(dp.priority);
+    assert(from != buckets.end());
+    Bucket &to = buckets[priority];
+    // Splicing keeps both the element and the iterators to it valid
+    to.splice(to.end(), from->second, it);
+    if (from->second.empty())
+        buckets.erase(from);
+    dp.priority = priority;
+}
+
+void
+Queued::DeferredQueue::forEachMatch(const PrefetchInfo &pfi,
+    const std::function<bool(DeferredPacket &)> &f)
+{
+    auto range = index.equal_range(key(pfi));
+    std::vector<DeferredPacket *> matches;
+    for (auto it = range.first; it != range.second; ++it)
+        matches.push_back(&*it->second);
+    for (auto dp : matches) {
+        if (f(*dp))
+            erase(*dp);
+    }
+}
+
+void
+Queued::DeferredQueue::forEach(
+    const std::function<void(const DeferredPacket &)> &f) const
+{
+    for (const auto &bucket : buckets) {
+        for (const auto &dp : bucket.second)
+            f(dp);
+    }
+}
+
+std::vector<Queued::DeferredPacket *>
+Queued::DeferredQueue::head(size_t max)
+{
+    std::vector<DeferredPacket *> dps;
+    for (auto &bucket : buckets) {
+        for (auto &dp : bucket.second) {
+            if (dps.size() == max)
+                return dps;
+            dps.push_back(&dp);
+        }
+    }
+    return dps;
+}
+
 Queued::Queued(const QueuedPrefetcherParams &p)
-    : Base(p), queueSize(p.queue_size),
+    : Base(p), pfq("PFQ", p.queue_size),
+      pfqMissingTranslation("PFTransQ",
+        p.max_prefetch_requests_with_pending_translation),
+      queueSize(p.queue_size),
       missingTranslationQueueSize(
         p.max_prefetch_requests_with_pending_translation),
       latency(p.latency), queueSquash(p.queue_squash),
@@ -111,31 +220,20 @@ Queued::Queued(const QueuedPrefetcherParams &p)
 Queued::~Queued()
 {
     // Delete the queued prefetch packets
-    for (DeferredPacket &p : pfq) {
-        delete p.pkt;
-    }
+    pfq.forEach([](const DeferredPacket &p) { delete p.pkt; });
 }
 
 void
-Queued::printQueue(const std::list<DeferredPacket> &queue) const
+Queued::printQueue(const DeferredQueue &queue) const
 {
     int pos = 0;
-    std::string queue_name = "";
-    if (&queue == &pfq) {
-        queue_name = "PFQ";
-    } else {
-        assert(&queue == &pfqMissingTranslation);
-        queue_name = "PFTransQ";
-    }
-
-    for (const_iterator it = queue.cbegin(); it != queue.cend();
-                                                            it++, pos++) {
-        Addr vaddr = it->pfInfo.getAddr();
+    queue.forEach([&](const DeferredPacket &dp) {
+        Addr vaddr = dp.pfInfo.getAddr();
         /* Set paddr to 0 if not yet translated */
-        Addr paddr = it->pkt ? it->pkt->getAddr() : 0;
+        Addr paddr = dp.pkt ? dp.pkt->getAddr() : 0;
         DPRINTF(HWPrefetchQueue, "%s[%d]: Prefetch Req VA: %#x PA: %#x "
-                "prio: %3d\n", queue_name, pos, vaddr, paddr, it->priority);
-    }
+                "prio: %3d\n", queue.name, pos++, vaddr, paddr, dp.priority);
+    });
 }
 
 size_t
@@ -172,27 +270,21 @@ void
 Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi)
 {
     Addr blk_addr = blockAddress(pfi.getAddr());
-    bool is_secure = pfi.isSecure();
     const PacketPtr pkt = acc.pkt;
     const CacheAccessor &cache = acc.cache;
 
     // Squash queued prefetches if demand miss to same line
-    if (queueSquash) {
-        auto itr = pfq.begin();
-        while (itr != pfq.end()) {
-            if (itr->pfInfo.getAddr() == blk_addr &&
-                itr->pfInfo.isSecure() == is_secure) {
+    if (queueSquash && !pfq.empty()) {
+        pfq.forEachMatch(PrefetchInfo(pfi, blk_addr),
+            [&](DeferredPacket &dp) {
                 DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
                         "(cl: %#x), demand request going to the same addr\n",
-                        itr->pfInfo.getAddr(),
-                        blockAddress(itr->pfInfo.getAddr()));
-                delete itr->pkt;
-                itr = pfq.erase(itr);
+                        dp.pfInfo.getAddr(),
+                        blockAddress(dp.pfInfo.getAddr()));
+                delete dp.pkt;
                 statsQueued.pfRemovedDemand++;
-            } else {
-                ++itr;
-            }
-        }
+                return true;
+            });
     }
 
     // Calculate prefetches given this access
@@ -252,7 +344,7 @@ Queued::getPacket()
     }
 
     PacketPtr pkt = pfq.front().pkt;
-    pfq.pop_front();
+    pfq.erase(pfq.front());
 
     prefetchStats.pfIssued++;
     issuedPrefetches += 1;
@@ -287,82 +379,57 @@ Queued::QueuedStats::QueuedStats(statistics::Group *parent)
 void
 Queued::processMissingTranslations(unsigned max)
 {
-    unsigned count = 0;
-    iterator it = pfqMissingTranslation.begin();
-    while (it != pfqMissingTranslation.end() && count < max) {
-        DeferredPacket &dp = *it;
-        // Increase the iterator first because dp.startTranslation can end up
-        // calling finishTranslation, which will erase "it"
-        it++;
-        dp.startTranslation(mmu);
-        count += 1;
-    }
+    // Collect the batch first because dp.startTranslation can end up
+    // calling finishTranslation, which will erase the prefetch
+    for (DeferredPacket *dp : pfqMissingTranslation.head(max))
+        dp->startTranslation(mmu);
 }
 
 void
 Queued::translationComplete(DeferredPacket *dp, bool failed,
                             const CacheAccessor &cache)
 {
-    auto it = pfqMissingTranslation.begin();
-    while (it != pfqMissingTranslation.end()) {
-        if (&(*it) == dp) {
-            break;
-        }
-        it++;
-    }
-    assert(it != pfqMissingTranslation.end());
     if (!failed) {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x succeeded: "
                 "paddr %#x \n", mmu->name(),
-                it->translationRequest->getVaddr(),
-                it->translationRequest->getPaddr());
-        Addr target_paddr = it->translationRequest->getPaddr();
+                dp->translationRequest->getVaddr(),
+                dp->translationRequest->getPaddr());
+        Addr target_paddr = dp->translationRequest->getPaddr();
         // check if this prefetch is already redundant
         if (cacheSnoop &&
-                (cache.inCache(target_paddr, it->pfInfo.isSecure()) ||
-                 cache.inMissQueue(target_paddr, it->pfInfo.isSecure()))) {
+                (cache.inCache(target_paddr, dp->pfInfo.isSecure()) ||
+                 cache.inMissQueue(target_paddr, dp->pfInfo.isSecure()))) {
             statsQueued.pfInCache++;
             DPRINTF(HWPrefetch, "Dropping redundant in "
                     "cache/MSHR prefetch addr:%#x\n", target_paddr);
         } else {
             Tick pf_time = curTick() + clockPeriod() * latency;
-            it->createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
-                          pf_time);
-            addToQueue(pfq, *it);
+            // Queue a copy, as the original is removed below
+            DeferredPacket ready = *dp;
+            ready.createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
+                            pf_time);
+            addToQueue(pfq, ready);
         }
     } else {
         DPRINTF(HWPrefetch, "%s Translation of vaddr %#x failed, dropping "
                 "prefetch request %#x \n", mmu->name(),
-                it->translationRequest->getVaddr());
+                dp->translationRequest->getVaddr());
     }
-    pfqMissingTranslation.erase(it);
+    pfqMissingTranslation.erase(*dp);
 }
 
 bool
-Queued::alreadyInQueue(std::list<DeferredPacket> &queue,
+Queued::alreadyInQueue(DeferredQueue &queue,
                                  const PrefetchInfo &pfi, int32_t priority)
 {
-    bool found = false;
-    iterator it;
-    for (it = queue.begin(); it != queue.end() && !found; it++) {
-        found = it->pfInfo.sameAddr(pfi);
-    }
+    DeferredPacket *dp = queue.find(pfi);
 
     /* If the address is already in the queue, update priority and leave */
-    if (it != queue.end()) {
+    if (dp) {
         statsQueued.pfBufferHit++;
-        if (it->priority < priority) {
+        if (dp->priority < priority) {
             /* Update priority value and position in the queue */
-            it->priority = priority;
-            iterator prev = it;
-            while (prev != queue.begin()) {
-                prev--;
-                /* If the packet has higher priority, swap */
-                if (*it > *prev) {
-                    std::swap(*it, *prev);
-                    it = prev;
-                }
-            }
+            queue.setPriority(*dp, priority);
             DPRINTF(HWPrefetch, "Prefetch addr already in "
                 "prefetch queue, priority updated\n");
         } else {
@@ -370,7 +437,7 @@ Queued::alreadyInQueue(std::list<DeferredPacket> &queue,
                 "prefetch queue\n");
         }
     }
-    return found;
+    return dp != nullptr;
 }
 
 RequestPtr
@@ -484,50 +551,29 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
 }
 
 void
-Queued::addToQueue(std::list<DeferredPacket> &queue,
-                             DeferredPacket &dpp)
+Queued::addToQueue(DeferredQueue &queue, DeferredPacket &dpp)
 {
     /* Verify prefetch buffer space for request */
-    if (queue.size() == queueSize) {
+    if (queue.full()) {
         statsQueued.pfRemovedFull++;
-        /* Lowest priority packet */
-        iterator it = queue.end();
-        panic_if (it == queue.begin(),
-            "Prefetch queue is both full and empty!");
-        --it;
-        /* Look for oldest in that level of priority */
-        panic_if (it == queue.begin(),
-            "Prefetch queue is full with 1 element!");
-        iterator prev = it;
-        bool cont = true;
-        /* While not at the head of the queue */
-        while (cont && prev != queue.begin()) {
-            prev--;
-            /* While at the same level of priority */
-            cont = prev->priority == it->priority;
-            if (cont)
-                /* update pointer */
-                it = prev;
+        /* Oldest of the lowest priority packets */
+        DeferredPacket *victim = queue.victim();
+        if (!victim) {
+            // Every queued prefetch is waiting for its translation and
+            // must stay where the MMU can find it
+            DPRINTF(HWPrefetch, "Prefetch queue full of translations, "
+                    "dropping new packet, addr: %#x\n",
+                    dpp.pfInfo.getAddr());
+            delete dpp.pkt;
+            return;
         }
         DPRINTF(HWPrefetch, "Prefetch queue full, removing lowest priority "
-                            "oldest packet, addr: %#x\n",it->pfInfo.getAddr());
-        delete it->pkt;
-        queue.erase(it);
+                "oldest packet, addr: %#x\n", victim->pfInfo.getAddr());
+        delete victim->pkt;
+        queue.erase(*victim);
     }
 
-    if ((queue.size() == 0) || (dpp <= queue.back())) {
-        queue.emplace_back(dpp);
-    } else {
-        iterator it = queue.end();
-        do {
-            --it;
-        } while (it != queue.begin() && dpp > *it);
-        /* If we reach the head, we have to see if the new element is new head
-         * or not */
-        if (it == queue.begin() && dpp <= *it)
-            it++;
-        queue.insert(it, dpp);
-    }
+    queue.push(dpp);
 
     if (debug::HWPrefetchQueue)
         printQueue(queue);
@@ -39,8 +39,13 @@
 #define __MEM_CACHE_PREFETCH_QUEUED_HH__
 
 #include <cstdint>
+#include <functional>
 #include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "arch/generic/mmu.hh"
 #include "base/statistics.hh"
@@ -141,11 +146,106 @@ class Queued : public Base
         void startTranslation(BaseMMU *mmu);
     };
 
-    std::list<DeferredPacket> pfq;
-    std::list<DeferredPacket> pfqMissingTranslation;
+    /**
+     * A bounded queue of deferred prefetches, ordered by decreasing
+     * priority and, within a priority, from oldest to youngest. The
+     * prefetches are kept in one FIFO per priority level and indexed by
+     * address, so that filtering, squashing, reprioritising and
+     * replacing prefetches does not depend on the queue occupancy.
+     * Prefetches never move in memory while queued, which the address
+     * translations in flight rely on.
+     */
+    class DeferredQueue
+    {
+      private:
+        using Bucket = std::list<DeferredPacket>;
+        using iterator = Bucket::iterator;
+
+        /** FIFOs of prefetches, by decreasing priority */
+        std::map<int32_t, Bucket, std::greater<int32_t>> buckets;
+
+        using Index = std::unordered_multimap<Addr, iterator>;
+
+        /** Prefetches by block address, tagged with the security state */
+        Index index;
+
+        size_t _size = 0;
+
+        static Addr
+        key(const PrefetchInfo &pfi)
+        {
+            return pfi.getAddr() | (pfi.isSecure() ? 1 : 0);
+        }
+
+        /** Find the position of a queued prefetch */
+        Index::iterator findIndex(const DeferredPacket &dp);
+
+      public:
+        /** Name used when printing the queue */
+        const std::string name;
+
+        /** Maximum number of prefetches */
+        const unsigned capacity;
+
+        DeferredQueue(const std::string &_name, unsigned _capacity)
+            : name(_name), capacity(_capacity)
+        {}
+
+        bool empty() const { return _size == 0; }
+        size_t size() const { return _size; }
+        bool full() const { return _size >= capacity; }
+
+        /** The oldest of the highest priority prefetches */
+        DeferredPacket &front() { return buckets.begin()->second.front(); }
+        const DeferredPacket &
+        front() const
+        {
+            return buckets.begin()->second.front();
+        }
+
+        /**
+         * Find a queued prefetch to the same block.
+         * @return The prefetch, or nullptr if there is none
+         */
+        DeferredPacket *find(const PrefetchInfo &pfi);
+
+        /**
+         * Find the prefetch to replace when the queue is full: the oldest
+         * of the lowest priority prefetches that are not being
+         * translated.
+         * @return The prefetch, or nullptr if all are being translated
+         */
+        DeferredPacket *victim();
+
+        /** Add a prefetch behind all the others of the same priority */
+        void push(const DeferredPacket &dp);
+
+        /** Remove a queued prefetch */
+        void erase(DeferredPacket &dp);
+
+        /**
+         * Change the priority of a queued prefetch, moving it behind the
+         * prefetches of its new priority.
+         */
+        void setPriority(DeferredPacket &dp, int32_t priority);
+
+        /**
+         * Visit the queued prefetches to a block. The visitor returns
+         * whether to remove the prefetch from the queue.
+         */
+        void forEachMatch(const PrefetchInfo &pfi,
+                          const std::function<bool(DeferredPacket &)> &f);
+
+        /** Visit all queued prefetches, in order */
+        void forEach(
+            const std::function<void(const DeferredPacket &)> &f) const;
+
+        /** The prefetches that are first in order, at most max of them */
+        std::vector<DeferredPacket *> head(size_t max);
+    };
 
-    using const_iterator = std::list<DeferredPacket>::const_iterator;
-    using iterator = std::list<DeferredPacket>::iterator;
+    DeferredQueue pfq;
+    DeferredQueue pfqMissingTranslation;
 
     // PARAMETERS
 
@@ -210,7 +310,7 @@ class Queued : public Base
         return pfq.empty() ? MaxTick : pfq.front().tick;
     }
 
-    void printQueue(const std::list<DeferredPacket> &queue) const;
+    void printQueue(const DeferredQueue &queue) const;
 
   private:
 
@@ -219,7 +319,7 @@ class Queued : public Base
      * @param queue selected queue to use
      * @param dpp DeferredPacket to add
      */
-    void addToQueue(std::list<DeferredPacket> &queue, DeferredPacket &dpp);
+    void addToQueue(DeferredQueue &queue, DeferredPacket &dpp);
 
     /**
      * Starts the translations of the queued prefetches with a
@@ -249,7 +349,7 @@ class Queued : public Base
      * @param priority priority of the prefetch request to be added
      * @return True if the prefetch request was found in the queue
      */
-    bool alreadyInQueue(std::list<DeferredPacket> &queue,
+    bool alreadyInQueue(DeferredQueue &queue,
                         const PrefetchInfo &pfi, int32_t priority);
 
     /**
@@ -157,6 +157,18 @@ class Queue : public Drainable, public Named
         return _numInService;
     }
 
+    /** Number of allocated entries, including the reserve. */
+    int numAllocated() const
+    {
+        return allocated;
+    }
+
+    /** Number of entries the queue holds before being full. */
+    int capacity() const
+    {
+        return numEntries - numReserve;
+    }
+
     /**
      * Find the first entry that matches the provided address.
      *
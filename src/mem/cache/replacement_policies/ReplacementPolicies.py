@@ -175,3 +175,68 @@ class WeightedLRURP(LRURP):
     type = "WeightedLRURP"
     cxx_class = "gem5::replacement_policy::WeightedLRU"
     cxx_header = "mem/cache/replacement_policies/weighted_lru_rp.hh"
+
+
+class PackedLRURP(BaseReplacementPolicy):
+    type = "PackedLRURP"
+    cxx_class = "gem5::replacement_policy::PackedLRU"
+    cxx_header = "mem/cache/replacement_policies/packed_lru_rp.hh"
+    num_ways = Param.Int(Parent.assoc, "Number of ways in each set")
+
+
+class PackedTreePLRURP(BaseReplacementPolicy):
+    type = "PackedTreePLRURP"
+    cxx_class = "gem5::replacement_policy::PackedTreePLRU"
+    cxx_header = "mem/cache/replacement_policies/packed_tree_plru_rp.hh"
+    num_ways = Param.Int(Parent.assoc, "Number of ways in each set")
+
+
+class PackedBRRIPRP(BRRIPRP):
+    type = "PackedBRRIPRP"
+    cxx_class = "gem5::replacement_policy::PackedBRRIP"
+    cxx_header = "mem/cache/replacement_policies/packed_brrip_rp.hh"
+    num_ways = Param.Int(Parent.assoc, "Number of ways in each set")
+
+
+class PackedRRIPRP(PackedBRRIPRP):
+    btp = 100
+
+
+class PackedDRRIPRP(DuelingRP):
+    # See DRRIPRP for how to set the constituency_size and the team_size
+    replacement_policy_a = PackedBRRIPRP()
+    replacement_policy_b = PackedRRIPRP()
+
+
+class PackedNRURP(PackedBRRIPRP):
+    btp = 100
+    num_bits = 1
+
+
+class PackedSHiPRP(PackedBRRIPRP):
+    type = "PackedSHiPRP"
+    abstract = True
+    cxx_class = "gem5::replacement_policy::PackedSHiP"
+    cxx_header = "mem/cache/replacement_policies/packed_ship_rp.hh"
+
+    shct_size = Param.Unsigned(16384, "Number of SHCT entries")
+    # By default any value greater than 0 is enough to change insertion policy
+    insertion_threshold = Param.Percent(
+        1, "Percentage at which an entry changes insertion policy"
+    )
+    # Always make hits mark entries as last to be evicted
+    hit_priority = True
+    # Let the predictor decide when to change insertion policy
+    btp = 0
+
+
+class PackedSHiPMemRP(PackedSHiPRP):
+    type = "PackedSHiPMemRP"
+    cxx_class = "gem5::replacement_policy::PackedSHiPMem"
+    cxx_header = "mem/cache/replacement_policies/packed_ship_rp.hh"
+
+
+class PackedSHiPPCRP(PackedSHiPRP):
+    type = "PackedSHiPPCRP"
+    cxx_class = "gem5::replacement_policy::PackedSHiPPC"
+    cxx_header = "mem/cache/replacement_policies/packed_ship_rp.hh"
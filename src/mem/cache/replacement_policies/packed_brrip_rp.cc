@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/packed_brrip_rp.hh"
+
+#include "base/logging.hh"
+#include "base/random.hh"
+#include "params/PackedBRRIPRP.hh"
+
+namespace gem5
+{
+
+namespace replacement_policy
+{
+
+PackedBRRIP::PackedBRRIP(const Params &p)
+  : Packed(p, p.num_ways), numRRPVBits(p.num_bits),
+    hitPriority(p.hit_priority), btp(p.btp), maxRRPV(mask(p.num_bits)),
+    lsbs(fieldLsbs(numWays, numRRPVBits)),
+    validShift(numWays * numRRPVBits)
+{
+    fatal_if(p.num_bits <= 0, "There should be at least one bit per RRPV.\n");
+    fatal_if(numWays * (numRRPVBits + 1) > 64,
+             "The RRPVs and valid bits of %d ways of %d-bit RRPVs do not "
+             "fit in a word.", numWays, numRRPVBits);
+}
+
+uint64_t
+PackedBRRIP::getRRPV(const PackedReplData &data) const
+{
+    return getField(*data.state, data.way, numRRPVBits);
+}
+
+void
+PackedBRRIP::setRRPV(const PackedReplData &data, uint64_t rrpv) const
+{
+    setField(*data.state, data.way, numRRPVBits, rrpv);
+}
+
+uint64_t
+PackedBRRIP::saturated(uint64_t rrpvs) const
+{
+    // An RRPV is saturated when all of its bits are set
+    uint64_t all_set = rrpvs;
+    for (unsigned i = 1; i < numRRPVBits; i++) {
+        all_set &= rrpvs >> i;
+    }
+    return all_set & lsbs;
+}
+
+void
+PackedBRRIP::invalidate(
+    const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    const PackedReplData &data = packedData(replacement_data);
+
+    // Invalidate entry
+    replaceBits(*data.state, validShift + data.way, 0);
+}
+
+void
+PackedBRRIP::touch(const std::shared_ptr<ReplacementData>& replacement_data)
+const
+{
+    const PackedReplData &data = packedData(replacement_data);
+
+    // Update RRPV if not 0 yet
+    // Every hit in HP mode makes the entry the last to be evicted, while
+    // in FP mode a hit makes the entry less likely to be evicted
+    const uint64_t rrpv = getRRPV(data);
+    if (hitPriority) {
+        setRRPV(data, 0);
+    } else if (rrpv > 0) {
+        setRRPV(data, rrpv - 1);
+    }
+}
+
+void
+PackedBRRIP::reset(const std::shared_ptr<ReplacementData>& replacement_data)
+const
+{
+    const PackedReplData &data = packedData(replacement_data);
+
+    // Reset RRPV
+    // Replacement data is inserted as "long re-reference" if lower than btp,
+    // "distant re-reference" otherwise
+    uint64_t rrpv = maxRRPV;
+    if (random_mt.random<unsigned>(1, 100) <= btp) {
+        rrpv--;
+    }
+    setRRPV(data, rrpv);
+
+    // Mark entry as ready to be used
+    replaceBits(*data.state, validShift + data.way, 1);
+}
+
+ReplaceableEntry*
+PackedBRRIP::getVictim(const ReplacementCandidates& candidates) const
+{
+    uint64_t &state = setState(candidates);
+
+    // Pick the first invalid entry if there is any
+    const uint64_t invalid = ~(state >> validShift) & mask(numWays);
+    if (invalid) {
+        return candidates[findLsbSet(invalid)];
+    }
+
+    // Age all the entries until one of them reaches the distant
+    // re-reference RRPV. No RRPV can overflow, since the highest one
+    // saturates first.
+    uint64_t rrpvs = state & mask(validShift);
+    uint64_t victims;
+    while (!(victims = saturated(rrpvs))) {
+        rrpvs += lsbs;
+    }
+    state = (state & ~mask(validShift)) | rrpvs;
+
+    return candidates[findLsbSet(victims) / numRRPVBits];
+}
+
+std::shared_ptr<ReplacementData>
+PackedBRRIP::instantiateEntry()
+{
+    // All the entries start invalid
+    return instantiatePacked(0);
+}
+
+} // namespace replacement_policy
+} // namespace gem5
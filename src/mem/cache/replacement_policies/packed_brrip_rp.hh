@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a Re-Reference Interval Prediction replacement policy
+ * whose RRPVs are packed in one word per set.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_BRRIP_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_BRRIP_RP_HH__
+
+#include <cstdint>
+
+#include "mem/cache/replacement_policies/packed_rp.hh"
+
+namespace gem5
+{
+
+struct PackedBRRIPRPParams;
+
+namespace replacement_policy
+{
+
+/**
+ * A BRRIP (and RRIP and NRU, see BRRIP) making the same decisions as the
+ * BRRIP, with the RRPVs of a set packed in the low numWays * numRRPVBits
+ * bits of its state and the valid bits of its ways right above them.
+ * Looking for the entries with a saturated RRPV, and aging the whole set
+ * when there is none, are done on all the RRPVs at once.
+ *
+ * The RRPVs and the valid bits of a set must fit in a word, e.g., sets of
+ * up to 21 ways with 2-bit RRPVs.
+ */
+class PackedBRRIP : public Packed
+{
+  protected:
+    /** Number of RRPV bits. */
+    const unsigned numRRPVBits;
+
+    /** Hit priority (HP) policy replaces entries that do not receive
+     *  cache hits over any cache entry that receives a hit, while the
+     *  frequency priority (FP) policy replaces infrequently re-referenced
+     *  entries. */
+    const bool hitPriority;
+
+    /** Bimodal throtle parameter. Value in the range [0,100] used to
+     *  decide if a new entry is inserted with long or distant re-reference.
+     */
+    const unsigned btp;
+
+    /** Distant re-reference RRPV, i.e., the saturated value of an RRPV. */
+    const uint64_t maxRRPV;
+
+    /** Lowest bit of every RRPV of a set. */
+    const uint64_t lsbs;
+
+    /** Position of the valid bit of the first way of a set. */
+    const unsigned validShift;
+
+    /**
+     * Get the RRPV of an entry.
+     *
+     * @param data Replacement data of the entry.
+     * @return The RRPV of the entry.
+     */
+    uint64_t getRRPV(const PackedReplData &data) const;
+
+    /**
+     * Set the RRPV of an entry.
+     *
+     * @param data Replacement data of the entry.
+     * @param rrpv The new RRPV of the entry.
+     */
+    void setRRPV(const PackedReplData &data, uint64_t rrpv) const;
+
+    /**
+     * Find the entries of a set whose RRPV is saturated.
+     *
+     * @param rrpvs The packed RRPVs of a set.
+     * @return The lowest bit of each saturated RRPV.
+     */
+    uint64_t saturated(uint64_t rrpvs) const;
+
+  public:
+    typedef PackedBRRIPRPParams Params;
+    PackedBRRIP(const Params &p);
+    ~PackedBRRIP() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     * Clears the valid bit of the entry.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Decreases (or clears in HP mode) the RRPV of the entry.
+     *
+     * @param replacement_data Replacement data to be touched.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Sets the RRPV of the entry as in the BRRIP and marks it valid.
+     *
+     * @param replacement_data Replacement data to be reset.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find replacement victim using the packed RRPVs. The first invalid
+     * way is chosen if there is any. Otherwise, the set is aged until an
+     * RRPV saturates, and the first saturated way is chosen.
+     *
+     * @param candidates Replacement candidates, the ways of a set.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    /**
+     * Instantiate a replacement data entry.
+     *
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_BRRIP_RP_HH__
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/packed_lru_rp.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+#include "params/PackedLRURP.hh"
+
+namespace gem5
+{
+
+namespace replacement_policy
+{
+
+PackedLRU::PackedLRU(const Params &p)
+  : Packed(p, p.num_ways),
+    wayBits(std::max(1, ceilLog2(p.num_ways))),
+    lsbs(fieldLsbs(numWays, wayBits)), msbs(lsbs << (wayBits - 1))
+{
+    fatal_if(numWays * wayBits > 64,
+             "A packed LRU supports at most 16 ways, got %d.", numWays);
+}
+
+unsigned
+PackedLRU::position(uint64_t state, unsigned way) const
+{
+    // The field holding the way is the only zero field of the xored
+    // stack. Subtracting one from every field only borrows out of a zero
+    // field, and no field below the first zero one borrows, so the lowest
+    // flagged field is the one we are looking for.
+    const uint64_t fields = state ^ (lsbs * way);
+    const uint64_t zeros = (fields - lsbs) & ~fields & msbs;
+    assert(zeros);
+    return findLsbSet(zeros) / wayBits;
+}
+
+void
+PackedLRU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    const PackedReplData &data = packedData(replacement_data);
+    uint64_t &state = *data.state;
+
+    // Move the entries that were less recently used up one position, and
+    // place this entry at the LRU position
+    const unsigned pos = position(state, data.way);
+    const uint64_t below = state & mask(pos * wayBits);
+    const uint64_t above = (state >> wayBits) &
+        mask((numWays - 1) * wayBits) & ~mask(pos * wayBits);
+    state = below | above |
+        (uint64_t(data.way) << ((numWays - 1) * wayBits));
+}
+
+void
+PackedLRU::touch(const std::shared_ptr<ReplacementData>& replacement_data)
+const
+{
+    const PackedReplData &data = packedData(replacement_data);
+    uint64_t &state = *data.state;
+
+    // Move the entries that were more recently used down one position, and
+    // place this entry at the MRU position
+    const unsigned pos = position(state, data.way);
+    const uint64_t above = state & ~mask((pos + 1) * wayBits);
+    const uint64_t below = (state & mask(pos * wayBits)) << wayBits;
+    state = above | below | data.way;
+}
+
+void
+PackedLRU::reset(const std::shared_ptr<ReplacementData>& replacement_data)
+const
+{
+    // A reset has the same functionality of a touch
+    touch(replacement_data);
+}
+
+ReplaceableEntry*
+PackedLRU::getVictim(const ReplacementCandidates& candidates) const
+{
+    const uint64_t state = setState(candidates);
+    return candidates[getField(state, numWays - 1, wayBits)];
+}
+
+std::shared_ptr<ReplacementData>
+PackedLRU::instantiateEntry()
+{
+    // Way 0 is the first victim and the last way the MRU
+    uint64_t state = 0;
+    for (unsigned pos = 0; pos < numWays; pos++) {
+        setField(state, pos, wayBits, numWays - 1 - pos);
+    }
+    return instantiatePacked(state);
+}
+
+} // namespace replacement_policy
+} // namespace gem5
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a Least Recently Used replacement policy whose state is
+ * packed in one word per set.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_LRU_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_LRU_RP_HH__
+
+#include "mem/cache/replacement_policies/packed_rp.hh"
+
+namespace gem5
+{
+
+struct PackedLRURPParams;
+
+namespace replacement_policy
+{
+
+/**
+ * A LRU that keeps, for each set, a recency stack of way ids packed in a
+ * word: the field at position 0 holds the most recently used way, and the
+ * field at the last position holds the victim. Finding the position of a
+ * way is done on all the fields at once, by looking for a zero field in
+ * the word xored with the way id replicated in every field.
+ *
+ * Each id takes ceil(log2(ways)) bits, so sets of up to 16 ways fit in a
+ * word. Unlike the LRU, which gives all the invalidated entries the same
+ * timestamp, the most recently invalidated entry is the next victim.
+ */
+class PackedLRU : public Packed
+{
+  protected:
+    /** Number of bits of a way id. */
+    const unsigned wayBits;
+
+    /** Lowest bit of every position of the stack. */
+    const uint64_t lsbs;
+
+    /** Highest bit of every position of the stack. */
+    const uint64_t msbs;
+
+    /**
+     * Find the position of a way in the recency stack of its set.
+     *
+     * @param state Packed recency stack.
+     * @param way The way to look for.
+     * @return The position of the way, 0 being the MRU.
+     */
+    unsigned position(uint64_t state, unsigned way) const;
+
+  public:
+    typedef PackedLRURPParams Params;
+    PackedLRU(const Params &p);
+    ~PackedLRU() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     * Moves the entry to the LRU position of its set.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Moves the entry to the MRU position of its set.
+     *
+     * @param replacement_data Replacement data to be touched.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Moves the entry to the MRU position of its set.
+     *
+     * @param replacement_data Replacement data to be reset.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find replacement victim by reading the LRU position of the set.
+     *
+     * @param candidates Replacement candidates, the ways of a set.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    /**
+     * Instantiate a replacement data entry.
+     *
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_LRU_RP_HH__
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a common base for the replacement policies that keep the
+ * state of a whole set packed in a single word.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_RP_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/logging.hh"
+#include "mem/cache/replacement_policies/base.hh"
+
+namespace gem5
+{
+
+namespace replacement_policy
+{
+
+/**
+ * Base of the replacement policies whose state is a few bits per way,
+ * such as a recency position, a PLRU tree bit or an RRPV. Instead of
+ * being spread over a replacement data object per entry, the state of all
+ * the ways of a set is packed in one 64-bit word, so that the victim is
+ * found with a few bit operations on that word rather than by visiting
+ * every candidate.
+ *
+ * The replacement data of an entry only locates the entry within the
+ * word of its set. The data of all the ways of a set are allocated in a
+ * single block together with the word, and share its reference count.
+ *
+ * As with the TreePLRU, entries are assumed to be instantiated set by set
+ * and in way order, and the replacement candidates to be the ways of a
+ * single set in way order, which is what set associative tags do.
+ */
+class Packed : public Base
+{
+  protected:
+    /** Replacement data of an entry of a packed set. */
+    struct PackedReplData : ReplacementData
+    {
+        /** Packed state of the set the entry belongs to. */
+        uint64_t *state = nullptr;
+
+        /** Way of the entry within its set. */
+        unsigned way = 0;
+    };
+
+    /** Number of ways in a set. */
+    const unsigned numWays;
+
+    /**
+     * Get the packed replacement data of an entry.
+     *
+     * @param replacement_data Replacement data of the entry.
+     * @return The replacement data, cast to the policy's type.
+     */
+    template <typename Data=PackedReplData>
+    static Data &
+    packedData(const std::shared_ptr<ReplacementData> &replacement_data)
+    {
+        return static_cast<Data &>(*replacement_data);
+    }
+
+    /**
+     * Get the packed state of the set the candidates belong to.
+     *
+     * @param candidates Replacement candidates, one per way of the set.
+     * @return The packed state of the set.
+     */
+    uint64_t &
+    setState(const ReplacementCandidates &candidates) const
+    {
+        panic_if(candidates.size() != numWays,
+                 "Packed replacement state needs all the ways of a set, "
+                 "got %d candidates for %d ways.",
+                 candidates.size(), numWays);
+        uint64_t *state = packedData(candidates[0]->replacementData).state;
+        for ([[maybe_unused]] const auto &candidate : candidates) {
+            assert(packedData(candidate->replacementData).state == state);
+        }
+        return *state;
+    }
+
+    /**
+     * Get the value of a field of the packed state.
+     *
+     * @param state Packed state of a set.
+     * @param index Index of the field.
+     * @param width Width of the fields.
+     */
+    static uint64_t
+    getField(uint64_t state, unsigned index, unsigned width)
+    {
+        return bits(state, index * width + width - 1, index * width);
+    }
+
+    /**
+     * Set the value of a field of the packed state.
+     *
+     * @param state Packed state of a set.
+     * @param index Index of the field.
+     * @param width Width of the fields.
+     * @param value New value of the field.
+     */
+    static void
+    setField(uint64_t &state, unsigned index, unsigned width, uint64_t value)
+    {
+        replaceBits(state, index * width + width - 1, index * width, value);
+    }
+
+    /**
+     * Get a word with the lowest bit of each of the first fields set.
+     *
+     * @param num_fields Number of fields.
+     * @param width Width of the fields.
+     */
+    static uint64_t
+    fieldLsbs(unsigned num_fields, unsigned width)
+    {
+        uint64_t lsbs = 0;
+        for (unsigned i = 0; i < num_fields; i++) {
+            lsbs |= 1ULL << (i * width);
+        }
+        return lsbs;
+    }
+
+    /**
+     * Instantiate the replacement data of the next entry. The state and
+     * the data of all the ways of a set are allocated along with the
+     * first way of the set.
+     *
+     * @param initial_state Packed state of a new set.
+     * @return A shared pointer to the new replacement data.
+     */
+    template <typename Data=PackedReplData>
+    std::shared_ptr<ReplacementData>
+    instantiatePacked(uint64_t initial_state)
+    {
+        struct Set
+        {
+            uint64_t state;
+            std::vector<Data> ways;
+        };
+
+        const unsigned way = count++ % numWays;
+        if (way == 0) {
+            auto set = std::make_shared<Set>();
+            set->state = initial_state;
+            set->ways.resize(numWays);
+            for (unsigned i = 0; i < numWays; i++) {
+                set->ways[i].state = &set->state;
+                set->ways[i].way = i;
+            }
+            currentSet = set;
+        }
+
+        // Share the ownership of the whole set
+        auto set = std::static_pointer_cast<Set>(currentSet);
+        return std::shared_ptr<ReplacementData>(set, &set->ways[way]);
+    }
+
+  private:
+    /** Number of entries instantiated so far. */
+    uint64_t count;
+
+    /** Set whose entries are being instantiated. */
+    std::shared_ptr<void> currentSet;
+
+  public:
+    Packed(const Params &p, unsigned num_ways)
+      : Base(p), numWays(num_ways), count(0)
+    {
+        fatal_if(numWays == 0, "A set must have at least one way");
+    }
+    ~Packed() = default;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_RP_HH__
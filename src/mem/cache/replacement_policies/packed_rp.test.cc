@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/cache/replacement_policies/brrip_rp.hh"
+#include "mem/cache/replacement_policies/lru_rp.hh"
+#include "mem/cache/replacement_policies/packed_brrip_rp.hh"
+#include "mem/cache/replacement_policies/packed_lru_rp.hh"
+#include "mem/cache/replacement_policies/packed_ship_rp.hh"
+#include "mem/cache/replacement_policies/packed_tree_plru_rp.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "mem/cache/replacement_policies/ship_rp.hh"
+#include "mem/cache/replacement_policies/tree_plru_rp.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+#include "params/BRRIPRP.hh"
+#include "params/LRURP.hh"
+#include "params/PackedBRRIPRP.hh"
+#include "params/PackedLRURP.hh"
+#include "params/PackedSHiPMemRP.hh"
+#include "params/PackedSHiPPCRP.hh"
+#include "params/PackedTreePLRURP.hh"
+#include "params/SHiPMemRP.hh"
+#include "params/SHiPPCRP.hh"
+#include "params/TreePLRURP.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+GTestTickHandler tickHandler;
+
+const unsigned numSets = 4;
+const unsigned numWays = 8;
+
+/**
+ * Tags of a small set associative cache, whose entries are replaced by a
+ * packed policy and by its unpacked counterpart at the same time. Every
+ * access is applied to both policies, and both must choose the same
+ * victims.
+ */
+class PairedTags
+{
+  private:
+    replacement_policy::Base &packed;
+    replacement_policy::Base &unpacked;
+
+    /** Entries of each policy, set by set. */
+    std::vector<ReplaceableEntry> packedEntries;
+    std::vector<ReplaceableEntry> unpackedEntries;
+
+    /** Tag of each entry, if it is valid. */
+    std::vector<Addr> tags;
+    std::vector<bool> valid;
+
+    Tick tick = 1;
+
+    ReplacementCandidates
+    candidates(std::vector<ReplaceableEntry> &entries, unsigned set)
+    {
+        ReplacementCandidates cands;
+        for (unsigned way = 0; way < numWays; way++)
+            cands.push_back(&entries[set * numWays + way]);
+        return cands;
+    }
+
+    /** Give every access its own tick, for the policies that use it. */
+    void
+    advance()
+    {
+        tickHandler.setCurTick(tick++);
+    }
+
+  public:
+    PairedTags(replacement_policy::Base &packed_rp,
+               replacement_policy::Base &unpacked_rp)
+      : packed(packed_rp), unpacked(unpacked_rp),
+        packedEntries(numSets * numWays),
+        unpackedEntries(numSets * numWays),
+        tags(numSets * numWays), valid(numSets * numWays, false)
+    {
+        advance();
+        for (unsigned i = 0; i < numSets * numWays; i++) {
+            packedEntries[i].setPosition(i / numWays, i % numWays);
+            packedEntries[i].replacementData = packed.instantiateEntry();
+            unpackedEntries[i].setPosition(i / numWays, i % numWays);
+            unpackedEntries[i].replacementData = unpacked.instantiateEntry();
+        }
+    }
+
+    /**
+     * Access a line, replacing an entry of its set on a miss.
+     *
+     * @param line Line address.
+     * @param pc PC of the access.
+     */
+    void
+    access(Addr line, Addr pc)
+    {
+        advance();
+
+        const unsigned set = line % numSets;
+        const Addr tag = line / numSets;
+        RequestPtr req = std::make_shared<Request>(
+            line * 64, 8, 0, Request::funcRequestorId);
+        req->setPC(pc);
+        Packet pkt(req, MemCmd::ReadReq);
+
+        for (unsigned way = 0; way < numWays; way++) {
+            const unsigned i = set * numWays + way;
+            if (valid[i] && tags[i] == tag) {
+                packed.touch(packedEntries[i].replacementData, &pkt);
+                unpacked.touch(unpackedEntries[i].replacementData, &pkt);
+                return;
+            }
+        }
+
+        ReplaceableEntry *packed_victim =
+            packed.getVictim(candidates(packedEntries, set));
+        ReplaceableEntry *unpacked_victim =
+            unpacked.getVictim(candidates(unpackedEntries, set));
+        ASSERT_EQ(packed_victim->getWay(), unpacked_victim->getWay());
+
+        const unsigned i = set * numWays + packed_victim->getWay();
+        if (valid[i]) {
+            packed.invalidate(packed_victim->replacementData);
+            unpacked.invalidate(unpacked_victim->replacementData);
+        }
+        packed.reset(packed_victim->replacementData, &pkt);
+        unpacked.reset(unpacked_victim->replacementData, &pkt);
+        tags[i] = tag;
+        valid[i] = true;
+    }
+
+    /**
+     * Invalidate an entry, as a coherence invalidation would. The LRU
+     * breaks the tie between invalid entries by way order while the
+     * packed LRU evicts the most recently invalidated entry first, so
+     * this is only done when all the other entries of the set are
+     * valid.
+     *
+     * @param set Set of the entry.
+     * @param way Way of the entry.
+     */
+    void
+    invalidate(unsigned set, unsigned way)
+    {
+        advance();
+
+        for (unsigned w = 0; w < numWays; w++) {
+            if (!valid[set * numWays + w])
+                return;
+        }
+
+        const unsigned i = set * numWays + way;
+        packed.invalidate(packedEntries[i].replacementData);
+        unpacked.invalidate(unpackedEntries[i].replacementData);
+        valid[i] = false;
+    }
+
+    /**
+     * Run a random mix of accesses, with some reuse, and invalidations.
+     *
+     * @param seed Seed of the access stream.
+     */
+    void
+    run(unsigned seed)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<Addr> line_dist(
+            0, 3 * numSets * numWays);
+        std::uniform_int_distribution<Addr> pc_dist(0, 15);
+        std::uniform_int_distribution<unsigned> op_dist(0, 99);
+        std::uniform_int_distribution<unsigned> set_dist(0, numSets - 1);
+        std::uniform_int_distribution<unsigned> way_dist(0, numWays - 1);
+
+        for (int n = 0; n < 20000; n++) {
+            if (op_dist(gen) < 5) {
+                invalidate(set_dist(gen), way_dist(gen));
+            } else {
+                access(line_dist(gen), pc_dist(gen) * 4);
+            }
+            if (::testing::Test::HasFatalFailure())
+                return;
+        }
+    }
+};
+
+/** Fill in the parameters shared by all the policies. */
+template <typename Params>
+Params
+rpParams(const char *name)
+{
+    Params p;
+    p.name = name;
+    p.eventq_index = 0;
+    return p;
+}
+
+} // anonymous namespace
+
+TEST(PackedReplacementPolicyTest, LRU)
+{
+    auto packed_p = rpParams<PackedLRURPParams>("packed");
+    packed_p.num_ways = numWays;
+    auto unpacked_p = rpParams<LRURPParams>("unpacked");
+
+    replacement_policy::PackedLRU packed(packed_p);
+    replacement_policy::LRU unpacked(unpacked_p);
+    PairedTags(packed, unpacked).run(1);
+}
+
+TEST(PackedReplacementPolicyTest, TreePLRU)
+{
+    auto packed_p = rpParams<PackedTreePLRURPParams>("packed");
+    packed_p.num_ways = numWays;
+    auto unpacked_p = rpParams<TreePLRURPParams>("unpacked");
+    unpacked_p.num_leaves = numWays;
+
+    replacement_policy::PackedTreePLRU packed(packed_p);
+    replacement_policy::TreePLRU unpacked(unpacked_p);
+    PairedTags(packed, unpacked).run(2);
+}
+
+/**
+ * The insertion of the (B)RRIP is random unless btp is 0 or 100, and the
+ * two policies do not draw the same random numbers, so only the
+ * deterministic configurations are compared.
+ */
+void
+compareBRRIP(int num_bits, bool hit_priority, unsigned btp)
+{
+    auto packed_p = rpParams<PackedBRRIPRPParams>("packed");
+    packed_p.num_ways = numWays;
+    packed_p.num_bits = num_bits;
+    packed_p.hit_priority = hit_priority;
+    packed_p.btp = btp;
+    auto unpacked_p = rpParams<BRRIPRPParams>("unpacked");
+    unpacked_p.num_bits = num_bits;
+    unpacked_p.hit_priority = hit_priority;
+    unpacked_p.btp = btp;
+
+    replacement_policy::PackedBRRIP packed(packed_p);
+    replacement_policy::BRRIP unpacked(unpacked_p);
+    PairedTags(packed, unpacked).run(num_bits * 1000 + btp + hit_priority);
+}
+
+TEST(PackedReplacementPolicyTest, BRRIP)
+{
+    compareBRRIP(2, false, 0);
+    compareBRRIP(2, true, 0);
+    compareBRRIP(3, false, 0);
+}
+
+TEST(PackedReplacementPolicyTest, RRIP)
+{
+    compareBRRIP(2, false, 100);
+    compareBRRIP(2, true, 100);
+}
+
+TEST(PackedReplacementPolicyTest, NRU)
+{
+    compareBRRIP(1, false, 100);
+}
+
+/** Fill in the parameters of a SHiP, as in ReplacementPolicies.py. */
+template <typename Params>
+Params
+shipParams(const char *name)
+{
+    Params p = rpParams<Params>(name);
+    p.num_bits = 2;
+    p.hit_priority = true;
+    p.btp = 0;
+    p.shct_size = 16;
+    p.insertion_threshold = 1;
+    return p;
+}
+
+TEST(PackedReplacementPolicyTest, SHiPMem)
+{
+    auto packed_p = shipParams<PackedSHiPMemRPParams>("packed");
+    packed_p.num_ways = numWays;
+    auto unpacked_p = shipParams<SHiPMemRPParams>("unpacked");
+
+    replacement_policy::PackedSHiPMem packed(packed_p);
+    replacement_policy::SHiPMem unpacked(unpacked_p);
+    PairedTags(packed, unpacked).run(3);
+}
+
+TEST(PackedReplacementPolicyTest, SHiPPC)
+{
+    auto packed_p = shipParams<PackedSHiPPCRPParams>("packed");
+    packed_p.num_ways = numWays;
+    auto unpacked_p = shipParams<SHiPPCRPParams>("unpacked");
+
+    replacement_policy::PackedSHiPPC packed(packed_p);
+    replacement_policy::SHiPPC unpacked(unpacked_p);
+    PairedTags(packed, unpacked).run(4);
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/packed_ship_rp.hh"
+
+#include "base/logging.hh"
+#include "params/PackedSHiPMemRP.hh"
+#include "params/PackedSHiPPCRP.hh"
+#include "params/PackedSHiPRP.hh"
+
+namespace gem5
+{
+
+namespace replacement_policy
+{
+
+PackedSHiP::PackedSHiP(const Params &p)
+  : PackedBRRIP(p), insertionThreshold(p.insertion_threshold / 100.0),
+    SHCT(p.shct_size, SatCounter8(numRRPVBits))
+{
+}
+
+void
+PackedSHiP::invalidate(
+    const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    const auto &data = packedData<PackedSHiPReplData>(replacement_data);
+
+    // The predictor is detrained when an entry that has not been re-
+    // referenced since insertion is invalidated
+    if (data.outcome) {
+        SHCT[data.signature]--;
+    }
+
+    PackedBRRIP::invalidate(replacement_data);
+}
+
+void
+PackedSHiP::touch(const std::shared_ptr<ReplacementData>& replacement_data,
+    const PacketPtr pkt)
+{
+    auto &data = packedData<PackedSHiPReplData>(replacement_data);
+
+    // When a hit happens the SHCT entry indexed by the signature is
+    // incremented
+    SHCT[getSignature(pkt)]++;
+    data.outcome = true;
+
+    // This was a hit; update replacement data accordingly
+    PackedBRRIP::touch(replacement_data);
+}
+
+void
+PackedSHiP::touch(const std::shared_ptr<ReplacementData>& replacement_data)
+    const
+{
+    panic("Cant train SHiP's predictor without access information.");
+}
+
+void
+PackedSHiP::reset(const std::shared_ptr<ReplacementData>& replacement_data,
+    const PacketPtr pkt)
+{
+    auto &data = packedData<PackedSHiPReplData>(replacement_data);
+
+    // Store signature and reset outcome
+    const SignatureType signature = getSignature(pkt);
+    data.signature = signature;
+    data.outcome = false;
+
+    // If SHCT for signature is set, predict intermediate re-reference.
+    // Predict distant re-reference otherwise
+    PackedBRRIP::reset(replacement_data);
+    const uint64_t rrpv = getRRPV(data);
+    if (SHCT[signature].calcSaturation() >= insertionThreshold && rrpv > 0) {
+        setRRPV(data, rrpv - 1);
+    }
+}
+
+void
+PackedSHiP::reset(const std::shared_ptr<ReplacementData>& replacement_data)
+    const
+{
+    panic("Cant train SHiP's predictor without access information.");
+}
+
+std::shared_ptr<ReplacementData>
+PackedSHiP::instantiateEntry()
+{
+    return instantiatePacked<PackedSHiPReplData>(0);
+}
+
+PackedSHiPMem::PackedSHiPMem(const PackedSHiPMemRPParams &p) : PackedSHiP(p)
+{
+}
+
+PackedSHiP::SignatureType
+PackedSHiPMem::getSignature(const PacketPtr pkt) const
+{
+    return static_cast<SignatureType>(pkt->getAddr() % SHCT.size());
+}
+
+PackedSHiPPC::PackedSHiPPC(const PackedSHiPPCRPParams &p) : PackedSHiP(p) {}
+
+PackedSHiP::SignatureType
+PackedSHiPPC::getSignature(const PacketPtr pkt) const
+{
+    SignatureType signature;
+
+    if (pkt->req->hasPC()) {
+        signature = static_cast<SignatureType>(pkt->req->getPC());
+    } else {
+        signature = NO_PC_SIGNATURE;
+    }
+
+    return signature % SHCT.size();
+}
+
+} // namespace replacement_policy
+} // namespace gem5
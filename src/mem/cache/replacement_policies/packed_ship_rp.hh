@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the SHiP replacement policy on top of the packed BRRIP.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_SHIP_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_SHIP_RP_HH__
+
+#include <cstddef>
+#include <vector>
+
+#include "base/sat_counter.hh"
+#include "mem/cache/replacement_policies/packed_brrip_rp.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+struct PackedSHiPRPParams;
+struct PackedSHiPMemRPParams;
+struct PackedSHiPPCRPParams;
+
+namespace replacement_policy
+{
+
+/**
+ * A SHiP (see SHiP) whose RRPVs are packed as in the PackedBRRIP. The
+ * signature and outcome of each entry are kept next to the location of
+ * the entry in its set, as they are only needed on hits, insertions and
+ * invalidations, not when looking for a victim.
+ */
+class PackedSHiP : public PackedBRRIP
+{
+  protected:
+    typedef std::size_t SignatureType;
+
+    /** SHiP-specific implementation of packed replacement data. */
+    struct PackedSHiPReplData : PackedReplData
+    {
+        /** Signature that caused the insertion of this entry. */
+        SignatureType signature = 0;
+
+        /** Outcome of insertion; set to one if entry is re-referenced. */
+        bool outcome = false;
+    };
+
+    /**
+     * Saturation percentage at which an entry starts being inserted as
+     * intermediate re-reference.
+     */
+    const double insertionThreshold;
+
+    /**
+     * Signature History Counter Table; learns the re-reference behavior
+     * of a signature. A zero entry provides a strong indication that
+     * future lines brought by that signature will not receive any hits.
+     */
+    std::vector<SatCounter8> SHCT;
+
+    /**
+     * Extract signature from packet.
+     *
+     * @param pkt The packet to extract a signature from.
+     * @return The signature extracted.
+     */
+    virtual SignatureType getSignature(const PacketPtr pkt) const = 0;
+
+  public:
+    typedef PackedSHiPRPParams Params;
+    PackedSHiP(const Params &p);
+    ~PackedSHiP() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     * Updates predictor and invalidate data.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Updates predictor and assigns RRPV values of Table 3.
+     *
+     * @param replacement_data Replacement data to be touched.
+     * @param pkt Packet that generated this hit.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data,
+        const PacketPtr pkt) override;
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+        override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Updates predictor and assigns RRPV values of Table 3.
+     *
+     * @param replacement_data Replacement data to be reset.
+     * @param pkt Packet that generated this miss.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data,
+        const PacketPtr pkt) override;
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+        override;
+
+    /**
+     * Instantiate a replacement data entry.
+     *
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+/** Packed SHiP that uses memory addresses as signatures. */
+class PackedSHiPMem : public PackedSHiP
+{
+  protected:
+    SignatureType getSignature(const PacketPtr pkt) const override;
+
+  public:
+    PackedSHiPMem(const PackedSHiPMemRPParams &p);
+    ~PackedSHiPMem() = default;
+};
+
+/** Packed SHiP that uses PCs as signatures. */
+class PackedSHiPPC : public PackedSHiP
+{
+  private:
+    /** Signature to be used when no PC is provided in an access. */
+    const SignatureType NO_PC_SIGNATURE = 0;
+
+  protected:
+    SignatureType getSignature(const PacketPtr pkt) const override;
+
+  public:
+    PackedSHiPPC(const PackedSHiPPCRPParams &p);
+    ~PackedSHiPPC() = default;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_SHIP_RP_HH__
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/packed_tree_plru_rp.hh"
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "params/PackedTreePLRURP.hh"
+
+namespace gem5
+{
+
+namespace replacement_policy
+{
+
+PackedTreePLRU::PackedTreePLRU(const Params &p)
+  : Packed(p, p.num_ways), numLevels(floorLog2(p.num_ways)),
+    pathMask(numWays, 0), pathRight(numWays, 0)
+{
+    fatal_if(!isPowerOf2(numWays),
+             "Number of ways must be non-zero and a power of 2");
+    fatal_if(numWays > 64,
+             "A packed tree PLRU supports at most 64 ways, got %d.",
+             numWays);
+
+    // Nodes are numbered as in the TreePLRU: the children of node i are
+    // 2i + 1 and 2i + 2, and the leaves follow the numWays - 1 nodes
+    for (unsigned way = 0; way < numWays; way++) {
+        uint64_t node = way + numWays - 1;
+        while (node != 0) {
+            const bool right = node % 2 == 0;
+            node = (node - 1) / 2;
+            pathMask[way] |= 1ULL << node;
+            if (right) {
+                pathRight[way] |= 1ULL << node;
+            }
+        }
+    }
+}
+
+void
+PackedTreePLRU::invalidate(
+    const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    const PackedReplData &data = packedData(replacement_data);
+    uint64_t &state = *data.state;
+
+    // Make every node on the path point to the entry
+    state = (state & ~pathMask[data.way]) | pathRight[data.way];
+}
+
+void
+PackedTreePLRU::touch(
+    const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    const PackedReplData &data = packedData(replacement_data);
+    uint64_t &state = *data.state;
+
+    // Make every node on the path point away from the entry
+    state = (state & ~pathMask[data.way]) |
+        (pathMask[data.way] & ~pathRight[data.way]);
+}
+
+void
+PackedTreePLRU::reset(
+    const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    // A reset has the same functionality of a touch
+    touch(replacement_data);
+}
+
+ReplaceableEntry*
+PackedTreePLRU::getVictim(const ReplacementCandidates& candidates) const
+{
+    const uint64_t state = setState(candidates);
+
+    // Follow the tree from the root down to a leaf
+    uint64_t node = 0;
+    for (unsigned level = 0; level < numLevels; level++) {
+        node = 2 * node + (bits(state, node) ? 2 : 1);
+    }
+
+    // Leaves are displaced by the number of nodes
+    return candidates[node - (numWays - 1)];
+}
+
+std::shared_ptr<ReplacementData>
+PackedTreePLRU::instantiateEntry()
+{
+    return instantiatePacked(0);
+}
+
+} // namespace replacement_policy
+} // namespace gem5
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a tree Pseudo-Least Recently Used replacement policy
+ * whose tree bits are packed in one word per set.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_TREE_PLRU_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_TREE_PLRU_RP_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "mem/cache/replacement_policies/packed_rp.hh"
+
+namespace gem5
+{
+
+struct PackedTreePLRURPParams;
+
+namespace replacement_policy
+{
+
+/**
+ * A tree PLRU with the same tree layout and victim selection as the
+ * TreePLRU, but whose numWays - 1 tree bits are the bits of the packed
+ * state of the set. As the nodes on the path from the root to each leaf
+ * are known beforehand, touching or invalidating an entry updates all the
+ * nodes of its path with a single masked write.
+ *
+ * Sets of up to 64 ways are supported.
+ */
+class PackedTreePLRU : public Packed
+{
+  protected:
+    /** Number of levels of the tree. */
+    const unsigned numLevels;
+
+    /** Tree nodes on the path from the root to the leaf of each way. */
+    std::vector<uint64_t> pathMask;
+
+    /**
+     * Tree nodes on the path from the root to the leaf of each way from
+     * which the path goes to the right.
+     */
+    std::vector<uint64_t> pathRight;
+
+  public:
+    typedef PackedTreePLRURPParams Params;
+    PackedTreePLRU(const Params &p);
+    ~PackedTreePLRU() = default;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     * Makes every node on the path of the entry point towards it.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Touch an entry to update its replacement data.
+     * Makes every node on the path of the entry point away from it.
+     *
+     * @param replacement_data Replacement data to be touched.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Reset replacement data. Used when an entry is inserted.
+     * Makes every node on the path of the entry point away from it.
+     *
+     * @param replacement_data Replacement data to be reset.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find replacement victim by following the tree from its root.
+     *
+     * @param candidates Replacement candidates, the ways of a set.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    /**
+     * Instantiate a replacement data entry.
+     *
+     * @return A shared pointer to the new replacement data.
+     */
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_PACKED_TREE_PLRU_RP_HH__
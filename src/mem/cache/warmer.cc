@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/warmer.hh"
+
+#include <algorithm>
+#include <mutex>
+
+#include "base/logging.hh"
+#include "mem/packet.hh"
+#include "params/CacheWarmer.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+std::vector<BaseCache *> CacheWarmer::allCaches;
+UncontendedMutex CacheWarmer::warmLock;
+
+CacheWarmer::CacheWarmer(const CacheWarmerParams &p)
+    : BaseMemProbe(p), system(p.system), icaches(p.icaches),
+      dcaches(p.dcaches), blkSize(p.system->cacheLineSize()),
+      request(std::make_shared<Request>(0, blkSize, 0, 0)),
+      wbRequest(std::make_shared<Request>(0, blkSize, 0, 0)),
+      stats(this)
+{
+    fatal_if(icaches.empty() && dcaches.empty(),
+             "%s: There is no cache to warm.", name());
+
+    for (const auto *path : {&icaches, &dcaches}) {
+        for (auto *cache : *path) {
+            fatal_if(cache->getBlockSize() != blkSize,
+                     "%s: %s does not use the system cache line size.",
+                     name(), cache->name());
+            if (std::find(allCaches.begin(), allCaches.end(), cache) ==
+                    allCaches.end()) {
+                allCaches.push_back(cache);
+            }
+        }
+    }
+}
+
+void
+CacheWarmer::handleRequest(const probing::PacketInfo &pkt_info)
+{
+    // The caches are only warmed while they are not used
+    if (!system->bypassCaches())
+        return;
+
+    const Request::Flags flags = pkt_info.flags;
+    if (flags.isSet(Request::UNCACHEABLE | Request::STRICT_ORDER) ||
+            !(pkt_info.cmd.isRead() || pkt_info.cmd.isWrite())) {
+        return;
+    }
+
+    const bool is_fetch = flags.isSet(Request::INST_FETCH);
+    const CachePath &path = is_fetch ? icaches : dcaches;
+    if (path.empty())
+        return;
+
+    std::lock_guard<UncontendedMutex> lock(warmLock);
+
+    request->setPaddr(pkt_info.addr & ~Addr(blkSize - 1));
+    request->clearFlags(Request::Flags(~Request::FlagsType(0)));
+    request->setFlags(
+        pkt_info.flags & (Request::SECURE | Request::INST_FETCH));
+    request->requestorId(pkt_info.id);
+    request->setPC(pkt_info.pc);
+
+    Packet pkt(request, pkt_info.cmd.isWrite() ? MemCmd::WriteReq :
+                                                 MemCmd::ReadReq);
+    warm(path, &pkt);
+}
+
+void
+CacheWarmer::warm(const CachePath &path, PacketPtr pkt)
+{
+    const Addr addr = pkt->getAddr();
+    const bool is_secure = pkt->isSecure();
+    const bool is_write = pkt->isWrite();
+
+    stats.accesses++;
+
+    // Find the first level holding the line
+    std::size_t level = 0;
+    CacheBlk *blk = nullptr;
+    while (level < path.size() && !(blk = path[level]->warmAccess(pkt)))
+        level++;
+    if (!blk)
+        stats.misses++;
+
+    bool writable;
+    if (is_write) {
+        // The line is taken away from the other paths, and ownership
+        // moves up to the first level
+        invalidateOthers(path, addr, is_secure);
+        for (std::size_t l = level; l < path.size(); l++) {
+            if (CacheBlk *copy = path[l]->warmFind(addr, is_secure)) {
+                copy->setCoherenceBits(CacheBlk::WritableBit);
+                copy->clearCoherenceBits(CacheBlk::DirtyBit);
+            }
+        }
+        writable = true;
+    } else {
+        // The copies outside the path become shared, and so do the ones
+        // on the path if there are any. Otherwise a hit keeps the state
+        // of the level it hits, and a miss gets an exclusive copy.
+        const bool shared = shareOthers(path, addr, is_secure);
+        if (shared) {
+            for (std::size_t l = level; l < path.size(); l++) {
+                if (CacheBlk *copy = path[l]->warmFind(addr, is_secure))
+                    copy->clearCoherenceBits(CacheBlk::WritableBit);
+            }
+        }
+        writable = !shared && (!blk || blk->isSet(CacheBlk::WritableBit));
+        if (blk && level)
+            path[level]->warmServed(blk);
+    }
+
+    // Fill the levels which missed, from the bottom up
+    std::vector<BaseCache::WarmVictim> victims;
+    for (std::size_t l = level; l-- > 0;) {
+        CacheBlk *fill = path[l]->warmFill(pkt, false, victims);
+        if (fill && writable)
+            fill->setCoherenceBits(CacheBlk::WritableBit);
+        for (const auto &victim : victims)
+            writeback(path, l + 1, victim);
+        victims.clear();
+    }
+
+    if (is_write) {
+        for (auto *cache : path) {
+            if (CacheBlk *copy = cache->warmFind(addr, is_secure)) {
+                copy->setCoherenceBits(CacheBlk::DirtyBit);
+                break;
+            }
+        }
+    }
+}
+
+void
+CacheWarmer::writeback(const CachePath &path, std::size_t level,
+                       const BaseCache::WarmVictim &victim)
+{
+    // Memory is always up to date, so there is nothing to do beyond the
+    // last level
+    if (level >= path.size())
+        return;
+
+    stats.writebacks++;
+
+    wbRequest->setPaddr(victim.addr);
+    wbRequest->clearFlags(Request::Flags(~Request::FlagsType(0)));
+    if (victim.isSecure)
+        wbRequest->setFlags(Request::SECURE);
+    wbRequest->requestorId(Request::wbRequestorId);
+
+    Packet pkt(wbRequest, victim.dirty ? MemCmd::WritebackDirty :
+                                         MemCmd::WritebackClean);
+    std::vector<BaseCache::WarmVictim> victims;
+    CacheBlk *blk = path[level]->warmAccess(&pkt);
+    if (!blk)
+        blk = path[level]->warmFill(&pkt, true, victims);
+    if (blk) {
+        if (victim.writable)
+            blk->setCoherenceBits(CacheBlk::WritableBit);
+        if (victim.dirty)
+            blk->setCoherenceBits(CacheBlk::DirtyBit);
+    }
+
+    for (const auto &next : victims)
+        writeback(path, level + 1, next);
+}
+
+void
+CacheWarmer::invalidateOthers(const CachePath &path, Addr addr,
+                              bool is_secure)
+{
+    for (auto *cache : allCaches) {
+        if (std::find(path.begin(), path.end(), cache) != path.end())
+            continue;
+        if (CacheBlk *blk = cache->warmFind(addr, is_secure)) {
+            cache->warmInvalidate(blk);
+            stats.invalidations++;
+        }
+    }
+}
+
+bool
+CacheWarmer::shareOthers(const CachePath &path, Addr addr, bool is_secure)
+{
+    bool shared = false;
+    for (auto *cache : allCaches) {
+        if (std::find(path.begin(), path.end(), cache) != path.end())
+            continue;
+        if (CacheBlk *blk = cache->warmFind(addr, is_secure)) {
+            // A dirty copy stays the owner of the line
+            blk->clearCoherenceBits(CacheBlk::WritableBit);
+            shared = true;
+        }
+    }
+    return shared;
+}
+
+CacheWarmer::CacheWarmerStats::CacheWarmerStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(accesses, statistics::units::Count::get(),
+               "Number of accesses warmed"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of accesses which missed in every level"),
+      ADD_STAT(writebacks, statistics::units::Count::get(),
+               "Number of victims written back to a lower level"),
+      ADD_STAT(invalidations, statistics::units::Count::get(),
+               "Number of copies invalidated outside of the access path")
+{
+}
+
+} // namespace gem5
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_WARMER_HH__
+#define __MEM_CACHE_WARMER_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/uncontended_mutex.hh"
+#include "mem/cache/base.hh"
+#include "mem/probes/base.hh"
+#include "mem/request.hh"
+
+namespace gem5
+{
+
+struct CacheWarmerParams;
+
+/**
+ * Functionally warms the caches of a CPU from the accesses of another
+ * one, typically a NonCachingSimpleCPU fast forwarding the workload while
+ * the system bypasses the caches. Each access is looked up on the tags
+ * of the path it would have taken, from the first level cache down, and
+ * allocated where it missed, so that the caches are warm when switching
+ * to a detailed CPU. See BaseCache::warmAccess().
+ *
+ * The coherence state of the lines follows the classic protocol: a write
+ * invalidates the line in every cache outside the path of the access and
+ * leaves it modified in the highest level, and a read of a line cached
+ * outside of its path makes every copy of the line read only. Otherwise
+ * a read miss gets a writable copy.
+ *
+ * When the caches stop being bypassed, they tell the snoop filters of
+ * the crossbars below which lines they hold, see
+ * BaseCache::finishWarming().
+ */
+class CacheWarmer : public BaseMemProbe
+{
+  protected:
+    typedef std::vector<BaseCache *> CachePath;
+
+    System *system;
+    const CachePath icaches;
+    const CachePath dcaches;
+    const unsigned blkSize;
+
+    /** Reused for the accesses and the writebacks to save allocations. */
+    RequestPtr request;
+    RequestPtr wbRequest;
+
+    /** The caches of all the warmers, which share lines across paths. */
+    static std::vector<BaseCache *> allCaches;
+    /** Serialises the warmers of CPUs on parallel event queues. */
+    static UncontendedMutex warmLock;
+
+    void handleRequest(const probing::PacketInfo &pkt_info) override;
+
+    /** Look up an access on a path, allocating it where it missed. */
+    void warm(const CachePath &path, PacketPtr pkt);
+
+    /** Write back a victim to a level of a path, if there is one. */
+    void writeback(const CachePath &path, std::size_t level,
+                   const BaseCache::WarmVictim &victim);
+
+    /** Drop the copies of a line outside of a path. */
+    void invalidateOthers(const CachePath &path, Addr addr, bool is_secure);
+
+    /**
+     * Make the copies of a line outside of a path read only.
+     * @return Whether the line is cached outside of the path.
+     */
+    bool shareOthers(const CachePath &path, Addr addr, bool is_secure);
+
+    struct CacheWarmerStats : public statistics::Group
+    {
+        CacheWarmerStats(statistics::Group *parent);
+
+        statistics::Scalar accesses;
+        statistics::Scalar misses;
+        statistics::Scalar writebacks;
+        statistics::Scalar invalidations;
+    } stats;
+
+  public:
+    CacheWarmer(const CacheWarmerParams &p);
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_WARMER_HH__
@@ -66,7 +66,9 @@ CoherentXBar::CoherentXBar(const CoherentXBarParams &p)
       ADD_STAT(snoops, statistics::units::Count::get(), "Total snoops"),
       ADD_STAT(snoopTraffic, statistics::units::Byte::get(), "Total snoop traffic"),
       ADD_STAT(snoopFanout, statistics::units::Count::get(),
-               "Request fanout histogram")
+               "Request fanout histogram"),
+      ADD_STAT(recallWritebacks, statistics::units::Count::get(),
+               "Dirty lines written back when recalled by the snoop filter")
 {
     // create the ports based on the size of the memory-side port and
     // CPU-side port vector ports, and the presence of the default port,
@@ -201,6 +203,17 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     if (snoop_caches) {
         assert(pkt->snoopDelay == 0);
 
+        if (!is_express_snoop && isRecalling(pkt)) {
+            // the dirty data of the line is on its way from a cache
+            // above, and memory is stale until it has been written
+            DPRINTF(CoherentXBar, "%s: src %s packet %s RECALL RETRY\n",
+                    __func__, src_port->name(), pkt->print());
+
+            reqLayers[mem_side_port_id]->failedTiming(src_port,
+                                                    clockEdge(Cycles(1)));
+            return false;
+        }
+
         if (pkt->isClean() && !is_destination) {
             // before snooping we need to make sure that the memory
             // below is not busy and the cache clean request can be
@@ -229,6 +242,7 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
             DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                     __func__, src_port->name(), pkt->print(),
                     sf_res.first.size(), sf_res.second);
+            recallLines(true);
 
             if (pkt->isEviction()) {
                 // for block-evicting packets, i.e. writebacks and
@@ -572,6 +586,17 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
     // determine the source port based on the id
     ResponsePort* src_port = cpuSidePorts[cpu_side_port_id];
 
+    // the response to a recall has nowhere to go but below
+    auto recall = outstandingRecall.find(pkt->req);
+    if (recall != outstandingRecall.end()) {
+        DPRINTF(CoherentXBar, "%s: src %s packet %s RECALL\n", __func__,
+                src_port->name(), pkt->print());
+        outstandingRecall.erase(recall);
+        writeRecalledLine(pkt);
+        delete pkt;
+        return true;
+    }
+
     // get the destination
     const auto route_lookup = routeTo.find(pkt->req);
     assert(route_lookup != routeTo.end());
@@ -724,6 +749,77 @@ CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
     snoopFanout.sample(fanout);
 }
 
+void
+CoherentXBar::recallLines(bool is_timing)
+{
+    for (const auto &recall : snoopFilter->takeRecalls()) {
+        RequestPtr req = std::make_shared<Request>(
+            recall.addr, system->cacheLineSize(),
+            recall.isSecure ? Request::SECURE : 0,
+            snoopFilter->requestorId());
+
+        // invalidate all copies, and have the owner of a dirty copy
+        // respond with the data, as for an exclusive read
+        Packet pkt(req, MemCmd::ReadExReq);
+
+        DPRINTF(CoherentXBar, "%s: %s\n", __func__, pkt.print());
+
+        if (is_timing) {
+            forwardTiming(&pkt, InvalidPortID, recall.ports);
+            // the response, if any, carries a copy of the request
+            // rather than the packet itself
+            if (pkt.cacheResponding())
+                outstandingRecall.insert(req);
+        } else {
+            pkt.allocate();
+            const MemCmd orig_cmd = pkt.cmd;
+            MemCmd response_cmd = MemCmd::InvalidCmd;
+            for (const auto &p : recall.ports) {
+                p->sendAtomicSnoop(&pkt);
+                if (pkt.isResponse()) {
+                    assert(response_cmd == MemCmd::InvalidCmd);
+                    response_cmd = pkt.cmd;
+                    // restore the request for the remaining snoopers
+                    pkt.cmd = orig_cmd;
+                }
+            }
+            snoopFanout.sample(recall.ports.size());
+            if (response_cmd != MemCmd::InvalidCmd) {
+                // put the response back, as forwardAtomic does, so that
+                // the packet is seen to carry the data
+                pkt.cmd = response_cmd;
+                writeRecalledLine(&pkt);
+            }
+        }
+    }
+}
+
+bool
+CoherentXBar::isRecalling(const PacketPtr pkt) const
+{
+    if (outstandingRecall.empty())
+        return false;
+
+    const Addr line_addr = pkt->getBlockAddr(system->cacheLineSize());
+    for (const auto &req : outstandingRecall) {
+        if (req->getPaddr() == line_addr &&
+            req->isSecure() == pkt->isSecure())
+            return true;
+    }
+    return false;
+}
+
+void
+CoherentXBar::writeRecalledLine(PacketPtr pkt)
+{
+    assert(pkt->hasData());
+
+    Packet wb_pkt(pkt->req, MemCmd::WriteReq);
+    wb_pkt.dataStatic(pkt->getPtr<uint8_t>());
+    memSidePorts[findPort(&wb_pkt)]->sendFunctional(&wb_pkt);
+    recallWritebacks++;
+}
+
 void
 CoherentXBar::recvReqRetry(PortID mem_side_port_id)
 {
@@ -772,6 +868,7 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
             // avoid situations where atomic upward snoops sneak in
             // between and change the filter state
             snoopFilter->finishRequest(false, pkt->getAddr(), pkt->isSecure());
+            recallLines(false);
 
             if (pkt->isEviction()) {
                 // for block-evicting packets, i.e. writebacks and
@@ -1001,6 +1098,22 @@ void
 CoherentXBar::recvMemBackdoorReq(const MemBackdoorReq &req,
         MemBackdoorPtr &backdoor)
 {
+    // A backdoor goes straight to memory without snooping, so refuse it
+    // whenever a cache on the CPU side could hold newer data than memory
+    // or would miss a write made through it. Snoopers which only watch
+    // the accesses, such as the CPUs' data ports, hold no data.
+    if (!system->bypassCaches()) {
+        for (const auto *p : snoopPorts) {
+            if (p->isCaching()) {
+                DPRINTF(CoherentXBar, "%s: refusing backdoor to %s, %s "
+                        "may cache\n", __func__, req.range().to_string(),
+                        p->name());
+                backdoor = nullptr;
+                return;
+            }
+        }
+    }
+
     PortID dest_id = findPort(req.range());
     memSidePorts[dest_id]->sendMemBackdoorReq(req, backdoor);
 }
@@ -1014,6 +1127,13 @@ CoherentXBar::recvFunctional(PacketPtr pkt, PortID cpu_side_port_id)
                 cpuSidePorts[cpu_side_port_id]->name(), pkt->print());
     }
 
+    if (snoopFilter && pkt->isBlockCached() && !system->bypassCaches()) {
+        // a cache which warmed its tags while bypassed reads the data of
+        // a block it holds, and only this filter tracks the source port
+        snoopFilter->addHolder(pkt, *cpuSidePorts[cpu_side_port_id]);
+        pkt->clearBlockCached();
+    }
+
     if (!system->bypassCaches()) {
         // forward to all snoopers but the source
         forwardFunctional(pkt, cpu_side_port_id);
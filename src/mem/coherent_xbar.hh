@@ -274,6 +274,14 @@ class CoherentXBar : public BaseXBar
      */
     std::unordered_map<PacketId, PacketPtr> outstandingCMO;
 
+    /**
+     * Store the back-invalidations, of lines replaced in a bounded
+     * snoop filter, that a cache committed to respond to with dirty
+     * data. Requests to these lines are held until the data has been
+     * written below.
+     */
+    std::unordered_set<RequestPtr> outstandingRecall;
+
     /**
      * Keep a pointer to the system to be allow to querying memory system
      * properties.
@@ -377,6 +385,29 @@ class CoherentXBar : public BaseXBar
                                           const std::vector<QueuedResponsePort*>&
                                           dests);
 
+    /**
+     * Back-invalidate the lines that the snoop filter replaced during
+     * the last request lookup, by sending them an invalidating snoop.
+     *
+     * @param is_timing Whether to send timing or atomic snoops
+     */
+    void recallLines(bool is_timing);
+
+    /**
+     * Check if the line of a request is being recalled, in which case
+     * the request has to wait for the recalled data to be written.
+     */
+    bool isRecalling(const PacketPtr pkt) const;
+
+    /**
+     * Write the dirty data supplied for a recalled line to the memory
+     * below. The write is functional, and the latency of the writeback
+     * is not modelled.
+     *
+     * @param pkt Response to the recall snoop, carrying the data
+     */
+    void writeRecalledLine(PacketPtr pkt);
+
     /** Function called by the port when the crossbar is receiving a Functional
         transaction.*/
     void recvFunctional(PacketPtr pkt, PortID cpu_side_port_id);
@@ -433,6 +464,7 @@ class CoherentXBar : public BaseXBar
     statistics::Scalar snoops;
     statistics::Scalar snoopTraffic;
     statistics::Distribution snoopFanout;
+    statistics::Scalar recallWritebacks;
 
   public:
 
@@ -677,6 +677,13 @@ class MemCtrl : public qos::MemCtrl
 
     MemCtrl(const MemCtrlParams &p);
 
+    /** Capacity of the read and write buffers, in bursts. */
+    uint32_t getReadBufferSize() const { return readBufferSize; }
+    uint32_t getWriteBufferSize() const { return writeBufferSize; }
+
+    /** Number of reads done, waiting for their response to be sent. */
+    size_t getRespQueueSize() const { return respQueue.size(); }
+
     /**
      * Ensure that all interfaced have drained commands
      *
@@ -38,12 +38,21 @@
 #include "base/compiler.hh"
 #include "base/trace.hh"
 #include "debug/MMU.hh"
+#include "sim/eventq.hh"
 #include "sim/faults.hh"
 #include "sim/serialize.hh"
 
 namespace gem5
 {
 
+std::shared_lock<std::shared_mutex>
+EmulationPageTable::readLock() const
+{
+    if (!inParallelMode)
+        return std::shared_lock<std::shared_mutex>();
+    return std::shared_lock<std::shared_mutex>(tableLock);
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
@@ -53,22 +62,15 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
-    while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
-            // already mapped
-            panic_if(!clobber,
-                     "EmulationPageTable::allocate: addr %#x already mapped",
-                     vaddr);
-            it->second = Entry(paddr, flags);
-        } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
-        }
+    if (size <= 0)
+        return;
 
-        size -= _pageSize;
-        vaddr += _pageSize;
-        paddr += _pageSize;
-    }
+    std::unique_lock<std::shared_mutex> lock(tableLock);
+    Addr mapped;
+    panic_if(!clobber && pTable.findMapped(vaddr, size, mapped),
+             "EmulationPageTable::allocate: addr %#x already mapped", mapped);
+
+    pTable.insert(vaddr, paddr, roundUp(size, _pageSize), flags);
 }
 
 void
@@ -80,24 +82,35 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
     DPRINTF(MMU, "moving pages from vaddr %08p to %08p, size = %d\n", vaddr,
             new_vaddr, size);
 
-    while (size > 0) {
-        [[maybe_unused]] auto new_it = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
-
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
-        size -= _pageSize;
-        vaddr += _pageSize;
-        new_vaddr += _pageSize;
+    // Move the region one leaf of the page table at a time, so huge pages
+    // are moved as a whole if they stay aligned.
+    Addr left = size > 0 ? roundUp(size, _pageSize) : 0;
+    std::unique_lock<std::shared_mutex> lock(tableLock);
+    while (left) {
+        const auto leaf = pTable.find(vaddr);
+        assert(leaf.valid());
+        const Addr chunk = std::min(left, leaf.vaddr + leaf.size - vaddr);
+        const Addr paddr = leaf.entry.paddr + (vaddr - leaf.vaddr);
+        const uint64_t flags = leaf.entry.flags;
+
+        [[maybe_unused]] Addr mapped;
+        assert(!pTable.findMapped(new_vaddr, chunk, mapped));
+
+        pTable.insert(new_vaddr, paddr, chunk, flags);
+        pTable.erase(vaddr, chunk);
+        left -= chunk;
+        vaddr += chunk;
+        new_vaddr += chunk;
     }
 }
 
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    auto lock = readLock();
+    pTable.forEachPage([addr_maps](Addr vaddr, const Entry &entry) {
+        addr_maps->push_back(std::make_pair(vaddr, entry.paddr));
+    });
 }
 
 void
@@ -107,13 +120,14 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
-    while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
-        size -= _pageSize;
-        vaddr += _pageSize;
-    }
+    if (size <= 0)
+        return;
+
+    const Addr pages_size = roundUp(size, _pageSize);
+    std::unique_lock<std::shared_mutex> lock(tableLock);
+    [[maybe_unused]] const uint64_t unmapped =
+        pTable.erase(vaddr, pages_size);
+    assert(unmapped == pages_size / _pageSize);
 }
 
 bool
@@ -122,32 +136,30 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
-    for (int64_t offset = 0; offset < size; offset += _pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
-            return false;
-
-    return true;
+    auto lock = readLock();
+    Addr mapped;
+    return size <= 0 || !pTable.findMapped(vaddr, size, mapped);
 }
 
-const EmulationPageTable::Entry *
+std::optional<EmulationPageTable::Entry>
 EmulationPageTable::lookup(Addr vaddr)
 {
-    Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
-    if (iter == pTable.end())
-        return nullptr;
-    return &(iter->second);
+    auto lock = readLock();
+    return pTable.lookup(vaddr);
 }
 
 bool
 EmulationPageTable::translate(Addr vaddr, Addr &paddr)
 {
-    const Entry *entry = lookup(vaddr);
-    if (!entry) {
-        DPRINTF(MMU, "Couldn't Translate: %#x\n", vaddr);
-        return false;
+    {
+        auto lock = readLock();
+        const auto entry = pTable.lookup(vaddr);
+        if (!entry) {
+            DPRINTF(MMU, "Couldn't Translate: %#x\n", vaddr);
+            return false;
+        }
+        paddr = pageOffset(vaddr) + entry->paddr;
     }
-    paddr = pageOffset(vaddr) + entry->paddr;
     DPRINTF(MMU, "Translating: %#x->%#x\n", vaddr, paddr);
     return true;
 }
@@ -186,17 +198,17 @@ void
 EmulationPageTable::serialize(CheckpointOut &cp) const
 {
     ScopedCheckpointSection sec(cp, "ptable");
-    paramOut(cp, "size", pTable.size());
+    paramOut(cp, "size", pTable.pages());
 
-    PTable::size_type count = 0;
-    for (auto &pte : pTable) {
+    uint64_t count = 0;
+    pTable.forEachPage([&cp, &count](Addr vaddr, const Entry &entry) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
 
-        paramOut(cp, "vaddr", pte.first);
-        paramOut(cp, "paddr", pte.second.paddr);
-        paramOut(cp, "flags", pte.second.flags);
-    }
-    assert(count == pTable.size());
+        paramOut(cp, "vaddr", vaddr);
+        paramOut(cp, "paddr", entry.paddr);
+        paramOut(cp, "flags", entry.flags);
+    });
+    assert(count == pTable.pages());
 }
 
 void
@@ -216,7 +228,8 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        std::unique_lock<std::shared_mutex> lock(tableLock);
+        pTable.insert(vaddr, paddr, _pageSize, flags);
     }
 }
 
@@ -224,9 +237,9 @@ const std::string
 EmulationPageTable::externalize() const
 {
     std::stringstream ss;
-    for (PTable::const_iterator it=pTable.begin(); it != pTable.end(); ++it) {
-        ss << std::hex << it->first << ":" << it->second.paddr << ";";
-    }
+    pTable.forEachPage([&ss](Addr vaddr, const Entry &entry) {
+        ss << std::hex << vaddr << ":" << entry.paddr << ";";
+    });
     return ss.str();
 }
 
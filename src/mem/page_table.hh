@@ -35,12 +35,16 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base/types.hh"
+#include "mem/radix_page_map.hh"
 #include "mem/request.hh"
 #include "mem/translation_gen.hh"
 #include "sim/serialize.hh"
@@ -53,19 +57,20 @@ class ThreadContext;
 class EmulationPageTable : public Serializable
 {
   public:
-    struct Entry
-    {
-        Addr paddr;
-        uint64_t flags;
-
-        Entry(Addr paddr, uint64_t flags) : paddr(paddr), flags(flags) {}
-        Entry() {}
-    };
+    typedef RadixPageMap::Entry Entry;
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
-    typedef PTable::iterator PTableItr;
-    PTable pTable;
+    RadixPageMap pTable;
+
+    /**
+     * Threads sharing the page table may run on different event queues in
+     * parallel mode. Mappings are only changed from syscalls, which are
+     * serialized, so lookups share this lock and modifications own it.
+     */
+    mutable std::shared_mutex tableLock;
+
+    /** Take a shared lock on the table if event queues run in parallel. */
+    std::shared_lock<std::shared_mutex> readLock() const;
 
     const Addr _pageSize;
     const Addr offsetMask;
@@ -77,7 +82,8 @@ class EmulationPageTable : public Serializable
 
     EmulationPageTable(
             const std::string &__name, uint64_t _pid, Addr _pageSize) :
-            _pageSize(_pageSize), offsetMask(mask(floorLog2(_pageSize))),
+            pTable(_pageSize), _pageSize(_pageSize),
+            offsetMask(mask(floorLog2(_pageSize))),
             _pid(_pid), _name(__name), shared(false)
     {
         assert(isPowerOf2(_pageSize));
@@ -137,9 +143,10 @@ class EmulationPageTable : public Serializable
     /**
      * Lookup function
      * @param vaddr The virtual address.
-     * @return The page table entry corresponding to vaddr.
+     * @return A copy of the page table entry corresponding to vaddr, if
+     * vaddr is mapped.
      */
-    const Entry *lookup(Addr vaddr);
+    std::optional<Entry> lookup(Addr vaddr);
 
     /**
      * Translate function
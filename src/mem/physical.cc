@@ -44,12 +44,16 @@
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <string>
 
+#include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
@@ -76,15 +80,103 @@ namespace gem5
 namespace memory
 {
 
+namespace
+{
+
+/**
+ * Linux exposes, for each virtual page of a process, a 64-bit entry in
+ * /proc/self/pagemap telling whether the page is present in memory or
+ * swapped out, without faulting the page in.
+ */
+const char *const pagemapPath = "/proc/self/pagemap";
+
+/** Header of an extent of a sparse backing store checkpoint. */
+struct SparseExtent
+{
+    uint64_t offset;
+    uint64_t size;
+};
+
+void
+gzWriteAll(gzFile file, const uint8_t* data, uint64_t size,
+           const std::string& filename)
+{
+    uint64_t pass_size = 0;
+
+    // gzwrite fails if (int)len < 0 (gzwrite returns int)
+    for (uint64_t written = 0; written < size; written += pass_size) {
+        pass_size = (uint64_t)INT_MAX < (size - written) ?
+            (uint64_t)INT_MAX : (size - written);
+
+        if (gzwrite(file, data + written,
+                    (unsigned int) pass_size) != (int) pass_size) {
+            fatal("Write failed on physical memory checkpoint file '%s'\n",
+                  filename);
+        }
+    }
+}
+
+void
+gzReadAll(gzFile file, uint8_t* data, uint64_t size,
+          const std::string& filename)
+{
+    uint64_t pass_size = 0;
+
+    for (uint64_t read = 0; read < size; read += pass_size) {
+        pass_size = (uint64_t)INT_MAX < (size - read) ?
+            (uint64_t)INT_MAX : (size - read);
+
+        if (gzread(file, data + read,
+                   (unsigned int) pass_size) != (int) pass_size) {
+            fatal("Read failed on physical memory checkpoint file '%s'\n",
+                  filename);
+        }
+    }
+}
+
+bool
+isZeroPage(const uint8_t* page, uint64_t size)
+{
+    return page[0] == 0 && std::memcmp(page, page + 1, size - 1) == 0;
+}
+
+} // anonymous namespace
+
 PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               bool sparse_backstore, bool huge_pages,
+                               unsigned huge_page_density) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), sparseBackstore(sparse_backstore),
+    hugePages(huge_pages), hugePageDensity(huge_page_density),
+    hugePageSize(2 * 1024 * 1024), touchedBytes(0)
 {
+    fatal_if(sparseBackstore && !sharedBackstore.empty(),
+             "A sparse backing store cannot be shared\n");
+    fatal_if(sparseBackstore && ::access(pagemapPath, R_OK) != 0,
+             "A sparse backing store needs %s to find the touched pages\n",
+             pagemapPath);
+
+    if (hugePages) {
+#ifdef MADV_HUGEPAGE
+        // The huge page size of the host, if it is not the usual one
+        std::ifstream pmd_size(
+            "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+        uint64_t host_huge_page_size = 0;
+        if (pmd_size >> host_huge_page_size &&
+                isPowerOf2(host_huge_page_size) &&
+                host_huge_page_size > (uint64_t)pageSize) {
+            hugePageSize = host_huge_page_size;
+        }
+#else
+        warn("Transparent huge pages are not supported on this host\n");
+#endif
+    }
+
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
         registerExitCallback([=]() { shm_unlink(shared_backstore.c_str()); });
@@ -234,11 +326,18 @@ PhysicalMemory::createBackingStore(
 
     // to be able to simulate very large memories, the user can opt to
     // pass noreserve to mmap
-    if (mmapUsingNoReserve) {
+    if (mmapUsingNoReserve || sparseBackstore) {
         map_flags |= MAP_NORESERVE;
     }
 
-    uint8_t* pmem = (uint8_t*) mmap(NULL, range.size(),
+    // huge pages can only back the parts of the mapping that are aligned
+    // on a huge page, so leave room to align the start of the mapping
+    uint64_t map_size = range.size();
+    if (hugePages && sharedBackstore.empty()) {
+        map_size = roundUp(range.size(), pageSize) + hugePageSize;
+    }
+
+    uint8_t* pmem = (uint8_t*) mmap(NULL, map_size,
                                     PROT_READ | PROT_WRITE,
                                     map_flags, shm_fd, map_offset);
 
@@ -248,6 +347,28 @@ PhysicalMemory::createBackingStore(
               range.to_string());
     }
 
+    if (map_size != range.size()) {
+        // give back what is not needed on either side of the aligned
+        // mapping
+        uint8_t* aligned = (uint8_t*) roundUp((uintptr_t) pmem, hugePageSize);
+        uint8_t* aligned_end = aligned + roundUp(range.size(), pageSize);
+        if (aligned != pmem)
+            munmap(pmem, aligned - pmem);
+        if (aligned_end != pmem + map_size)
+            munmap(aligned_end, pmem + map_size - aligned_end);
+        pmem = aligned;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (sparseBackstore) {
+        // the host would otherwise commit a whole huge page for each
+        // touched page, dense parts are given huge pages once found
+        madvise(pmem, range.size(), MADV_NOHUGEPAGE);
+    } else if (hugePages) {
+        madvise(pmem, range.size(), MADV_HUGEPAGE);
+    }
+#endif
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
@@ -269,6 +390,76 @@ PhysicalMemory::~PhysicalMemory()
         munmap((char*)s.pmem, s.range.size());
 }
 
+std::vector<bool>
+PhysicalMemory::touchedPages(uint8_t* pmem, uint64_t size) const
+{
+    const uint64_t num_pages = divCeil(size, pageSize);
+    std::vector<bool> touched(num_pages);
+
+    int fd = open(pagemapPath, O_RDONLY);
+    fatal_if(fd < 0, "Could not open %s: %s\n", pagemapPath,
+             strerror(errno));
+
+    // bit 63 of an entry is set if the page is present and bit 62 if it
+    // is swapped out
+    const uint64_t chunk_pages = 65536;
+    std::vector<uint64_t> entries(chunk_pages);
+    const off_t first_entry =
+        (uintptr_t) pmem / pageSize * sizeof(uint64_t);
+    for (uint64_t page = 0; page < num_pages; page += chunk_pages) {
+        const uint64_t count = std::min(chunk_pages, num_pages - page);
+        const ssize_t bytes = count * sizeof(uint64_t);
+        fatal_if(pread(fd, entries.data(), bytes,
+                       first_entry + page * sizeof(uint64_t)) != bytes,
+                 "Could not read %s: %s\n", pagemapPath, strerror(errno));
+        for (uint64_t i = 0; i < count; i++)
+            touched[page + i] = bits(entries[i], 63, 62) != 0;
+    }
+
+    close(fd);
+    return touched;
+}
+
+std::vector<bool>
+PhysicalMemory::denseHugePages(uint8_t* pmem,
+                               const std::vector<bool>& touched) const
+{
+    // a trailing partial huge page can never be backed by a huge page
+    const uint64_t pages_per_huge_page = hugePageSize / pageSize;
+    std::vector<bool> dense(touched.size() / pages_per_huge_page);
+    if (!hugePages)
+        return dense;
+
+    for (uint64_t i = 0; i < dense.size(); i++) {
+        auto first = touched.begin() + i * pages_per_huge_page;
+        const uint64_t num_touched =
+            std::count(first, first + pages_per_huge_page, true);
+        dense[i] = num_touched * 100 >= hugePageDensity * pages_per_huge_page;
+#ifdef MADV_HUGEPAGE
+        if (dense[i]) {
+            madvise(pmem + i * hugePageSize, hugePageSize, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    return dense;
+}
+
+void
+PhysicalMemory::updateTouchedSize()
+{
+    if (!sparseBackstore)
+        return;
+
+    touchedBytes = 0;
+    for (const auto& s : backingStore) {
+        const std::vector<bool> touched =
+            touchedPages(s.pmem, s.range.size());
+        touchedBytes += std::count(touched.begin(), touched.end(), true) *
+            pageSize;
+    }
+}
+
 bool
 PhysicalMemory::isMemAddr(Addr addr) const
 {
@@ -351,6 +542,9 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
     unsigned int nbr_of_stores = backingStore.size();
     SERIALIZE_SCALAR(nbr_of_stores);
 
+    // the touched size is summed up as the stores are saved
+    touchedBytes = 0;
+
     unsigned int store_id = 0;
     // store each backing store memory segment in a file
     for (auto& s : backingStore) {
@@ -375,6 +569,10 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     SERIALIZE_SCALAR(store_id);
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
+    if (sparseBackstore) {
+        bool sparse = true;
+        SERIALIZE_SCALAR(sparse);
+    }
 
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
@@ -383,19 +581,51 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
         fatal("Can't open physical memory checkpoint file '%s'\n",
               filename);
 
-    uint64_t pass_size = 0;
-
-    // gzwrite fails if (int)len < 0 (gzwrite returns int)
-    for (uint64_t written = 0; written < range.size();
-         written += pass_size) {
-        pass_size = (uint64_t)INT_MAX < (range.size() - written) ?
-            (uint64_t)INT_MAX : (range.size() - written);
+    if (!sparseBackstore) {
+        gzWriteAll(compressed_mem, pmem, range.size(), filename);
+    } else {
+        // save the touched pages that are not all zeros as extents of
+        // contiguous pages, dense huge pages are saved whole so that they
+        // are restored as huge pages
+        const std::vector<bool> touched = touchedPages(pmem, range.size());
+        const std::vector<bool> dense = denseHugePages(pmem, touched);
+        touchedBytes += std::count(touched.begin(), touched.end(), true) *
+            pageSize;
+        const uint64_t pages_per_huge_page = hugePageSize / pageSize;
+        auto save_page = [&](uint64_t page) {
+            const uint64_t huge_page = page / pages_per_huge_page;
+            if (huge_page < dense.size() && dense[huge_page])
+                return true;
+            const uint64_t offset = page * pageSize;
+            return touched[page] && !isZeroPage(pmem + offset,
+                std::min<uint64_t>(pageSize, range.size() - offset));
+        };
+
+        uint64_t saved_pages = 0;
+        uint64_t page = 0;
+        while (page < touched.size()) {
+            if (!save_page(page)) {
+                page++;
+                continue;
+            }
 
-        if (gzwrite(compressed_mem, pmem + written,
-                    (unsigned int) pass_size) != (int) pass_size) {
-            fatal("Write failed on physical memory checkpoint file '%s'\n",
-                  filename);
+            const uint64_t first_page = page;
+            while (page < touched.size() && save_page(page))
+                page++;
+
+            SparseExtent extent;
+            extent.offset = first_page * pageSize;
+            extent.size = std::min<uint64_t>(page * pageSize, range.size()) -
+                extent.offset;
+            gzWriteAll(compressed_mem, (const uint8_t*) &extent,
+                       sizeof(extent), filename);
+            gzWriteAll(compressed_mem, pmem + extent.offset, extent.size,
+                       filename);
+            saved_pages += page - first_page;
         }
+
+        DPRINTF(Checkpoint, "Saved %d of %d pages of sparse store %d\n",
+                saved_pages, touched.size(), store_id);
     }
 
     // close the compressed stream and check that the exit status
@@ -429,6 +659,7 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
         unserializeStore(cp);
     }
 
+    updateTouchedSize();
 }
 
 void
@@ -462,29 +693,59 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
-    uint64_t curr_size = 0;
-    long* temp_page = new long[chunk_size];
-    long* pmem_current;
-    uint32_t bytes_read;
-    while (curr_size < range.size()) {
-        bytes_read = gzread(compressed_mem, temp_page, chunk_size);
-        if (bytes_read == 0)
-            break;
-
-        assert(bytes_read % sizeof(long) == 0);
-
-        for (uint32_t x = 0; x < bytes_read / sizeof(long); x++) {
-            // Only copy bytes that are non-zero, so we don't give
-            // the VM system hell
-            if (*(temp_page + x) != 0) {
-                pmem_current = (long*)(pmem + curr_size + x * sizeof(long));
-                *pmem_current = *(temp_page + x);
+    bool sparse = false;
+    UNSERIALIZE_OPT_SCALAR(sparse);
+
+    if (sparse) {
+        // a sparse store is saved as extents, each followed by its data
+        SparseExtent extent;
+        while (gzread(compressed_mem, &extent, sizeof(extent)) ==
+               sizeof(extent)) {
+            fatal_if(extent.offset + extent.size > range.size(),
+                     "Extent [%#x:%#x] of physical memory checkpoint file "
+                     "'%s' is out of range\n", extent.offset,
+                     extent.offset + extent.size, filename);
+
+#ifdef MADV_HUGEPAGE
+            // the huge pages covered by an extent are dense
+            const uint64_t huge_start = roundUp(extent.offset, hugePageSize);
+            const uint64_t huge_end =
+                roundDown(extent.offset + extent.size, hugePageSize);
+            if (sparseBackstore && hugePages && huge_end > huge_start) {
+                madvise(pmem + huge_start, huge_end - huge_start,
+                        MADV_HUGEPAGE);
             }
+#endif
+
+            gzReadAll(compressed_mem, pmem + extent.offset, extent.size,
+                      filename);
+        }
+    } else {
+        uint64_t curr_size = 0;
+        long* temp_page = new long[chunk_size];
+        long* pmem_current;
+        uint32_t bytes_read;
+        while (curr_size < range.size()) {
+            bytes_read = gzread(compressed_mem, temp_page, chunk_size);
+            if (bytes_read == 0)
+                break;
+
+            assert(bytes_read % sizeof(long) == 0);
+
+            for (uint32_t x = 0; x < bytes_read / sizeof(long); x++) {
+                // Only copy bytes that are non-zero, so we don't give
+                // the VM system hell
+                if (*(temp_page + x) != 0) {
+                    pmem_current =
+                        (long*)(pmem + curr_size + x * sizeof(long));
+                    *pmem_current = *(temp_page + x);
+                }
+            }
+            curr_size += bytes_read;
         }
-        curr_size += bytes_read;
-    }
 
-    delete[] temp_page;
+        delete[] temp_page;
+    }
 
     if (gzclose(compressed_mem))
         fatal("Close failed on physical memory checkpoint file '%s'\n",
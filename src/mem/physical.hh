@@ -158,6 +158,23 @@ class PhysicalMemory : public Serializable
 
     long pageSize;
 
+    // Only commit, and checkpoint, the touched pages of the backing store
+    const bool sparseBackstore;
+
+    // Back the backing store, or the dense parts of a sparse one, with
+    // transparent huge pages
+    const bool hugePages;
+
+    // Percentage of touched pages above which a huge page of a sparse
+    // backing store is dense
+    const unsigned hugePageDensity;
+
+    uint64_t hugePageSize;
+
+    // Size of the touched pages of a sparse backing store, as last found
+    // in the host page tables, which is also done at every checkpoint
+    mutable uint64_t touchedBytes;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
@@ -182,6 +199,29 @@ class PhysicalMemory : public Serializable
                             bool conf_table_reported,
                             bool in_addr_map, bool kvm_map);
 
+    /**
+     * Find the host pages of a backing store that have been touched,
+     * i.e., that the host has committed memory for, be they resident or
+     * swapped out.
+     *
+     * @param pmem The host pointer to the backing store
+     * @param size The size of the backing store
+     * @return Whether each page of the backing store has been touched
+     */
+    std::vector<bool> touchedPages(uint8_t* pmem, uint64_t size) const;
+
+    /**
+     * Find the huge pages of a backing store with enough touched pages
+     * to be backed by a huge page on the host, and advise the host to do
+     * so.
+     *
+     * @param pmem The host pointer to the backing store
+     * @param touched Whether each page of the backing store was touched
+     * @return Whether each huge page of the backing store is dense
+     */
+    std::vector<bool> denseHugePages(uint8_t* pmem,
+                                     const std::vector<bool>& touched) const;
+
   public:
 
     /**
@@ -191,7 +231,9 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   bool sparse_backstore, bool huge_pages,
+                   unsigned huge_page_density);
 
     /**
      * Unmap all the backing store we have used.
@@ -230,6 +272,30 @@ class PhysicalMemory : public Serializable
      */
     uint64_t totalSize() const { return size; }
 
+    /**
+     * Is the backing store sparse?
+     *
+     * @return Whether only the touched pages of the backing store are
+     * committed and checkpointed
+     */
+    bool sparse() const { return sparseBackstore; }
+
+    /**
+     * Get the amount of host memory committed for the backing store, as
+     * of the last update or checkpoint. This is only tracked for sparse
+     * backing stores.
+     *
+     * @return The size of the touched pages of a sparse backing store
+     */
+    uint64_t touchedSize() const { return touchedBytes; }
+
+    /**
+     * Find the touched pages of a sparse backing store again, to update
+     * the size returned by touchedSize(). This reads the host page
+     * tables, so it is not meant to be done on every access.
+     */
+    void updateTouchedSize();
+
      /**
      * Get the pointers to the backing store for external host
      * access. Note that memory in the guest should be accessed using
@@ -275,7 +341,8 @@ class PhysicalMemory : public Serializable
     void serialize(CheckpointOut &cp) const override;
 
     /**
-     * Serialize a specific store.
+     * Serialize a specific store. Only the touched pages of a sparse
+     * backing store are saved, as a sequence of extents.
      *
      * @param store_id Unique identifier of this backing store
      * @param range The address range of this backing store
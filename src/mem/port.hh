@@ -174,6 +174,16 @@ class RequestPort: public Port, public AtomicRequestProtocol,
      */
     virtual bool isSnooping() const { return false; }
 
+    /**
+     * Determine if this request port may hold copies of the data it
+     * accesses, and so has to be snooped before memory is accessed
+     * directly through a backdoor. A snooping port is assumed to, unless
+     * it only snoops to watch for accesses, as the CPUs do.
+     *
+     * @return true if the port may hold copies of the data
+     */
+    virtual bool isCaching() const { return isSnooping(); }
+
     /**
      * Get the address ranges of the connected responder port.
      */
@@ -374,6 +384,13 @@ class ResponsePort : public Port, public AtomicResponseProtocol,
      */
     bool isSnooping() const { return _requestPort->isSnooping(); }
 
+    /**
+     * Find out if the peer request port may hold copies of the data.
+     *
+     * @return true if the peer request port may hold copies of the data
+     */
+    bool isCaching() const { return _requestPort->isCaching(); }
+
     /**
      * Called by the owner to send a range change
      */
@@ -37,6 +37,8 @@
 
 #include "mem/port_proxy.hh"
 
+#include <cstring>
+
 #include "base/chunk_generator.hh"
 #include "cpu/thread_context.hh"
 #include "mem/port.hh"
@@ -46,6 +48,9 @@ namespace gem5
 
 PortProxy::PortProxy(ThreadContext *tc, Addr cache_line_size) :
     PortProxy([tc](PacketPtr pkt)->void { tc->sendFunctional(pkt); },
+        [tc](const MemBackdoorReq &req, MemBackdoorPtr &backdoor)->void {
+            tc->sendMemBackdoorReq(req, backdoor);
+        },
         cache_line_size)
 {}
 
@@ -54,10 +59,40 @@ PortProxy::PortProxy(const RequestPort &port, Addr cache_line_size) :
         cache_line_size)
 {}
 
+uint8_t *
+PortProxy::backdoorPtr(Addr addr, uint64_t size,
+                       MemBackdoor::Flags flags) const
+{
+    // A single line is no cheaper to access through a backdoor than with a
+    // packet once the cost of finding the backdoor is taken into account.
+    if (!sendMemBackdoorReq || size <= _cacheLineSize)
+        return nullptr;
+
+    // Backdoors are requested again for every blob rather than being kept
+    // around, so there is no need to track their invalidation.
+    MemBackdoorPtr backdoor = nullptr;
+    sendMemBackdoorReq(MemBackdoorReq(RangeSize(addr, size), flags),
+                       backdoor);
+    if (!backdoor || (backdoor->flags() & flags) != flags)
+        return nullptr;
+
+    const AddrRange &range = backdoor->range();
+    if (range.interleaved() || addr < range.start() ||
+            addr + size > range.end()) {
+        return nullptr;
+    }
+    return backdoor->ptr() + (addr - range.start());
+}
+
 void
 PortProxy::readBlobPhys(Addr addr, Request::Flags flags,
                         void *p, uint64_t size) const
 {
+    if (uint8_t *host = backdoorPtr(addr, size, MemBackdoor::Readable)) {
+        std::memcpy(p, host, size);
+        return;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
@@ -75,6 +110,11 @@ void
 PortProxy::writeBlobPhys(Addr addr, Request::Flags flags,
                          const void *p, uint64_t size) const
 {
+    if (uint8_t *host = backdoorPtr(addr, size, MemBackdoor::Writeable)) {
+        std::memcpy(host, p, size);
+        return;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
@@ -92,6 +132,11 @@ void
 PortProxy::memsetBlobPhys(Addr addr, Request::Flags flags,
                           uint8_t v, uint64_t size) const
 {
+    if (uint8_t *host = backdoorPtr(addr, size, MemBackdoor::Writeable)) {
+        std::memset(host, v, size);
+        return;
+    }
+
     // quick and dirty...
     uint8_t *buf = new uint8_t[size];
 
@@ -60,6 +60,7 @@
 #include <functional>
 #include <limits>
 
+#include "mem/backdoor.hh"
 #include "mem/protocol/functional.hh"
 #include "sim/byteswap.hh"
 
@@ -80,6 +81,13 @@ class ThreadContext;
  *
  * The addresses are interpreted as physical addresses.
  *
+ * If the proxy was given a way to request memory backdoors, blobs are
+ * copied directly to or from the host memory backing the target range
+ * when a backdoor covering it is handed out, and split into cache line
+ * sized functional packets otherwise. Caches never hand out backdoors, so
+ * the packet path is still used whenever a cache could hold a newer copy
+ * of the data.
+ *
  * @sa SETranslatingProxy
  * @sa FSTranslatingProxy
  */
@@ -87,9 +95,13 @@ class PortProxy : FunctionalRequestProtocol
 {
   public:
     typedef std::function<void(PacketPtr pkt)> SendFunctionalFunc;
+    typedef std::function<void(const MemBackdoorReq &req,
+                               MemBackdoorPtr &backdoor)>
+        SendMemBackdoorReqFunc;
 
   private:
     SendFunctionalFunc sendFunctional;
+    SendMemBackdoorReqFunc sendMemBackdoorReq;
 
     /** Granularity of any transactions issued through this proxy. */
     const Addr _cacheLineSize;
@@ -102,11 +114,25 @@ class PortProxy : FunctionalRequestProtocol
         panic("Port proxies should never receive snoops.");
     }
 
+    /**
+     * Find host memory backing the whole physical range [addr, addr+size).
+     * @return A pointer to the byte at addr, or nullptr if there is no
+     * suitable backdoor.
+     */
+    uint8_t *backdoorPtr(Addr addr, uint64_t size,
+                         MemBackdoor::Flags flags) const;
+
   public:
     PortProxy(SendFunctionalFunc func, Addr cache_line_size) :
         sendFunctional(func), _cacheLineSize(cache_line_size)
     {}
 
+    PortProxy(SendFunctionalFunc func, SendMemBackdoorReqFunc backdoor_func,
+              Addr cache_line_size) :
+        sendFunctional(func), sendMemBackdoorReq(backdoor_func),
+        _cacheLineSize(cache_line_size)
+    {}
+
     // Helpers which create typical SendFunctionalFunc-s from other objects.
     PortProxy(ThreadContext *tc, Addr cache_line_size);
     PortProxy(const RequestPort &port, Addr cache_line_size);
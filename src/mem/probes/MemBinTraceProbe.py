@@ -0,0 +1,65 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.BaseMemProbe import BaseMemProbe
+from m5.params import *
+from m5.proxy import *
+
+
+class MemBinTraceProbe(BaseMemProbe):
+    """Packet tracer writing fixed size binary records, which is much
+    cheaper per packet than the protobuf based MemTraceProbe. Packets can
+    be sampled 1-in-N and filtered by address. Compression and file I/O
+    run on a background thread. Attach it to a CommMonitor like the
+    MemTraceProbe, and decode the trace with
+    util/decode_binary_packet_trace.py."""
+
+    type = "MemBinTraceProbe"
+    cxx_header = "mem/probes/mem_bin_trace.hh"
+    cxx_class = "gem5::MemBinTraceProbe"
+
+    trace_file = Param.String(
+        "", "Packet trace output file [Default: <name>.ptrc]"
+    )
+    with_pc = Param.Bool(False, "Include PC info in the trace")
+
+    sample_period = Param.UInt64(1, "Trace one in every N packets")
+    sample_ranges = VectorParam.AddrRange(
+        [], "Only trace packets to these ranges [Default: all]"
+    )
+
+    block_size = Param.Unsigned(
+        65536, "Number of packets compressed together"
+    )
+    max_pending = Param.Unsigned(
+        4, "Number of blocks queued for the writer thread before stalling"
+    )
+    compression_level = Param.Int(
+        1, "zlib compression level of the blocks, 0 to disable"
+    )
+
+    # System object to look up the name associated with a requestor ID
+    system = Param.System(Parent.any, "System the probe belongs to")
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/probes/mem_bin_trace.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "base/output.hh"
+#include "params/MemBinTraceProbe.hh"
+#include "sim/core.hh"
+#include "sim/cur_tick.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+template <typename T>
+void
+append(AsyncWriter::Block &out, const T &value)
+{
+    const size_t pos = out.size();
+    out.resize(pos + sizeof(T));
+    std::memcpy(out.data() + pos, &value, sizeof(T));
+}
+
+void
+appendString(AsyncWriter::Block &out, const std::string &str)
+{
+    append<uint32_t>(out, str.size());
+    out.insert(out.end(), str.begin(), str.end());
+}
+
+} // anonymous namespace
+
+MemBinTraceProbe::MemBinTraceProbe(const MemBinTraceProbeParams &p)
+    : BaseMemProbe(p),
+      system(p.system),
+      withPC(p.with_pc),
+      samplePeriod(std::max<uint64_t>(p.sample_period, 1)),
+      sampleRanges(p.sample_ranges),
+      blockSize(std::max<size_t>(p.block_size, 1)),
+      stats(this)
+{
+    const std::string filename = simout.resolve(
+        p.trace_file.empty() ? name() + ".ptrc" : p.trace_file);
+    writer.reset(new AsyncWriter(filename, p.max_pending,
+                                 p.compression_level));
+    block.reserve(blockSize * sizeof(Record));
+
+    registerExitCallback([this]() { closeStreams(); });
+}
+
+MemBinTraceProbe::~MemBinTraceProbe()
+{
+    closeStreams();
+}
+
+MemBinTraceProbe::
+MemBinTraceProbeStats::MemBinTraceProbeStats(MemBinTraceProbe *parent)
+    : statistics::Group(parent),
+      ADD_STAT(seenPackets, statistics::units::Count::get(),
+               "Number of packets seen by the probe"),
+      ADD_STAT(tracedPackets, statistics::units::Count::get(),
+               "Number of packets written to the trace")
+{
+}
+
+void
+MemBinTraceProbe::startup()
+{
+    AsyncWriter::Block header(Magic, Magic + sizeof(Magic));
+    append<uint32_t>(header, Version);
+    append<uint64_t>(header, sim_clock::Frequency);
+    append<uint64_t>(header, samplePeriod);
+    appendString(header, name());
+
+    append<uint32_t>(header, system->maxRequestors());
+    for (int i = 0; i < system->maxRequestors(); i++)
+        appendString(header, system->getRequestorName(i));
+
+    writer->write(std::move(header));
+}
+
+void
+MemBinTraceProbe::handleRequest(const probing::PacketInfo &pkt_info)
+{
+    stats.seenPackets++;
+
+    if (!sampleRanges.empty()) {
+        auto in_range = [&pkt_info](const AddrRange &r) {
+            return r.contains(pkt_info.addr);
+        };
+        if (std::none_of(sampleRanges.begin(), sampleRanges.end(), in_range))
+            return;
+    }
+
+    if (countdown) {
+        countdown--;
+        return;
+    }
+    countdown = samplePeriod - 1;
+
+    const Record rec = {
+        curTick(),
+        pkt_info.addr,
+        withPC ? pkt_info.pc : 0,
+        pkt_info.flags,
+        pkt_info.size,
+        static_cast<uint16_t>(pkt_info.cmd.toInt()),
+        static_cast<uint16_t>(pkt_info.id),
+    };
+    append(block, rec);
+    stats.tracedPackets++;
+
+    if (block.size() >= blockSize * sizeof(Record))
+        writeBlock();
+}
+
+void
+MemBinTraceProbe::writeBlock()
+{
+    if (block.empty() || !writer)
+        return;
+
+    AsyncWriter::Block full;
+    full.reserve(blockSize * sizeof(Record));
+    full.swap(block);
+    writer->write(std::move(full));
+}
+
+void
+MemBinTraceProbe::closeStreams()
+{
+    if (!writer)
+        return;
+
+    writeBlock();
+    writer->close();
+    if (writer->stalls()) {
+        warn("%s: Tracing stalled %d times waiting for the trace writer.",
+             name(), writer->stalls());
+    }
+    writer.reset();
+}
+
+} // namespace gem5
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_PROBES_MEM_BIN_TRACE_HH__
+#define __MEM_PROBES_MEM_BIN_TRACE_HH__
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/addr_range.hh"
+#include "base/async_writer.hh"
+#include "base/statistics.hh"
+#include "mem/probes/base.hh"
+
+namespace gem5
+{
+
+struct MemBinTraceProbeParams;
+class System;
+
+/**
+ * Packet tracer writing fixed size binary records. Records are appended
+ * to a block buffer, so tracing a packet costs a copy of a few words
+ * rather than building and serializing a protobuf message. Full blocks
+ * are compressed and written by an AsyncWriter thread.
+ *
+ * The first block of the file is a header with the tick frequency, the
+ * sampling settings and the requestor names. It is followed by blocks of
+ * Record structures.
+ */
+class MemBinTraceProbe : public BaseMemProbe
+{
+  public:
+    static constexpr char Magic[8] = {'g', 'e', 'm', '5', 'p', 't', 'r', 0};
+    static constexpr uint32_t Version = 1;
+
+    /** Layout of a packet in the trace, little endian. */
+    struct Record
+    {
+        uint64_t tick;
+        uint64_t addr;
+        /** PC of the request, 0 if unknown or with_pc is not set. */
+        uint64_t pc;
+        uint64_t flags;
+        uint32_t size;
+        uint16_t cmd;
+        uint16_t requestor;
+    };
+    static_assert(sizeof(Record) == 40, "Unexpected record padding");
+
+    MemBinTraceProbe(const MemBinTraceProbeParams &params);
+    ~MemBinTraceProbe();
+
+    void startup() override;
+
+  protected:
+    void handleRequest(const probing::PacketInfo &pkt_info) override;
+
+    /** Queue the records gathered so far for writing. */
+    void writeBlock();
+
+    void closeStreams();
+
+    System *system;
+    const bool withPC;
+    const uint64_t samplePeriod;
+    const std::vector<AddrRange> sampleRanges;
+    const size_t blockSize;
+
+    /** Packets to skip before the next sample. */
+    uint64_t countdown = 0;
+
+    AsyncWriter::Block block;
+    std::unique_ptr<AsyncWriter> writer;
+
+    struct MemBinTraceProbeStats : public statistics::Group
+    {
+        MemBinTraceProbeStats(MemBinTraceProbe *parent);
+
+        statistics::Scalar seenPackets;
+        statistics::Scalar tracedPackets;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif //__MEM_PROBES_MEM_BIN_TRACE_HH__
@@ -98,6 +98,9 @@ class QueuedResponsePort : public ResponsePort
      * functional request. */
     bool trySatisfyFunctional(PacketPtr pkt)
     { return respQueue.trySatisfyFunctional(pkt); }
+
+    /** Number of responses waiting to be sent. */
+    size_t respQueueSize() const { return respQueue.size(); }
 };
 
 /**
@@ -166,6 +169,9 @@ class QueuedRequestPort : public RequestPort
         return reqQueue.trySatisfyFunctional(pkt) ||
             snoopRespQueue.trySatisfyFunctional(pkt);
     }
+
+    /** Number of requests waiting to be sent. */
+    size_t reqQueueSize() const { return reqQueue.size(); }
 };
 
 } // namespace gem5
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/queue_sampler.hh"
+
+#include <algorithm>
+#include <limits>
+
+#include "mem/cache/base.hh"
+#include "mem/mem_ctrl.hh"
+#include "mem/qport.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+template <typename T>
+void
+writeRaw(std::ostream &os, const T &value)
+{
+    os.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+} // anonymous namespace
+
+QueueSampler::QueueSampler(const Params &p)
+    : SimObject(p), interval(p.interval), outputName(p.output),
+      output(nullptr),
+      sampleEvent([this]{ sample(); }, name())
+{
+    fatal_if(interval == 0, "%s: interval must be at least one tick.",
+             name());
+
+    for (auto *cache : p.caches) {
+        const std::string prefix = cache->name() + ".";
+        const MSHRQueue &mshrs = cache->getMSHRQueue();
+        addSeries(prefix + "mshrs", mshrs.capacity(),
+                  [&mshrs]() { return mshrs.numAllocated(); });
+        const WriteQueue &wb = cache->getWriteBuffer();
+        addSeries(prefix + "write_buffer", wb.capacity(),
+                  [&wb]() { return wb.numAllocated(); });
+
+        auto *cpu_side =
+            dynamic_cast<QueuedResponsePort *>(&cache->getPort("cpu_side"));
+        if (cpu_side) {
+            addSeries(prefix + "cpu_side", 0,
+                      [cpu_side]() { return cpu_side->respQueueSize(); });
+        }
+        auto *mem_side =
+            dynamic_cast<QueuedRequestPort *>(&cache->getPort("mem_side"));
+        if (mem_side) {
+            addSeries(prefix + "mem_side", 0,
+                      [mem_side]() { return mem_side->reqQueueSize(); });
+        }
+    }
+
+    for (auto *ctrl : p.mem_ctrls) {
+        const std::string prefix = ctrl->name() + ".";
+        // Reads hold their buffer entry until the response is sent, as
+        // in MemCtrl::readQueueFull().
+        addSeries(prefix + "read_queue", ctrl->getReadBufferSize(),
+                  [ctrl]() {
+                      return ctrl->getTotalReadQueueSize() +
+                          ctrl->getRespQueueSize();
+                  });
+        addSeries(prefix + "write_queue", ctrl->getWriteBufferSize(),
+                  [ctrl]() { return ctrl->getTotalWriteQueueSize(); });
+
+        auto *port = dynamic_cast<QueuedResponsePort *>(
+            &ctrl->getPort("port"));
+        if (port) {
+            addSeries(prefix + "port", 0,
+                      [port]() { return port->respQueueSize(); });
+        }
+    }
+
+    counts.resize(series.size());
+
+    registerExitCallback([this]() { close(); });
+}
+
+void
+QueueSampler::addSeries(const std::string &name, uint32_t capacity,
+                        std::function<size_t()> occupancy)
+{
+    series.push_back({name, capacity, std::move(occupancy)});
+}
+
+void
+QueueSampler::startup()
+{
+    SimObject::startup();
+
+    if (series.empty()) {
+        warn("%s: No queues to sample.", name());
+        return;
+    }
+
+    output = simout.create(outputName, true);
+    writeHeader();
+    schedule(sampleEvent, curTick());
+}
+
+void
+QueueSampler::writeHeader()
+{
+    std::ostream &os = *output->stream();
+    os.write(Magic, sizeof(Magic));
+    writeRaw<uint32_t>(os, Version);
+    writeRaw<uint64_t>(os, interval);
+    writeRaw<uint32_t>(os, series.size());
+    for (const auto &s : series) {
+        writeRaw<uint32_t>(os, s.name.size());
+        os.write(s.name.data(), s.name.size());
+        writeRaw<uint32_t>(os, s.capacity);
+    }
+}
+
+void
+QueueSampler::sample()
+{
+    if (!output)
+        return;
+
+    constexpr size_t max_count = std::numeric_limits<uint16_t>::max();
+    for (size_t i = 0; i < series.size(); ++i)
+        counts[i] = std::min(series[i].occupancy(), max_count);
+
+    std::ostream &os = *output->stream();
+    writeRaw<uint64_t>(os, curTick());
+    os.write(reinterpret_cast<const char *>(counts.data()),
+             counts.size() * sizeof(uint16_t));
+
+    schedule(sampleEvent, curTick() + interval);
+}
+
+void
+QueueSampler::close()
+{
+    if (output) {
+        simout.close(output);
+        output = nullptr;
+    }
+}
+
+} // namespace gem5
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_QUEUE_SAMPLER_HH__
+#define __MEM_QUEUE_SAMPLER_HH__
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/output.hh"
+#include "params/QueueSampler.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * Periodically samples the occupancy of the MSHRs, write buffers and
+ * port packet queues of caches, and of the read, write and response
+ * queues of memory controllers. Every sample is appended to a binary
+ * time series, with one 16-bit count per queue, which is plotted by
+ * util/plot_queue_occupancy.py. Sampling reads a few counters per queue,
+ * so it can be left on in long runs to find which level of the
+ * hierarchy saturates.
+ */
+class QueueSampler : public SimObject
+{
+  public:
+    /** Magic number and version at the start of the output file. */
+    static constexpr char Magic[8] = {'g', 'e', 'm', '5', 'q', 'o', 'c', 0};
+    static constexpr uint32_t Version = 1;
+
+  protected:
+    struct Series
+    {
+        std::string name;
+        /** Number of entries when full, 0 if unbounded. */
+        uint32_t capacity;
+        std::function<size_t()> occupancy;
+    };
+
+    std::vector<Series> series;
+
+    const Tick interval;
+    const std::string outputName;
+    OutputStream *output;
+
+    /** Counts of the current sample, flushed in one write. */
+    std::vector<uint16_t> counts;
+
+    void addSeries(const std::string &name, uint32_t capacity,
+                   std::function<size_t()> occupancy);
+
+    void writeHeader();
+    void sample();
+    void close();
+
+    EventFunctionWrapper sampleEvent;
+
+  public:
+    PARAMS(QueueSampler);
+    QueueSampler(const Params &p);
+
+    void startup() override;
+};
+
+} // namespace gem5
+
+#endif // __MEM_QUEUE_SAMPLER_HH__
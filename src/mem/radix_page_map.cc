@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/radix_page_map.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+thread_local RadixPageMap::LastLookup RadixPageMap::last;
+std::atomic<uint64_t> RadixPageMap::nextGeneration(0);
+
+RadixPageMap::Entry &
+RadixPageMap::Node::entry(unsigned i)
+{
+    if (!entries)
+        entries.reset(new Entry[Fanout]);
+    return entries[i];
+}
+
+std::unique_ptr<RadixPageMap::Node> &
+RadixPageMap::Node::child(unsigned i)
+{
+    if (!children)
+        children.reset(new std::unique_ptr<Node>[Fanout]);
+    return children[i];
+}
+
+RadixPageMap::RadixPageMap(Addr page_size) :
+    pageShift(floorLog2(page_size)),
+    numLevels(divCeil(64 - floorLog2(page_size), LevelBits)),
+    root(new Node), generation(++nextGeneration)
+{
+    assert(isPowerOf2(page_size));
+}
+
+RadixPageMap::~RadixPageMap() {}
+
+unsigned
+RadixPageMap::shift(unsigned level) const
+{
+    return pageShift + level * LevelBits;
+}
+
+unsigned
+RadixPageMap::index(Addr vaddr, unsigned level) const
+{
+    return (vaddr >> shift(level)) & (Fanout - 1);
+}
+
+uint64_t
+RadixPageMap::pagesIn(unsigned level) const
+{
+    return 1ULL << (level * LevelBits);
+}
+
+void
+RadixPageMap::split(Node &node, unsigned level, unsigned i)
+{
+    assert(level > 0 && node.leaves[i]);
+    const Entry huge = node.entries[i];
+
+    auto child = std::make_unique<Node>();
+    for (unsigned j = 0; j < Fanout; j++) {
+        child->entry(j) =
+            Entry(huge.paddr + ((Addr)j << shift(level - 1)), huge.flags);
+    }
+    child->leaves.set();
+    child->used = Fanout;
+
+    node.leaves.reset(i);
+    node.child(i) = std::move(child);
+}
+
+void
+RadixPageMap::setLeaf(Addr vaddr, unsigned level, const Entry &entry)
+{
+    Node *node = root.get();
+    for (unsigned l = numLevels - 1; l > level; l--) {
+        const unsigned i = index(vaddr, l);
+        if (node->leaves[i])
+            split(*node, l, i);
+        auto &child = node->child(i);
+        if (!child) {
+            child = std::make_unique<Node>();
+            node->used++;
+        }
+        node = child.get();
+    }
+
+    const unsigned i = index(vaddr, level);
+    if (node->leaves[i]) {
+        numPages -= pagesIn(level);
+    } else {
+        if (level > 0 && node->children && node->children[i]) {
+            // Whatever was mapped below this slot is replaced as a whole.
+            numPages -= countPages(*node->children[i], level - 1);
+            node->children[i].reset();
+        } else {
+            node->used++;
+        }
+        node->leaves.set(i);
+    }
+    node->entry(i) = entry;
+    numPages += pagesIn(level);
+}
+
+uint64_t
+RadixPageMap::countPages(const Node &node, unsigned level) const
+{
+    uint64_t count = 0;
+    for (unsigned i = 0; i < Fanout; i++) {
+        if (node.leaves[i])
+            count += pagesIn(level);
+        else if (level > 0 && node.children && node.children[i])
+            count += countPages(*node.children[i], level - 1);
+    }
+    return count;
+}
+
+void
+RadixPageMap::insert(Addr vaddr, Addr paddr, Addr size, uint64_t flags)
+{
+    assert((vaddr & mask(pageShift)) == 0);
+    assert((size & mask(pageShift)) == 0);
+
+    modified();
+    while (size) {
+        // Use the largest leaf which fits the rest of the region.
+        unsigned level = 0;
+        while (level + 1 < numLevels &&
+                (vaddr & mask(shift(level + 1))) == 0 &&
+                size > mask(shift(level + 1))) {
+            level++;
+        }
+        setLeaf(vaddr, level, Entry(paddr, flags));
+
+        const Addr step = (Addr)1 << shift(level);
+        vaddr += step;
+        paddr += step;
+        size -= step;
+    }
+}
+
+uint64_t
+RadixPageMap::eraseRange(Node &node, unsigned level, Addr lo, Addr hi)
+{
+    uint64_t count = 0;
+    const Addr base = lo & ~mask(shift(level) + LevelBits);
+    const unsigned last = index(hi, level);
+    for (unsigned i = index(lo, level); ; i++) {
+        const Addr slot_lo = base + ((Addr)i << shift(level));
+        const Addr slot_hi = slot_lo + mask(shift(level));
+        const Addr sub_lo = std::max(lo, slot_lo);
+        const Addr sub_hi = std::min(hi, slot_hi);
+
+        if (node.leaves[i]) {
+            if (sub_lo == slot_lo && sub_hi == slot_hi) {
+                node.leaves.reset(i);
+                node.used--;
+                count += pagesIn(level);
+            } else {
+                split(node, level, i);
+            }
+        }
+        if (!node.leaves[i] && level > 0 && node.children &&
+                node.children[i]) {
+            auto &child = node.children[i];
+            count += eraseRange(*child, level - 1, sub_lo, sub_hi);
+            if (child->used == 0) {
+                child.reset();
+                node.used--;
+            }
+        }
+
+        if (i == last)
+            break;
+    }
+    return count;
+}
+
+uint64_t
+RadixPageMap::erase(Addr vaddr, Addr size)
+{
+    assert((vaddr & mask(pageShift)) == 0);
+    if (!size)
+        return 0;
+
+    modified();
+    const uint64_t count =
+        eraseRange(*root, numLevels - 1, vaddr, vaddr + size - 1);
+    numPages -= count;
+    return count;
+}
+
+RadixPageMap::Leaf
+RadixPageMap::find(Addr vaddr) const
+{
+    const Node *node = root.get();
+    for (unsigned l = numLevels - 1; ; l--) {
+        const unsigned i = index(vaddr, l);
+        if (node->leaves[i]) {
+            Leaf leaf;
+            leaf.entry = node->entries[i];
+            leaf.vaddr = vaddr & ~mask(shift(l));
+            leaf.size = (Addr)1 << shift(l);
+            return leaf;
+        }
+        if (l == 0 || !node->children || !node->children[i])
+            return Leaf();
+        node = node->children[i].get();
+    }
+}
+
+std::optional<RadixPageMap::Entry>
+RadixPageMap::lookup(Addr vaddr)
+{
+    LastLookup &l = last;
+    if (l.map != this || l.generation != generation.load() ||
+            (vaddr >> l.shift) != l.tag) {
+        const Leaf leaf = find(vaddr);
+        if (!leaf.valid())
+            return std::nullopt;
+        l.map = this;
+        l.generation = generation.load();
+        l.leaf = leaf;
+        l.shift = floorLog2(leaf.size);
+        l.tag = vaddr >> l.shift;
+    }
+
+    // Pages within a huge leaf have no entry of their own.
+    const Addr page = vaddr & ~mask(pageShift);
+    return Entry(l.leaf.entry.paddr + (page - l.leaf.vaddr),
+                 l.leaf.entry.flags);
+}
+
+bool
+RadixPageMap::findMapped(const Node &node, unsigned level, Addr lo, Addr hi,
+                         Addr &found) const
+{
+    const Addr base = lo & ~mask(shift(level) + LevelBits);
+    const unsigned last = index(hi, level);
+    for (unsigned i = index(lo, level); ; i++) {
+        const Addr slot_lo = base + ((Addr)i << shift(level));
+        const Addr sub_lo = std::max(lo, slot_lo);
+
+        if (node.leaves[i]) {
+            found = sub_lo;
+            return true;
+        }
+        if (level > 0 && node.children && node.children[i]) {
+            const Addr sub_hi = std::min(hi, slot_lo + mask(shift(level)));
+            if (findMapped(*node.children[i], level - 1, sub_lo, sub_hi,
+                           found)) {
+                return true;
+            }
+        }
+
+        if (i == last)
+            return false;
+    }
+}
+
+bool
+RadixPageMap::findMapped(Addr vaddr, Addr size, Addr &found) const
+{
+    if (!size)
+        return false;
+    return findMapped(*root, numLevels - 1, vaddr & ~mask(pageShift),
+                      vaddr + size - 1, found);
+}
+
+void
+RadixPageMap::forEach(const Node &node, unsigned level, Addr base,
+        const std::function<void(Addr, const Entry &)> &func) const
+{
+    for (unsigned i = 0; i < Fanout; i++) {
+        const Addr slot = base + ((Addr)i << shift(level));
+        if (node.leaves[i]) {
+            const Entry &entry = node.entries[i];
+            for (uint64_t p = 0; p < pagesIn(level); p++) {
+                const Addr offset = p << pageShift;
+                func(slot + offset,
+                     Entry(entry.paddr + offset, entry.flags));
+            }
+        } else if (level > 0 && node.children && node.children[i]) {
+            forEach(*node.children[i], level - 1, slot, func);
+        }
+    }
+}
+
+void
+RadixPageMap::forEachPage(
+        const std::function<void(Addr, const Entry &)> &func) const
+{
+    forEach(*root, numLevels - 1, 0, func);
+}
+
+void
+RadixPageMap::clear()
+{
+    root = std::make_unique<Node>();
+    numPages = 0;
+    modified();
+}
+
+} // namespace gem5
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RADIX_PAGE_MAP_HH__
+#define __MEM_RADIX_PAGE_MAP_HH__
+
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A radix tree mapping virtual pages to physical addresses, used as the
+ * storage of EmulationPageTable. Each level of the tree resolves LevelBits
+ * bits of the virtual page number. A region which is aligned to and covers
+ * a whole slot of an upper level is stored there as a single huge leaf, so
+ * mapping a large heap only touches a handful of nodes. Huge leaves are
+ * split again when part of them is remapped or unmapped.
+ *
+ * The translation of the last leaf looked up is cached, so that runs of
+ * lookups to the same page or huge leaf don't walk the tree. Lookups may
+ * run concurrently from several threads, modifications may not. Entries
+ * are returned by value, so they stay valid whatever happens to the map
+ * afterwards.
+ */
+class RadixPageMap
+{
+  public:
+    struct Entry
+    {
+        Addr paddr;
+        uint64_t flags;
+
+        Entry(Addr paddr, uint64_t flags) : paddr(paddr), flags(flags) {}
+        Entry() {}
+    };
+
+    /** A leaf of the tree and the region of virtual memory it maps. */
+    struct Leaf
+    {
+        /** Entry of the leaf; paddr is the address of vaddr. */
+        Entry entry;
+        Addr vaddr = 0;
+        /** Size of the region, 0 if there is no leaf. */
+        Addr size = 0;
+
+        bool valid() const { return size != 0; }
+    };
+
+    static constexpr unsigned LevelBits = 9;
+    static constexpr unsigned Fanout = 1 << LevelBits;
+
+  private:
+    struct Node
+    {
+        /** Slots which hold a leaf rather than a child node. */
+        std::bitset<Fanout> leaves;
+        /** Number of slots holding either a leaf or a child. */
+        unsigned used = 0;
+        std::unique_ptr<Entry[]> entries;
+        std::unique_ptr<std::unique_ptr<Node>[]> children;
+
+        Entry &entry(unsigned i);
+        std::unique_ptr<Node> &child(unsigned i);
+    };
+
+    const unsigned pageShift;
+    const unsigned numLevels;
+    std::unique_ptr<Node> root;
+    uint64_t numPages = 0;
+
+    /**
+     * The last leaf looked up by a thread. Each host thread keeps its own,
+     * so maps can be looked up concurrently as long as they aren't
+     * modified at the same time.
+     */
+    struct LastLookup
+    {
+        const RadixPageMap *map = nullptr;
+        uint64_t generation = 0;
+        unsigned shift = 0;
+        Addr tag = 0;
+        Leaf leaf;
+    };
+    static thread_local LastLookup last;
+
+    /** Changed on every modification, to invalidate LastLookup. */
+    std::atomic<uint64_t> generation;
+    static std::atomic<uint64_t> nextGeneration;
+
+    void modified() { generation = ++nextGeneration; }
+
+    unsigned shift(unsigned level) const;
+    unsigned index(Addr vaddr, unsigned level) const;
+    uint64_t pagesIn(unsigned level) const;
+
+    /** Replace the huge leaf in slot i of node by a child of leaves. */
+    void split(Node &node, unsigned level, unsigned i);
+    void setLeaf(Addr vaddr, unsigned level, const Entry &entry);
+
+    uint64_t countPages(const Node &node, unsigned level) const;
+
+    // The helpers below work on the inclusive range [lo, hi], which must
+    // be within the region covered by node.
+    uint64_t eraseRange(Node &node, unsigned level, Addr lo, Addr hi);
+    bool findMapped(const Node &node, unsigned level, Addr lo, Addr hi,
+                    Addr &found) const;
+    void forEach(const Node &node, unsigned level, Addr base,
+            const std::function<void(Addr, const Entry &)> &func) const;
+
+  public:
+    /**
+     * @param page_size Size of the smallest page, a power of 2.
+     */
+    RadixPageMap(Addr page_size);
+    ~RadixPageMap();
+
+    /**
+     * Map size bytes at vaddr to paddr, replacing any existing mappings.
+     * vaddr and size must be page aligned.
+     */
+    void insert(Addr vaddr, Addr paddr, Addr size, uint64_t flags);
+
+    /**
+     * Remove any mappings of the size bytes at vaddr.
+     * @return The number of pages which were unmapped.
+     */
+    uint64_t erase(Addr vaddr, Addr size);
+
+    /** Find the leaf mapping vaddr, if any. */
+    Leaf find(Addr vaddr) const;
+
+    /** Look up the entry of the page containing vaddr, if it is mapped. */
+    std::optional<Entry> lookup(Addr vaddr);
+
+    /**
+     * Check for mappings in the size bytes at vaddr.
+     * @param found Set to the first mapped page found.
+     * @return True if any page in the region is mapped.
+     */
+    bool findMapped(Addr vaddr, Addr size, Addr &found) const;
+
+    /** Call func on each mapped page, in order of virtual address. */
+    void forEachPage(
+            const std::function<void(Addr, const Entry &)> &func) const;
+
+    /** Number of pages mapped. */
+    uint64_t pages() const { return numPages; }
+
+    void clear();
+};
+
+} // namespace gem5
+
+#endif // __MEM_RADIX_PAGE_MAP_HH__
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "mem/radix_page_map.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+constexpr Addr PageSize = 0x1000;
+constexpr Addr HugeSize = PageSize * RadixPageMap::Fanout;
+
+} // anonymous namespace
+
+/** Test that single pages are mapped and looked up. */
+TEST(RadixPageMapTest, MapPages)
+{
+    RadixPageMap map(PageSize);
+    map.insert(0x10000, 0x80000, 2 * PageSize, 3);
+    EXPECT_EQ(map.pages(), 2);
+
+    auto entry = map.lookup(0x11234);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(entry->paddr, 0x81000);
+    EXPECT_EQ(entry->flags, 3);
+    EXPECT_FALSE(map.lookup(0x12000));
+    EXPECT_FALSE(map.lookup(0xf000));
+
+    auto leaf = map.find(0x10010);
+    ASSERT_TRUE(leaf.valid());
+    EXPECT_EQ(leaf.vaddr, 0x10000);
+    EXPECT_EQ(leaf.size, PageSize);
+}
+
+/** Test that aligned regions are stored as huge leaves. */
+TEST(RadixPageMapTest, HugeLeaves)
+{
+    RadixPageMap map(PageSize);
+    // One page, one huge leaf and one page.
+    map.insert(HugeSize - PageSize, 0x100000, HugeSize + 2 * PageSize, 0);
+    EXPECT_EQ(map.pages(), RadixPageMap::Fanout + 2);
+
+    auto leaf = map.find(HugeSize + 0x1234);
+    ASSERT_TRUE(leaf.valid());
+    EXPECT_EQ(leaf.vaddr, HugeSize);
+    EXPECT_EQ(leaf.size, HugeSize);
+    EXPECT_EQ(leaf.entry.paddr, 0x100000 + PageSize);
+
+    // Pages in a huge leaf are translated individually.
+    auto entry = map.lookup(HugeSize + 5 * PageSize + 0x10);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(entry->paddr, 0x100000 + 6 * PageSize);
+    entry = map.lookup(2 * HugeSize);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(entry->paddr, 0x100000 + HugeSize + PageSize);
+}
+
+/** Test that unmapping part of a huge leaf splits it. */
+TEST(RadixPageMapTest, SplitOnErase)
+{
+    RadixPageMap map(PageSize);
+    map.insert(HugeSize, 0x200000, HugeSize, 1);
+    EXPECT_EQ(map.erase(HugeSize + PageSize, 2 * PageSize), 2);
+    EXPECT_EQ(map.pages(), RadixPageMap::Fanout - 2);
+
+    EXPECT_TRUE(map.lookup(HugeSize));
+    EXPECT_FALSE(map.lookup(HugeSize + PageSize));
+    EXPECT_FALSE(map.lookup(HugeSize + 2 * PageSize));
+    auto entry = map.lookup(HugeSize + 3 * PageSize);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(entry->paddr, 0x200000 + 3 * PageSize);
+    EXPECT_EQ(map.find(HugeSize + 3 * PageSize).size, PageSize);
+
+    EXPECT_EQ(map.erase(0, 4 * HugeSize), RadixPageMap::Fanout - 2);
+    EXPECT_EQ(map.pages(), 0);
+    EXPECT_FALSE(map.lookup(HugeSize));
+}
+
+/** Test that mapping over existing pages replaces them. */
+TEST(RadixPageMapTest, Clobber)
+{
+    RadixPageMap map(PageSize);
+    map.insert(HugeSize + PageSize, 0x1000, 3 * PageSize, 0);
+    map.insert(HugeSize, 0x400000, HugeSize, 2);
+    EXPECT_EQ(map.pages(), RadixPageMap::Fanout);
+    EXPECT_EQ(map.lookup(HugeSize + PageSize)->paddr, 0x400000 + PageSize);
+
+    map.insert(HugeSize + PageSize, 0x1000, PageSize, 0);
+    EXPECT_EQ(map.pages(), RadixPageMap::Fanout);
+    EXPECT_EQ(map.lookup(HugeSize + PageSize)->paddr, 0x1000);
+    EXPECT_EQ(map.lookup(HugeSize + 2 * PageSize)->paddr,
+              0x400000 + 2 * PageSize);
+}
+
+/** Test searching a region for mapped pages. */
+TEST(RadixPageMapTest, FindMapped)
+{
+    RadixPageMap map(PageSize);
+    map.insert(0x7000000, 0, PageSize, 0);
+
+    Addr found = 0;
+    EXPECT_FALSE(map.findMapped(0, 0x7000000, found));
+    EXPECT_TRUE(map.findMapped(0, 0x7000001, found));
+    EXPECT_EQ(found, 0x7000000);
+    EXPECT_TRUE(map.findMapped(0x7000000, PageSize, found));
+    EXPECT_FALSE(map.findMapped(0x7001000, 1ULL << 40, found));
+}
+
+/** Test that the top of the address space can be mapped. */
+TEST(RadixPageMapTest, TopOfAddressSpace)
+{
+    RadixPageMap map(PageSize);
+    const Addr vaddr = 0xffffffffff600000ULL;
+    map.insert(vaddr, 0x3000, PageSize, 0);
+    EXPECT_EQ(map.lookup(vaddr + 0xfff)->paddr, 0x3000);
+
+    Addr found = 0;
+    EXPECT_TRUE(map.findMapped(vaddr, PageSize, found));
+    EXPECT_EQ(found, vaddr);
+    EXPECT_EQ(map.erase(vaddr, PageSize), 1);
+    EXPECT_FALSE(map.lookup(vaddr));
+}
+
+/** Test that the entries looked up outlive later lookups and changes. */
+TEST(RadixPageMapTest, EntriesAreCopies)
+{
+    RadixPageMap map(PageSize);
+    map.insert(HugeSize, 0x100000, HugeSize, 1);
+    map.insert(3 * HugeSize, 0x800000, PageSize, 2);
+
+    auto in_huge = map.lookup(HugeSize + PageSize);
+    auto in_page = map.lookup(3 * HugeSize);
+    map.lookup(HugeSize + 2 * PageSize);
+    map.erase(HugeSize, HugeSize);
+    map.insert(3 * HugeSize, 0x900000, PageSize, 3);
+
+    ASSERT_TRUE(in_huge);
+    EXPECT_EQ(in_huge->paddr, 0x100000 + PageSize);
+    EXPECT_EQ(in_huge->flags, 1);
+    ASSERT_TRUE(in_page);
+    EXPECT_EQ(in_page->paddr, 0x800000);
+    EXPECT_EQ(in_page->flags, 2);
+    EXPECT_EQ(map.lookup(3 * HugeSize)->paddr, 0x900000);
+}
+
+/** Test that pages are visited in order, with huge leaves expanded. */
+TEST(RadixPageMapTest, ForEachPage)
+{
+    RadixPageMap map(PageSize);
+    map.insert(HugeSize, 0x10000000, HugeSize, 0);
+    map.insert(0, 0x1000, PageSize, 0);
+
+    std::vector<std::pair<Addr, Addr>> pages;
+    map.forEachPage([&pages](Addr vaddr, const RadixPageMap::Entry &entry) {
+        pages.emplace_back(vaddr, entry.paddr);
+    });
+    ASSERT_EQ(pages.size(), RadixPageMap::Fanout + 1);
+    EXPECT_EQ(pages[0], std::make_pair(Addr(0), Addr(0x1000)));
+    EXPECT_EQ(pages[1], std::make_pair(HugeSize, Addr(0x10000000)));
+    EXPECT_EQ(pages.back(), std::make_pair(2 * HugeSize - PageSize,
+                                           0x10000000 + HugeSize - PageSize));
+}
+
+/** Test random mappings and unmappings against a map of single pages. */
+TEST(RadixPageMapTest, MatchesReference)
+{
+    RadixPageMap map(PageSize);
+    std::map<Addr, Addr> ref;
+    std::mt19937_64 rng(1);
+
+    for (int op = 0; op < 2000; op++) {
+        const Addr vaddr = (rng() % (8 * RadixPageMap::Fanout)) * PageSize;
+        const Addr size = (1 + rng() % (2 * RadixPageMap::Fanout)) * PageSize;
+        if (rng() % 3) {
+            const Addr paddr = (rng() % 0x100000) * PageSize;
+            map.insert(vaddr, paddr, size, 0);
+            for (Addr off = 0; off < size; off += PageSize)
+                ref[vaddr + off] = paddr + off;
+        } else {
+            uint64_t erased = 0;
+            for (Addr off = 0; off < size; off += PageSize)
+                erased += ref.erase(vaddr + off);
+            EXPECT_EQ(map.erase(vaddr, size), erased);
+        }
+        ASSERT_EQ(map.pages(), ref.size());
+
+        const Addr probe = (rng() % (10 * RadixPageMap::Fanout)) * PageSize;
+        auto entry = map.lookup(probe);
+        auto it = ref.find(probe);
+        ASSERT_EQ(entry.has_value(), it != ref.end());
+        if (entry) {
+            EXPECT_EQ(entry->paddr, it->second);
+        }
+    }
+
+    auto it = ref.begin();
+    map.forEachPage([&](Addr vaddr, const RadixPageMap::Entry &entry) {
+        ASSERT_NE(it, ref.end());
+        EXPECT_EQ(vaddr, it->first);
+        EXPECT_EQ(entry.paddr, it->second);
+        ++it;
+    });
+    EXPECT_EQ(it, ref.end());
+}
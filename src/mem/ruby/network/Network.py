@@ -49,6 +49,11 @@ class RubyNetwork(ClockedObject):
     )
     control_msg_size = Param.Int(8, "")
     ruby_system = Param.RubySystem("")
+    instantiation_cache = Param.String(
+        "",
+        "Directory in which routing tables are cached between runs of "
+        "the same topology. Set by --instantiation-cache.",
+    )
 
     routers = VectorParam.BasicRouter("Network routers")
     netifs = VectorParam.ClockedObject("Network Interfaces")
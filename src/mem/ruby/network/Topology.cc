@@ -29,8 +29,21 @@
 
 #include "mem/ruby/network/Topology.hh"
 
-#include <cassert>
+#include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <thread>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/common/NetDest.hh"
@@ -46,6 +59,16 @@ namespace ruby
 
 const int INFINITE_LATENCY = 10000; // Yes, this is a big hack
 
+namespace
+{
+
+// Routing cache files start with this, followed by the size of the key,
+// the key the tables were computed for and the distances to each
+// destination, all as native integers.
+constexpr char RoutingCacheMagic[8] = {'g', '5', 'r', 'o', 'u', 't', 'e', 2};
+
+} // anonymous namespace
+
 // Note: In this file, we use the first 2*m_nodes SwitchIDs to
 // represent the input and output endpoint links.  These really are
 // not 'switches', as they will not have a Switch object allocated for
@@ -56,10 +79,12 @@ const int INFINITE_LATENCY = 10000; // Yes, this is a big hack
 Topology::Topology(uint32_t num_nodes, uint32_t num_routers,
                    uint32_t num_vnets,
                    const std::vector<BasicExtLink *> &ext_links,
-                   const std::vector<BasicIntLink *> &int_links)
+                   const std::vector<BasicIntLink *> &int_links,
+                   const std::string &cache_dir)
     : m_nodes(MachineType_base_number(MachineType_NUM)),
       m_number_of_switches(num_routers), m_vnets(num_vnets),
-      m_ext_link_vector(ext_links), m_int_link_vector(int_links)
+      m_ext_link_vector(ext_links), m_int_link_vector(int_links),
+      m_cache_dir(cache_dir)
 {
     // Total nodes/controllers in network
     assert(m_nodes > 1);
@@ -122,32 +147,16 @@ Topology::createLinks(Network *net)
         max_switch_id = std::max(max_switch_id, src_dest.first);
         max_switch_id = std::max(max_switch_id, src_dest.second);
     }
-
-    // Initialize weight, latency, and inter switched vectors
     int num_switches = max_switch_id+1;
-    Matrix topology_weights(m_vnets,
-            std::vector<std::vector<int>>(num_switches,
-            std::vector<int>(num_switches, INFINITE_LATENCY)));
-    Matrix component_latencies(num_switches,
-            std::vector<std::vector<int>>(num_switches,
-            std::vector<int>(m_vnets, -1)));
-    Matrix component_inter_switches(num_switches,
-            std::vector<std::vector<int>>(num_switches,
-            std::vector<int>(m_vnets, 0)));
-
-    // Set identity weights to zero
-    for (int i = 0; i < topology_weights[0].size(); i++) {
-        for (int v = 0; v < m_vnets; v++) {
-            topology_weights[v][i][i] = 0;
-        }
-    }
 
-    // Fill in the topology weights and bandwidth multipliers
+    // Fill in the topology weights of each vnet. Only pairs of switches
+    // connected by links are kept, in the order of the link map.
+    WeightMap topology_weights;
     for (auto link_group : m_link_map) {
         std::pair<int, int> src_dest = link_group.first;
         std::vector<bool> vnet_done(m_vnets, 0);
-        int src = src_dest.first;
-        int dst = src_dest.second;
+        std::vector<int> &weights = topology_weights[src_dest];
+        weights.assign(m_vnets, INFINITE_LATENCY);
 
         // Iterate over all links for this source and destination
         std::vector<LinkEntry> link_entries = link_group.second;
@@ -160,8 +169,7 @@ Topology::createLinks(Network *net)
                     fatal_if(vnet_done[v], "Two links connecting same src"
                     " and destination cannot support same vnets");
 
-                    component_latencies[src][dst][v] = link->m_latency;
-                    topology_weights[v][src][dst] = link->m_weight;
+                    weights[v] = link->m_weight;
                     vnet_done[v] = true;
                 }
             } else {
@@ -174,8 +182,7 @@ Topology::createLinks(Network *net)
                     fatal_if(vnet_done[vnet], "Two links connecting same src"
                     " and destination cannot support same vnets");
 
-                    component_latencies[src][dst][vnet] = link->m_latency;
-                    topology_weights[vnet][src][dst] = link->m_weight;
+                    weights[vnet] = link->m_weight;
                     vnet_done[vnet] = true;
                 }
             }
@@ -183,34 +190,38 @@ Topology::createLinks(Network *net)
     }
 
     // Walk topology and hookup the links
-    Matrix dist = shortest_path(topology_weights, component_latencies,
-                                component_inter_switches);
-
-    for (int i = 0; i < topology_weights[0].size(); i++) {
-        for (int j = 0; j < topology_weights[0][i].size(); j++) {
-            std::vector<NetDest> routingMap;
-            routingMap.resize(m_vnets);
-
-            // Not all sources and destinations are connected
-            // by direct links. We only construct the links
-            // which have been configured in topology.
-            bool realLink = false;
-
-            for (int v = 0; v < m_vnets; v++) {
-                int weight = topology_weights[v][i][j];
-                if (weight > 0 && weight != INFINITE_LATENCY) {
-                    realLink = true;
-                    routingMap[v] =
-                        shortest_path_to_node(i, j, topology_weights, dist, v);
-                }
-            }
-            // Make one link for each set of vnets between
-            // a given source and destination. We do not
-            // want to create one link for each vnet.
-            if (realLink) {
-                makeLink(net, i, j, routingMap);
+    Matrix dist;
+    const std::vector<int> key = routingKey(num_switches, topology_weights);
+    const std::string cache_file = routingCacheFile(key);
+    if (cache_file.empty() || !loadRouting(cache_file, key, dist)) {
+        dist = shortest_paths(num_switches, topology_weights);
+        if (!cache_file.empty())
+            storeRouting(cache_file, key, dist);
+    }
+
+    for (const auto &[src_dest, weights] : topology_weights) {
+        const SwitchID i = src_dest.first;
+        const SwitchID j = src_dest.second;
+        std::vector<NetDest> routingMap;
+        routingMap.resize(m_vnets);
+
+        // Not all links carry all vnets. We only route the vnets which
+        // have been configured in topology.
+        bool realLink = false;
+
+        for (int v = 0; v < m_vnets; v++) {
+            int weight = weights[v];
+            if (weight > 0 && weight != INFINITE_LATENCY) {
+                realLink = true;
+                routingMap[v] = shortest_path_to_node(i, j, weight, dist, v);
             }
         }
+        // Make one link for each set of vnets between
+        // a given source and destination. We do not
+        // want to create one link for each vnet.
+        if (realLink) {
+            makeLink(net, i, j, routingMap);
+        }
     }
 }
 
@@ -330,88 +341,89 @@ Topology::makeLink(Network *net, SwitchID src, SwitchID dest,
     }
 }
 
-// The following all-pairs shortest path algorithm is based on the
-// discussion from Cormen et al., Chapter 26.1.
-void
-Topology::extend_shortest_path(Matrix &current_dist, Matrix &latencies,
-    Matrix &inter_switches)
+// Distances are computed towards each destination endpoint with
+// Dijkstra's algorithm over the reversed links, one vnet and destination
+// at a time. The searches are independent, so they are spread over host
+// threads. As before, distances saturate at INFINITE_LATENCY.
+Matrix
+Topology::shortest_paths(int num_switches, const WeightMap &weights)
 {
-    int nodes = current_dist[0].size();
-
-    // We find the shortest path for each vnet for a given pair of
-    // source and destinations. This is done simply by traversing via
-    // all other nodes and finding the minimum distance.
-    for (int v = 0; v < m_vnets; v++) {
-        // There is a different topology for each vnet. Here we try to
-        // build a topology by finding the minimum number of intermediate
-        // switches needed to reach the destination
-        bool change = true;
-        while (change) {
-            change = false;
-            for (int i = 0; i < nodes; i++) {
-                for (int j = 0; j < nodes; j++) {
-                    // We follow an iterative process to build the shortest
-                    // path tree:
-                    // 1. Start from the direct connection (if there is one,
-                    // otherwise assume a hypothetical infinite weight link).
-                    // 2. Then we iterate through all other nodes considering
-                    // new potential intermediate switches. If we find any
-                    // lesser weight combination, we set(update) that as the
-                    // new weight between the source and destination.
-                    // 3. Repeat for all pairs of nodes.
-                    // 4. Go to step 1 if there was any new update done in
-                    // Step 2.
-                    int minimum = current_dist[v][i][j];
-                    int previous_minimum = minimum;
-                    int intermediate_switch = -1;
-                    for (int k = 0; k < nodes; k++) {
-                        minimum = std::min(minimum,
-                            current_dist[v][i][k] + current_dist[v][k][j]);
-                        if (previous_minimum != minimum) {
-                            intermediate_switch = k;
-                            inter_switches[i][j][v] =
-                                inter_switches[i][k][v] +
-                                inter_switches[k][j][v] + 1;
-                        }
-                        previous_minimum = minimum;
-                    }
-                    if (current_dist[v][i][j] != minimum) {
-                        change = true;
-                        current_dist[v][i][j] = minimum;
-                        assert(intermediate_switch >= 0);
-                        assert(intermediate_switch < latencies[i].size());
-                        latencies[i][j][v] =
-                            latencies[i][intermediate_switch][v] +
-                            latencies[intermediate_switch][j][v];
+    // Links into each switch, per vnet, as (source, weight) pairs.
+    std::vector<std::vector<std::vector<std::pair<int, int>>>> links_to(
+        m_vnets, std::vector<std::vector<std::pair<int, int>>>(num_switches));
+    for (const auto &[src_dest, link_weights] : weights) {
+        for (int v = 0; v < m_vnets; v++) {
+            if (link_weights[v] != INFINITE_LATENCY) {
+                links_to[v][src_dest.second].emplace_back(
+                    src_dest.first, link_weights[v]);
+            }
+        }
+    }
+
+    Matrix dist(m_vnets, std::vector<std::vector<int>>(m_nodes));
+
+    auto search = [&](int vnet, int dest) {
+        std::vector<int> &d = dist[vnet][dest];
+        d.assign(num_switches, std::numeric_limits<int>::max());
+
+        // The destinations are the output endpoints of the network.
+        const int final = dest + m_nodes;
+        if (final < num_switches) {
+            typedef std::pair<int, int> Item;
+            std::priority_queue<Item, std::vector<Item>,
+                                std::greater<Item>> queue;
+            d[final] = 0;
+            queue.emplace(0, final);
+            while (!queue.empty()) {
+                const auto [node_dist, node] = queue.top();
+                queue.pop();
+                if (node_dist != d[node])
+                    continue;
+                for (const auto &[src, weight] : links_to[vnet][node]) {
+                    if (node_dist + weight < d[src]) {
+                        d[src] = node_dist + weight;
+                        queue.emplace(d[src], src);
                     }
                 }
             }
         }
-    }
-}
 
-Matrix
-Topology::shortest_path(const Matrix &weights, Matrix &latencies,
-                        Matrix &inter_switches)
-{
-    Matrix dist = weights;
-    extend_shortest_path(dist, latencies, inter_switches);
+        for (int &x : d)
+            x = std::min(x, INFINITE_LATENCY);
+    };
+
+    const unsigned searches = m_vnets * m_nodes;
+    std::atomic<unsigned> next_search(0);
+    auto worker = [&]() {
+        for (unsigned s; (s = next_search++) < searches;)
+            search(s / m_nodes, s % m_nodes);
+    };
+
+    const unsigned num_threads = std::max(1u,
+        std::min(std::thread::hardware_concurrency(), searches / 16));
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < num_threads; t++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto &thread : threads)
+        thread.join();
+
     return dist;
 }
 
 bool
 Topology::link_is_shortest_path_to_node(SwitchID src, SwitchID next,
-                                        SwitchID final, const Matrix &weights,
+                                        SwitchID final, int weight,
                                         const Matrix &dist, int vnet)
 {
-    return weights[vnet][src][next] + dist[vnet][next][final] ==
-        dist[vnet][src][final];
+    // dist only holds the distances to the output endpoints.
+    const std::vector<int> &to_final = dist[vnet][final - m_nodes];
+    return weight + to_final[next] == to_final[src];
 }
 
 NetDest
-Topology::shortest_path_to_node(SwitchID src, SwitchID next,
-                                const Matrix &weights, const Matrix &dist,
-                                int vnet)
+Topology::shortest_path_to_node(SwitchID src, SwitchID next, int weight,
+                                const Matrix &dist, int vnet)
 {
     NetDest result;
     int d = 0;
@@ -429,7 +441,7 @@ Topology::shortest_path_to_node(SwitchID src, SwitchID next,
             //  2*MachineType_base_number(MachineType_NUM)-1] for the
             // component network
             if (link_is_shortest_path_to_node(src, next, d + max_machines,
-                    weights, dist, vnet)) {
+                    weight, dist, vnet)) {
                 MachineID mach = {(MachineType)m, i};
                 result.add(mach);
             }
@@ -446,5 +458,105 @@ Topology::shortest_path_to_node(SwitchID src, SwitchID next,
     return result;
 }
 
+std::vector<int>
+Topology::routingKey(int num_switches, const WeightMap &weights) const
+{
+    std::vector<int> key = {m_vnets, (int)m_nodes, num_switches};
+    for (const auto &[src_dest, link_weights] : weights) {
+        key.push_back(src_dest.first);
+        key.push_back(src_dest.second);
+        key.insert(key.end(), link_weights.begin(), link_weights.end());
+    }
+    return key;
+}
+
+std::string
+Topology::routingCacheFile(const std::vector<int> &key) const
+{
+    if (m_cache_dir.empty())
+        return "";
+
+    // FNV-1a over the key. Files are checked against the full key when
+    // loaded, so collisions only cost a recomputation.
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int k : key) {
+        for (size_t b = 0; b < sizeof(k); b++) {
+            hash ^= (k >> (8 * b)) & 0xff;
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return csprintf("%s/ruby-routing-%016x.bin", m_cache_dir, hash);
+}
+
+bool
+Topology::loadRouting(const std::string &file, const std::vector<int> &key,
+                      Matrix &dist) const
+{
+    std::ifstream is(file, std::ios::binary);
+    if (!is)
+        return false;
+
+    char magic[sizeof(RoutingCacheMagic)];
+    uint64_t key_size = 0;
+    is.read(magic, sizeof(magic));
+    is.read(reinterpret_cast<char *>(&key_size), sizeof(key_size));
+    if (!is || std::memcmp(magic, RoutingCacheMagic, sizeof(magic))) {
+        warn("Ignoring invalid routing cache file %s.\n", file);
+        return false;
+    }
+    if (key_size != key.size())
+        return false;
+
+    std::vector<int> cached_key(key_size);
+    is.read(reinterpret_cast<char *>(cached_key.data()),
+            key_size * sizeof(int));
+    if (!is || cached_key != key)
+        return false;
+
+    // The key starts with the number of vnets, destinations and switches.
+    dist.assign(key[0], std::vector<std::vector<int>>(key[1],
+                std::vector<int>(key[2])));
+    for (auto &per_vnet : dist) {
+        for (auto &to_dest : per_vnet) {
+            is.read(reinterpret_cast<char *>(to_dest.data()),
+                    to_dest.size() * sizeof(int));
+        }
+    }
+    if (!is) {
+        warn("Ignoring truncated routing cache file %s.\n", file);
+        return false;
+    }
+
+    DPRINTF(RubyNetwork, "Loaded routing tables from %s\n", file);
+    return true;
+}
+
+void
+Topology::storeRouting(const std::string &file, const std::vector<int> &key,
+                       const Matrix &dist) const
+{
+    // Write to a private file first, so that concurrent runs sharing the
+    // cache never see a partial file.
+    const std::string tmp = csprintf("%s.%d", file, getpid());
+    const uint64_t key_size = key.size();
+    std::ofstream os(tmp, std::ios::binary);
+    os.write(RoutingCacheMagic, sizeof(RoutingCacheMagic));
+    os.write(reinterpret_cast<const char *>(&key_size), sizeof(key_size));
+    os.write(reinterpret_cast<const char *>(key.data()),
+             key.size() * sizeof(int));
+    for (const auto &per_vnet : dist) {
+        for (const auto &to_dest : per_vnet) {
+            os.write(reinterpret_cast<const char *>(to_dest.data()),
+                     to_dest.size() * sizeof(int));
+        }
+    }
+    os.close();
+
+    if (!os || std::rename(tmp.c_str(), file.c_str()) != 0) {
+        warn("Couldn't write routing cache file %s.\n", file);
+        std::remove(tmp.c_str());
+    }
+}
+
 } // namespace ruby
 } // namespace gem5
@@ -42,6 +42,8 @@
 #define __MEM_RUBY_NETWORK_TOPOLOGY_HH__
 
 #include <iostream>
+#include <map>
+#include <string>
 #include <vector>
 
 #include "mem/ruby/common/TypeDefines.hh"
@@ -58,13 +60,18 @@ class NetDest;
 class Network;
 
 /*
- * We use a three-dimensional vector matrix for calculating
- * the shortest paths for each pair of source and destination
- * and for each type of virtual network. The three dimensions
- * represent the source ID, destination ID, and vnet number.
+ * We use a three-dimensional vector matrix for the shortest distances
+ * to each destination for each type of virtual network. The three
+ * dimensions represent the vnet number, destination ID, and source ID.
  */
 typedef std::vector<std::vector<std::vector<int>>> Matrix;
 
+/*
+ * The weight of the links between a pair of switches for each vnet, or
+ * INFINITE_LATENCY for vnets they don't carry.
+ */
+typedef std::map<std::pair<SwitchID, SwitchID>, std::vector<int>> WeightMap;
+
 struct LinkEntry
 {
     BasicLink *link;
@@ -80,7 +87,8 @@ class Topology
   public:
     Topology(uint32_t num_nodes, uint32_t num_routers, uint32_t num_vnets,
              const std::vector<BasicExtLink *> &ext_links,
-             const std::vector<BasicIntLink *> &int_links);
+             const std::vector<BasicIntLink *> &int_links,
+             const std::string &cache_dir = "");
 
     uint32_t numSwitches() const { return m_number_of_switches; }
     void createLinks(Network *net);
@@ -93,20 +101,31 @@ class Topology
     void makeLink(Network *net, SwitchID src, SwitchID dest,
                   std::vector<NetDest>& routing_table_entry);
 
-    // Helper functions based on chapter 29 of Cormen et al.
-    void extend_shortest_path(Matrix &current_dist, Matrix &latencies,
-                              Matrix &inter_switches);
-
-    Matrix shortest_path(const Matrix &weights,
-            Matrix &latencies, Matrix &inter_switches);
+    /**
+     * Compute the shortest distance from every switch to every output
+     * endpoint.
+     * @return The distances, indexed by vnet, destination node and switch.
+     */
+    Matrix shortest_paths(int num_switches, const WeightMap &weights);
 
     bool link_is_shortest_path_to_node(SwitchID src, SwitchID next,
-            SwitchID final, const Matrix &weights, const Matrix &dist,
-            int vnet);
-
-    NetDest shortest_path_to_node(SwitchID src, SwitchID next,
-                                  const Matrix &weights, const Matrix &dist,
-                                  int vnet);
+            SwitchID final, int weight, const Matrix &dist, int vnet);
+
+    NetDest shortest_path_to_node(SwitchID src, SwitchID next, int weight,
+                                  const Matrix &dist, int vnet);
+
+    /**
+     * Routing tables only depend on the link weights, so runs of the
+     * same topology can share them through files in m_cache_dir.
+     */
+    std::vector<int> routingKey(int num_switches,
+                                const WeightMap &weights) const;
+    /** @return The path of the cache file for a key, if caching. */
+    std::string routingCacheFile(const std::vector<int> &key) const;
+    bool loadRouting(const std::string &file, const std::vector<int> &key,
+                     Matrix &dist) const;
+    void storeRouting(const std::string &file, const std::vector<int> &key,
+                      const Matrix &dist) const;
 
     const uint32_t m_nodes;
     const uint32_t m_number_of_switches;
@@ -116,6 +135,9 @@ class Topology
     std::vector<BasicIntLink*> m_int_link_vector;
 
     LinkMap m_link_map;
+
+    /** Directory caching routing tables, or empty to disable caching. */
+    const std::string m_cache_dir;
 };
 
 inline std::ostream&
@@ -121,6 +121,19 @@ class AbstractController : public ClockedObject, public Consumer
     virtual DMASequencer* getDMASequencer() const = 0;
     virtual GPUCoalescer* getGPUCoalescer() const = 0;
 
+    //! These functions are used by ruby system to warm up the caches from
+    //! a checkpointed cache trace without replaying it through the
+    //! protocol. A protocol opts in by defining installStable() in all of
+    //! its state machines. It is called on every controller for each
+    //! recorded block, owner being the controller that recorded it. The
+    //! owner places the block in a stable state and returns false if it
+    //! cannot, in which case the record is replayed instead. The other
+    //! controllers update their state to match, e.g. the directory.
+    virtual bool supportsStableInstall() const { return false; }
+    virtual bool installStable(const Addr &addr, const RubyRequestType &type,
+                               const MachineID &owner, const DataBlock &data)
+    { panic("installStable(Addr,...) not implemented"); }
+
     // This latency is used by the sequencer when enqueueing requests.
     // Different latencies may be used depending on the request type.
     // This is the hit latency unless the top-level cache controller
@@ -29,8 +29,11 @@
 
 #include "mem/ruby/system/CacheRecorder.hh"
 
+#include <cstring>
+
 #include "debug/RubyCacheTrace.hh"
 #include "mem/packet.hh"
+#include "mem/ruby/slicc_interface/AbstractController.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "mem/ruby/system/Sequencer.hh"
 #include "sim/sim_exit.hh"
@@ -168,6 +171,60 @@ CacheRecorder::enqueueNextFetchRequest()
     }
 }
 
+uint64_t
+CacheRecorder::installRecords(const std::vector<AbstractController*>& cntrls)
+{
+    const uint64_t record_size = sizeof(TraceRecord) + m_block_size_bytes;
+    const int block_size = RubySystem::getBlockSizeBytes();
+    uint64_t kept_bytes = 0;
+    uint64_t installed = 0;
+
+    for (uint64_t offset = 0; offset < m_uncompressed_trace_size;
+            offset += record_size) {
+        TraceRecord* traceRecord =
+            (TraceRecord*) (m_uncompressed_trace + offset);
+        AbstractController* owner = cntrls[traceRecord->m_cntrl_id];
+        const MachineID owner_id = owner->getMachineID();
+        bool complete = true;
+
+        for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
+                rec_bytes_read += block_size) {
+            Addr addr = traceRecord->m_data_address + rec_bytes_read;
+            DataBlock data;
+            data.setData(traceRecord->m_data + rec_bytes_read, 0,
+                         block_size);
+
+            if (!owner->installStable(addr, traceRecord->m_type, owner_id,
+                                      data)) {
+                complete = false;
+                continue;
+            }
+            for (auto cntrl : cntrls) {
+                panic_if(cntrl != owner &&
+                         !cntrl->installStable(addr, traceRecord->m_type,
+                                               owner_id, data),
+                         "%s failed to track %#x installed in %s\n",
+                         cntrl->name(), addr, owner->name());
+            }
+            installed++;
+        }
+
+        if (complete) {
+            DPRINTF(RubyCacheTrace, "Installed %s\n", *traceRecord);
+        } else {
+            // Keep the record so that it is fetched through the protocol.
+            // Blocks already installed will simply hit.
+            DPRINTF(RubyCacheTrace, "Deferring %s\n", *traceRecord);
+            std::memmove(m_uncompressed_trace + kept_bytes, traceRecord,
+                         record_size);
+            kept_bytes += record_size;
+        }
+    }
+
+    m_uncompressed_trace_size = kept_bytes;
+    return installed;
+}
+
 void
 CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                          RubyRequestType type, Tick time, DataBlock& data)
@@ -49,6 +49,7 @@ namespace gem5
 namespace ruby
 {
 
+class AbstractController;
 class Sequencer;
 class RubyPort;
 /*!
@@ -106,6 +107,20 @@ class CacheRecorder
      */
     void enqueueNextFetchRequest();
 
+    /*!
+     * Function for warming up the caches without going through the
+     * protocol. Each recorded block is installed directly in a stable
+     * state by the controller that recorded it, and the other
+     * controllers are told about it. This requires all the controllers
+     * to support it. The records that could not be installed are kept
+     * in the trace, so that they can be fetched as usual afterwards.
+     *
+     * @return The number of blocks installed.
+     */
+    uint64_t installRecords(const std::vector<AbstractController*>& cntrls);
+
+    bool hasPendingFetches() const { return m_uncompressed_trace_size > 0; }
+
   private:
     // Private copy constructor and assignment operator
     CacheRecorder(const CacheRecorder& obj);
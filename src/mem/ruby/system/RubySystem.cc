@@ -43,6 +43,7 @@
 #include <fcntl.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <list>
 
@@ -78,7 +79,7 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params &p)
     : ClockedObject(p), m_access_backing_store(p.access_backing_store),
-      m_cache_recorder(NULL)
+      m_fast_warmup(p.fast_warmup), m_cache_recorder(NULL)
 {
     m_randomization = p.randomization;
 
@@ -458,9 +459,26 @@ RubySystem::startup()
         setCurTick(0);
         resetClock();
 
+        if (m_fast_warmup) {
+            bool supported = std::all_of(m_abs_cntrl_vec.begin(),
+                m_abs_cntrl_vec.end(),
+                [](const AbstractController *cntrl)
+                { return cntrl->supportsStableInstall(); });
+            if (supported) {
+                uint64_t installed =
+                    m_cache_recorder->installRecords(m_abs_cntrl_vec);
+                DPRINTF(RubyCacheTrace, "Installed %d blocks\n", installed);
+            } else {
+                warn("Protocol cannot install blocks directly, replaying "
+                     "the cache trace instead.\n");
+            }
+        }
+
         // Schedule an event to start cache warmup
-        enqueueRubyEvent(curTick());
-        simulate();
+        if (m_cache_recorder->hasPendingFetches()) {
+            enqueueRubyEvent(curTick());
+            simulate();
+        }
 
         delete m_cache_recorder;
         m_cache_recorder = NULL;
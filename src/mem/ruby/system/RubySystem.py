@@ -57,6 +57,13 @@ class RubySystem(ClockedObject):
         store and only use ruby for timing.",
     )
 
+    fast_warmup = Param.Bool(
+        False,
+        "Install the cache contents of a checkpoint directly in stable "
+        "states, instead of replaying them through the protocol, if the "
+        "protocol supports it",
+    )
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
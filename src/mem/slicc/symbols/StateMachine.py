@@ -367,6 +367,7 @@ class $c_ident : public AbstractController
     void collateStats();
 
     void recordCacheTrace(int cntrl, CacheRecorder* tr);
+    bool supportsStableInstall() const;
     Sequencer* getCPUSequencer() const;
     DMASequencer* getDMASequencer() const;
     GPUCoalescer* getGPUCoalescer() const;
@@ -1228,10 +1229,19 @@ $c_ident::recordCacheTrace(int cntrl, CacheRecorder* tr)
                 code("m_${{param.ident}}_ptr->recordCacheContents(cntrl, tr);")
 
         code.dedent()
+        stable_install = any(
+            func.c_name == "installStable" for func in self.functions
+        )
         code(
             """
 }
 
+bool
+$c_ident::supportsStableInstall() const
+{
+    return ${{"true" if stable_install else "false"}};
+}
+
 // Actions
 """
         )
@@ -42,6 +42,7 @@
 
 #include "mem/snoop_filter.hh"
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/SnoopFilter.hh"
@@ -52,12 +53,129 @@ namespace gem5
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
+SnoopFilter::SnoopFilter(const SnoopFilterParams &p)
+    : SimObject(p), replacementPolicy(p.replacement_policy),
+      linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
+      maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
+      numSets(p.sets), assoc(p.assoc),
+      _requestorId(p.system->getRequestorId(this)),
+      stats(this)
+{
+    if (!isBounded())
+        return;
+
+    fatal_if(!isPowerOf2(numSets),
+             "%s: number of sets (%d) must be a power of 2\n",
+             name(), numSets);
+    fatal_if(assoc == 0, "%s: associativity must be non-zero\n", name());
+    fatal_if(!replacementPolicy,
+             "%s: a bounded snoop filter needs a replacement policy\n",
+             name());
+
+    entries.resize(numSets * assoc);
+    for (unsigned i = 0; i < entries.size(); ++i) {
+        entries[i].setPosition(i / assoc, i % assoc);
+        entries[i].replacementData = replacementPolicy->instantiateEntry();
+    }
+}
+
+Addr
+SnoopFilter::lineAddress(const Packet *cpkt) const
+{
+    Addr line_addr = cpkt->getBlockAddr(linesize);
+    if (cpkt->isSecure()) {
+        line_addr |= LineSecure;
+    }
+    return line_addr;
+}
+
+SnoopFilter::SnoopEntry *
+SnoopFilter::findEntry(Addr line_addr)
+{
+    const unsigned set = (line_addr / linesize) & (numSets - 1);
+    for (unsigned way = 0; way < assoc; ++way) {
+        SnoopEntry &entry = entries[set * assoc + way];
+        if (entry.valid && entry.lineAddr == line_addr)
+            return &entry;
+    }
+    return nullptr;
+}
+
+SnoopFilter::SnoopItem *
+SnoopFilter::findItem(Addr line_addr)
+{
+    if (isBounded()) {
+        if (SnoopEntry *entry = findEntry(line_addr))
+            return &entry->item;
+        // Only look in the overflow storage if it is in use at all
+        if (cachedLocations.empty())
+            return nullptr;
+    }
+    auto sf_it = cachedLocations.find(line_addr);
+    return sf_it == cachedLocations.end() ? nullptr : &sf_it->second;
+}
+
+SnoopFilter::SnoopItem *
+SnoopFilter::allocateItem(Addr line_addr, bool replace)
+{
+    if (!isBounded())
+        return &cachedLocations.emplace(line_addr, SnoopItem()).first->second;
+
+    // Prefer an invalid way, and otherwise only consider entries without
+    // requests in flight, as the responses have to find their entries
+    const unsigned set = (line_addr / linesize) & (numSets - 1);
+    SnoopEntry *victim = nullptr;
+    ReplacementCandidates candidates;
+    for (unsigned way = 0; way < assoc; ++way) {
+        SnoopEntry &entry = entries[set * assoc + way];
+        if (!entry.valid) {
+            victim = &entry;
+            break;
+        }
+        if (entry.item.requested.none())
+            candidates.push_back(&entry);
+    }
+
+    if (!victim && (candidates.empty() || !replace)) {
+        DPRINTF(SnoopFilter, "%s:   set %#x is busy, overflowing\n",
+                __func__, set);
+        stats.overflows++;
+        return &cachedLocations.emplace(line_addr, SnoopItem()).first->second;
+    }
+
+    if (!victim) {
+        victim = static_cast<SnoopEntry *>(
+            replacementPolicy->getVictim(candidates));
+        assert(victim->item.holder.any());
+
+        DPRINTF(SnoopFilter, "%s:   replacing %#x SF value %x.%x\n",
+                __func__, victim->lineAddr, victim->item.requested,
+                victim->item.holder);
+        pendingRecalls.push_back({victim->lineAddr & ~Addr(LineSecure),
+                                  bool(victim->lineAddr & LineSecure),
+                                  maskToPortList(victim->item.holder)});
+        stats.replacements++;
+        stats.recalledLines += victim->item.holder.count();
+    }
+
+    victim->valid = true;
+    victim->lineAddr = line_addr;
+    victim->item = SnoopItem();
+    replacementPolicy->reset(victim->replacementData);
+    return &victim->item;
+}
+
 void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::eraseIfNullEntry(Addr line_addr, SnoopItem &sf_item)
 {
-    SnoopItem& sf_item = sf_it->second;
     if ((sf_item.requested | sf_item.holder).none()) {
-        cachedLocations.erase(sf_it);
+        SnoopEntry *entry = isBounded() ? findEntry(line_addr) : nullptr;
+        if (entry) {
+            entry->valid = false;
+            replacementPolicy->invalidate(entry->replacementData);
+        } else {
+            cachedLocations.erase(line_addr);
+        }
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
                 __func__);
     }
@@ -73,26 +191,27 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
     // check if the packet came from a cache
     bool allocate = !cpkt->req->isUncacheable() && cpu_side_port.isSnooping()
         && cpkt->fromCache();
-    Addr line_addr = cpkt->getBlockAddr(linesize);
-    if (cpkt->isSecure()) {
-        line_addr |= LineSecure;
-    }
+    Addr line_addr = lineAddress(cpkt);
     SnoopMask req_port = portToMask(cpu_side_port);
-    reqLookupResult.it = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult.it != cachedLocations.end());
+    reqLookupResult.lineAddr = line_addr;
+    reqLookupResult.item = findItem(line_addr);
+    bool is_hit = reqLookupResult.item != nullptr;
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
-    // portlist.
-    if (!is_hit && !allocate)
+    // portlist. In a bounded filter, an eviction may also miss if the
+    // line was recalled while the eviction was on its way.
+    if (!is_hit && (!allocate || (isBounded() && cpkt->isEviction())))
         return snoopDown(lookupLatency);
 
-    // If no hit in snoop filter create a new element and update iterator
+    // If no hit in snoop filter create a new element
     if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
+        reqLookupResult.item = allocateItem(line_addr);
+    } else if (allocate && isBounded()) {
+        if (SnoopEntry *entry = findEntry(line_addr))
+            replacementPolicy->touch(entry->replacementData);
     }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    SnoopItem& sf_item = *reqLookupResult.item;
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -159,10 +278,10 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult.it != cachedLocations.end()) {
+    if (reqLookupResult.item) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
-        assert(reqLookupResult.it->first == \
+        assert(reqLookupResult.lineAddr == \
                 (is_secure ? ((addr & ~(Addr(linesize - 1))) | LineSecure) : \
                  (addr & ~(Addr(linesize - 1)))));
         if (will_retry) {
@@ -170,13 +289,14 @@ SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            *reqLookupResult.item = retry_item;
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retry_item.requested, retry_item.holder);
         }
 
-        eraseIfNullEntry(reqLookupResult.it);
+        eraseIfNullEntry(reqLookupResult.lineAddr, *reqLookupResult.item);
+        reqLookupResult.item = nullptr;
     }
 }
 
@@ -187,14 +307,12 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
 
     assert(cpkt->isRequest());
 
-    Addr line_addr = cpkt->getBlockAddr(linesize);
-    if (cpkt->isSecure()) {
-        line_addr |= LineSecure;
-    }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    Addr line_addr = lineAddress(cpkt);
+    SnoopItem *sf_found = findItem(line_addr);
+    bool is_hit = sf_found != nullptr;
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    panic_if(!is_hit && !isBounded() &&
+             (cachedLocations.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
@@ -204,7 +322,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_found;
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -234,7 +352,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         sf_item.holder = 0;
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_item);
     }
 
     return snoopSelected(maskToPortList(interested), lookupLatency);
@@ -258,13 +376,14 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
         return;
     }
 
-    Addr line_addr = cpkt->getBlockAddr(linesize);
-    if (cpkt->isSecure()) {
-        line_addr |= LineSecure;
-    }
+    Addr line_addr = lineAddress(cpkt);
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    SnoopItem *sf_found = findItem(line_addr);
+    // The request that caused the snoop is in flight, so its entry
+    // cannot have been replaced
+    panic_if(!sf_found, "SF has no entry for %s\n", cpkt->print());
+    SnoopItem& sf_item = *sf_found;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -307,22 +426,18 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     assert(cpkt->isResponse());
     assert(cpkt->cacheResponding());
 
-    Addr line_addr = cpkt->getBlockAddr(linesize);
-    if (cpkt->isSecure()) {
-        line_addr |= LineSecure;
-    }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    Addr line_addr = lineAddress(cpkt);
+    SnoopItem *sf_found = findItem(line_addr);
 
     // Nothing to do if it is not a hit
-    if (!is_hit)
+    if (!sf_found)
         return;
 
     // If the snoop response has no sharers the line is passed in
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem& sf_item = *sf_found;
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
@@ -330,7 +445,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
 
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_item);
     }
 }
 
@@ -349,16 +464,13 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
         return;
 
     // next check if we actually allocated an entry
-    Addr line_addr = cpkt->getBlockAddr(linesize);
-    if (cpkt->isSecure()) {
-        line_addr |= LineSecure;
-    }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    Addr line_addr = lineAddress(cpkt);
+    SnoopItem *sf_found = findItem(line_addr);
+    if (!sf_found)
         return;
 
     SnoopMask response_mask = portToMask(cpu_side_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_found;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -377,7 +489,7 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
         if (cpkt->isInvalidate()) {
             sf_item.holder &= ~response_mask;
         }
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_item);
     } else {
         // Any other response implies that a cache above will have the
         // block.
@@ -388,6 +500,25 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
             __func__, sf_item.requested, sf_item.holder);
 }
 
+void
+SnoopFilter::addHolder(const Packet* cpkt, const ResponsePort& cpu_side_port)
+{
+    DPRINTF(SnoopFilter, "%s: src %s packet %s\n",
+            __func__, cpu_side_port.name(), cpkt->print());
+
+    if (!cpu_side_port.isSnooping())
+        return;
+
+    Addr line_addr = lineAddress(cpkt);
+    SnoopItem *sf_item = findItem(line_addr);
+    if (!sf_item)
+        sf_item = allocateItem(line_addr, false);
+
+    sf_item->holder |= portToMask(cpu_side_port);
+    DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
+            __func__, sf_item->requested, sf_item->holder);
+}
+
 SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
     : statistics::Group(parent),
       ADD_STAT(totRequests, statistics::units::Count::get(),
@@ -405,7 +536,15 @@ SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
                "holder of the requested data."),
       ADD_STAT(hitMultiSnoops, statistics::units::Count::get(),
                "Number of snoops hitting in the snoop filter with multiple "
-               "(>1) holders of the requested data.")
+               "(>1) holders of the requested data."),
+      ADD_STAT(replacements, statistics::units::Count::get(),
+               "Number of entries replaced in a bounded snoop filter."),
+      ADD_STAT(recalledLines, statistics::units::Count::get(),
+               "Number of cached copies back-invalidated because their "
+               "entry was replaced."),
+      ADD_STAT(overflows, statistics::units::Count::get(),
+               "Number of allocations beyond the associativity because all "
+               "ways of the set had requests in flight.")
 {}
 
 void
@@ -46,7 +46,9 @@
 #include <bitset>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "mem/cache/replacement_policies/base.hh"
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
@@ -85,6 +87,14 @@ namespace gem5
  *     upper cache dropped a line, making the snoop filter pessimistic for now
  * (4) ordering: there is no single point of order in the system.  Instead,
  *     requesting MSHRs track order between local requests and remote snoops
+ *
+ * By default the tracking structure is unbounded. When configured with
+ * a number of sets, the filter instead models a finite, set-associative
+ * directory: each line address maps to a single set, and allocating
+ * into a full set replaces an entry chosen by the replacement policy.
+ * The line of the replaced entry is then recalled from the caches
+ * holding it (a back-invalidation), which the crossbar carries out
+ * after the lookup.
  */
 class SnoopFilter : public SimObject
 {
@@ -95,13 +105,18 @@ class SnoopFilter : public SimObject
 
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
-    SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
-        linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
-        maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
-        stats(this)
+    /**
+     * A line whose entry was replaced in a bounded filter, and that
+     * has to be invalidated in the caches above.
+     */
+    struct Recall
     {
-    }
+        Addr addr;
+        bool isSecure;
+        SnoopList ports;
+    };
+
+    SnoopFilter(const SnoopFilterParams &p);
 
     /**
      * Init a new snoop filter and tell it about all the cpu_sideports
@@ -200,6 +215,35 @@ class SnoopFilter : public SimObject
      */
     void updateResponse(const Packet *cpkt, const ResponsePort& cpu_side_port);
 
+    /**
+     * Record that a cache above holds a line it got without requesting
+     * it through this filter, as when its tags were warmed while the
+     * caches were bypassed. In a bounded filter, the line never replaces
+     * another one, as the caches holding that one may still be warming.
+     *
+     * @param cpkt          Packet for the line.
+     * @param cpu_side_port ResponsePort of the cache holding the line.
+     */
+    void addHolder(const Packet *cpkt, const ResponsePort& cpu_side_port);
+
+    /**
+     * Get the lines that were replaced by the last lookupRequest and
+     * have to be recalled from the listed ports. The filter no longer
+     * tracks these lines.
+     *
+     * @return Lines to back-invalidate, in order of replacement.
+     */
+    std::vector<Recall>
+    takeRecalls()
+    {
+        std::vector<Recall> recalls;
+        recalls.swap(pendingRecalls);
+        return recalls;
+    }
+
+    /** Requestor id used for the back-invalidation snoops. */
+    RequestorID requestorId() const { return _requestorId; }
+
     virtual void regStats();
 
   protected:
@@ -225,6 +269,17 @@ class SnoopFilter : public SimObject
      */
     typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
 
+    /**
+     * A way of the set-associative storage of a bounded filter.
+     */
+    struct SnoopEntry : public ReplaceableEntry
+    {
+        /** Line address, including the LineSecure bit. */
+        Addr lineAddr = MaxAddr;
+        bool valid = false;
+        SnoopItem item;
+    };
+
     /**
      * Simple factory methods for standard return values.
      */
@@ -258,14 +313,54 @@ class SnoopFilter : public SimObject
 
   private:
 
+    /** Is the tracking storage finite and set-associative? */
+    bool isBounded() const { return numSets != 0; }
+
+    /** Get the line address, tagged with the security state, of a packet. */
+    Addr lineAddress(const Packet *cpkt) const;
+
+    /** Find the way of a bounded filter tracking a line, if any. */
+    SnoopEntry *findEntry(Addr line_addr);
+
+    /**
+     * Find the item tracking a line.
+     *
+     * @return The item, or nullptr if the line is not tracked.
+     */
+    SnoopItem *findItem(Addr line_addr);
+
+    /**
+     * Start tracking a line that misses in the filter. In a bounded
+     * filter, this may replace another entry of the set, whose line is
+     * then queued for recall.
+     *
+     * @param replace Whether an entry may be replaced. If not, the line
+     *        overflows a full set as when all its entries are busy.
+     */
+    SnoopItem *allocateItem(Addr line_addr, bool replace=true);
+
     /**
      * Removes snoop filter items which have no requestors and no holders.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void eraseIfNullEntry(Addr line_addr, SnoopItem &sf_item);
 
-    /** Simple hash set of cached addresses. */
+    /**
+     * Hash map of cached addresses. This is all the storage of an
+     * unbounded filter. A bounded filter only puts lines here when all
+     * ways of their set have requests in flight, which must not be
+     * replaced before their responses are seen.
+     */
     SnoopFilterCache cachedLocations;
 
+    /** Ways of a bounded filter, numSets x assoc of them. */
+    std::vector<SnoopEntry> entries;
+
+    /** Replacement policy of a bounded filter. */
+    replacement_policy::Base *replacementPolicy;
+
+    /** Lines replaced by the last request lookup, waiting for a recall. */
+    std::vector<Recall> pendingRecalls;
+
     /**
      * A request lookup must be followed by a call to finishRequest to inform
      * the operation's success. If a retry is needed, however, all changes
@@ -274,27 +369,18 @@ class SnoopFilter : public SimObject
      */
     struct ReqLookupResult
     {
-        /** Iterator used to store the result from lookupRequest. */
-        SnoopFilterCache::iterator it;
+        /** Line address looked up by lookupRequest. */
+        Addr lineAddr = 0;
+
+        /** Item found or allocated by lookupRequest, if any. */
+        SnoopItem *item = nullptr;
 
         /**
          * Variable to temporarily store value of snoopfilter entry
          * in case finishRequest needs to undo changes made in lookupRequest
          * (because of crossbar retry)
          */
-        SnoopItem retryItem;
-
-        /**
-         * The constructor must be informed of the internal cache's end
-         * iterator, so do not allow the compiler to implictly define it.
-         *
-         * @param end_it Iterator to the end of the internal cache.
-         */
-        ReqLookupResult(SnoopFilterCache::iterator end_it)
-            : it(end_it), retryItem{0, 0}
-        {
-        }
-        ReqLookupResult() = delete;
+        SnoopItem retryItem{0, 0};
     } reqLookupResult;
 
     /** List of all attached snooping CPU-side ports. */
@@ -307,6 +393,12 @@ class SnoopFilter : public SimObject
     const Cycles lookupLatency;
     /** Max capacity in terms of cache blocks tracked, for sanity checking */
     const unsigned maxEntryCount;
+    /** Number of sets of a bounded filter, 0 if unbounded */
+    const unsigned numSets;
+    /** Associativity of a bounded filter */
+    const unsigned assoc;
+    /** Requestor id of the back-invalidation snoops */
+    const RequestorID _requestorId;
 
     /**
      * Use the lower bits of the address to keep track of the line status
@@ -329,6 +421,10 @@ class SnoopFilter : public SimObject
         statistics::Scalar totSnoops;
         statistics::Scalar hitSingleSnoops;
         statistics::Scalar hitMultiSnoops;
+
+        statistics::Scalar replacements;
+        statistics::Scalar recalledLines;
+        statistics::Scalar overflows;
     } stats;
 };
 
@@ -70,6 +70,17 @@ ThreadBridge::IncomingPort::recvAtomic(PacketPtr pkt)
     return device_.out_port_.sendAtomic(pkt);
 }
 
+Tick
+ThreadBridge::IncomingPort::recvAtomicBackdoor(PacketPtr pkt,
+                                               MemBackdoorPtr &backdoor)
+{
+    // A backdoor handed out here is used by the requestor from its own
+    // thread, without migrating. The requestor is responsible for making
+    // such accesses safe.
+    EventQueue::ScopedMigration migrate(device_.eventQueue());
+    return device_.out_port_.sendAtomicBackdoor(pkt, backdoor);
+}
+
 // FunctionalResponseProtocol
 void
 ThreadBridge::IncomingPort::recvFunctional(PacketPtr pkt)
@@ -78,6 +89,14 @@ ThreadBridge::IncomingPort::recvFunctional(PacketPtr pkt)
     device_.out_port_.sendFunctional(pkt);
 }
 
+void
+ThreadBridge::IncomingPort::recvMemBackdoorReq(const MemBackdoorReq &req,
+                                               MemBackdoorPtr &backdoor)
+{
+    EventQueue::ScopedMigration migrate(device_.eventQueue());
+    device_.out_port_.sendMemBackdoorReq(req, backdoor);
+}
+
 ThreadBridge::OutgoingPort::OutgoingPort(const std::string &name,
                                          ThreadBridge &device)
     : RequestPort(name), device_(device)
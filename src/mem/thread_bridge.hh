@@ -56,9 +56,13 @@ class ThreadBridge : public SimObject
 
         // AtomicResponseProtocol
         Tick recvAtomic(PacketPtr pkt) override;
+        Tick recvAtomicBackdoor(PacketPtr pkt,
+                                MemBackdoorPtr &backdoor) override;
 
         // FunctionalResponseProtocol
         void recvFunctional(PacketPtr pkt) override;
+        void recvMemBackdoorReq(const MemBackdoorReq &req,
+                                MemBackdoorPtr &backdoor) override;
 
       private:
         ThreadBridge &device_;
@@ -63,6 +63,16 @@ bool
 TranslatingPortProxy::tryOnBlob(BaseMMU::Mode mode, TranslationGenPtr gen,
         std::function<void(const TranslationGen::Range &)> func) const
 {
+    // Pages which are next to each other in both the virtual and physical
+    // address spaces are handed to func() as a single range, so that they
+    // can be copied in one go when there is a backdoor to memory.
+    TranslationGen::Range pending{0, 0, 0, NoFault};
+    auto flush = [&pending, &func]() {
+        if (pending.size)
+            func(pending);
+        pending.size = 0;
+    };
+
     // Wether we're trying to get past a fault.
     bool faulting = false;
     for (const auto &range: *gen) {
@@ -70,8 +80,10 @@ TranslatingPortProxy::tryOnBlob(BaseMMU::Mode mode, TranslationGenPtr gen,
         if (range.fault) {
             // If there was a fault last time too, or the fixup this time
             // fails, then the operation has failed.
-            if (faulting || !fixupRange(range, mode))
+            if (faulting || !fixupRange(range, mode)) {
+                flush();
                 return false;
+            }
             // This must be the first time we've tried this translation, so
             // record that we're making a second attempt and continue.
             faulting = true;
@@ -80,8 +92,14 @@ TranslatingPortProxy::tryOnBlob(BaseMMU::Mode mode, TranslationGenPtr gen,
 
         // Run func() on this successful translation.
         faulting = false;
-        func(range);
+        if (pending.size && pending.paddr + pending.size == range.paddr) {
+            pending.size += range.size;
+        } else {
+            flush();
+            pending = range;
+        }
     }
+    flush();
     return true;
 }
 
@@ -739,6 +739,7 @@ class SimObject(metaclass=MetaSimObject):
         self._name = None
         self._ccObject = None  # pointer to C++ object
         self._ccParams = None
+        self._path = None  # set once the hierarchy is final
         self._instantiated = False  # really "cloned"
         self._init_called = True  # Checked so subclasses don't forget __init__
 
@@ -998,6 +999,8 @@ class SimObject(metaclass=MetaSimObject):
                 self.add_child(key, val)
 
     def path(self):
+        if self._path is not None:
+            return self._path
         if not self._parent:
             return f"<orphan {self.__class__}>"
         elif isinstance(self._parent, MetaSimObject):
@@ -1110,37 +1113,40 @@ class SimObject(metaclass=MetaSimObject):
                 port.unproxy(self)
 
     def print_ini(self, ini_file):
-        print("[" + self.path() + "]", file=ini_file)  # .ini section header
+        ini_file.write(self.ini_section())
 
-        instanceDict[self.path()] = self
+    # Render the .ini section of this object as a single string, so that
+    # large configurations aren't written out a line at a time.
+    def ini_section(self):
+        path = self.path()
+        lines = ["[" + path + "]"]  # .ini section header
+
+        instanceDict[path] = self
 
         if hasattr(self, "type"):
-            print(f"type={self.type}", file=ini_file)
+            lines.append(f"type={self.type}")
 
         if len(self._children.keys()):
-            print(
+            lines.append(
                 "children=%s"
                 % " ".join(
                     self._children[n].get_name()
                     for n in sorted(self._children.keys())
-                ),
-                file=ini_file,
+                )
             )
 
         for param in sorted(self._params.keys()):
             value = self._values.get(param)
             if value != None:
-                print(
-                    f"{param}={self._values[param].ini_str()}",
-                    file=ini_file,
-                )
+                lines.append(f"{param}={value.ini_str()}")
 
         for port_name in sorted(self._ports.keys()):
             port = self._port_refs.get(port_name, None)
             if port != None:
-                print(f"{port_name}={port.ini_str()}", file=ini_file)
+                lines.append(f"{port_name}={port.ini_str()}")
 
-        print(file=ini_file)  # blank line between objects
+        lines.append("\n")  # blank line between objects
+        return "\n".join(lines)
 
     # generate a tree of dictionaries expressing all the parameters in the
     # instantiated system for use by scripts that want to do power, thermal
@@ -1251,6 +1257,12 @@ class SimObject(metaclass=MetaSimObject):
             )
         return self._ccObject
 
+    # Remember the path of this object, which is looked up many times
+    # while instantiating. Only valid once the hierarchy can't change.
+    def freezePath(self):
+        self._path = None
+        self._path = self.path()
+
     def descendants(self):
         yield self
         # The order of the dict is implementation dependent, so sort
@@ -261,6 +261,21 @@ def parse_options():
         help="Create DOT & pdf outputs of the DVFS configuration"
         + " [Default: %default]",
     )
+    option(
+        "--instantiation-cache",
+        metavar="DIR",
+        default=None,
+        help="Cache state derived from the configuration, such as Ruby "
+        "routing tables, in DIR so that later runs of the same "
+        "configuration can skip computing it [Default: %default]",
+    )
+    option(
+        "--startup-report",
+        metavar="FILE",
+        default=None,
+        help="Write the host time spent in each phase of startup to FILE "
+        "[Default: %default]",
+    )
 
     # Debugging options
     group("Debugging Options")
@@ -301,6 +316,15 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-ring",
+        metavar="N",
+        type="int",
+        default=0,
+        help="Record the last N debug messages unformatted in an in-memory "
+        "ring, written in binary to --debug-file on exit or crash. Decode "
+        "it with util/decode_binary_trace.py [Default: off]",
+    )
     option(
         "--debug-activate",
         metavar="EXPR[,EXPR]",
@@ -371,7 +395,8 @@ def _check_tracing():
 
     from .util import fatal
 
-    if _m5.core.TRACING_ON:
+    # gem5.fast may still trace the flags it was built to keep
+    if _m5.core.TRACING_ON or _m5.core.TRACING_KEPT_FLAGS:
         return
 
     fatal("Tracing is not enabled.  Compile with TRACING_ON")
@@ -392,6 +417,7 @@ def main():
         stats,
         trace,
     )
+    from .simulate import startupPhase
     from .util import (
         inform,
         isInteractive,
@@ -610,7 +636,13 @@ def main():
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_ring:
+        debug_file = options.debug_file
+        if debug_file in ("cout", "cerr"):
+            debug_file = "trace.bin"
+        trace.outputBinary(debug_file, options.debug_ring)
+    else:
+        trace.output(options.debug_file)
 
     for activate in options.debug_activate:
         _check_tracing()
@@ -622,6 +654,8 @@ def main():
 
     sys.argv = arguments
 
+    startupPhase("gem5 initialization")
+
     if options.m:
         sys.argv = [options.m[0]] + options.m[1]
         runpy.run_module(options.m[0], run_name="__m5_main__")
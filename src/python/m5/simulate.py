@@ -40,6 +40,7 @@
 import atexit
 import os
 import sys
+import time
 
 from m5.util.dot_writer import (
     do_dot,
@@ -74,6 +75,28 @@ _drain_manager = _m5.drain.DrainManager.instance()
 
 _instantiated = False  # Has m5.instantiate() been called?
 
+# Host time at which each phase of startup ended, reported by
+# --startup-report. The first phase starts when this module is imported.
+_startup_begin = time.perf_counter()
+_startup_phases = []
+
+
+def startupPhase(name):
+    """Record the end of the startup phase called name"""
+    _startup_phases.append((name, time.perf_counter()))
+
+
+def _write_startup_report(path):
+    total = _startup_phases[-1][1] - _startup_begin
+    with open(path, "w") as f:
+        f.write(f"{'phase':<32}{'seconds':>10}{'%':>8}\n")
+        start = _startup_begin
+        for name, end in _startup_phases:
+            share = 100 * (end - start) / total if total else 0
+            f.write(f"{name:<32}{end - start:>10.3f}{share:>8.1f}\n")
+            start = end
+        f.write(f"{'total':<32}{total:>10.3f}{100:>8.1f}\n")
+
 
 # The final call to instantiate the SimObject graph and initialize the
 # system.
@@ -84,6 +107,8 @@ def instantiate(ckpt_dir=None):
     if _instantiated:
         fatal("m5.instantiate() called twice.")
 
+    startupPhase("configuration script")
+
     _instantiated = True
 
     root = objects.Root.getInstance()
@@ -99,27 +124,48 @@ def instantiate(ckpt_dir=None):
     for obj in root.descendants():
         obj.adoptOrphanParams()
 
+    # Let the objects which can cache derived state know where to.
+    if options.instantiation_cache:
+        cache_dir = os.path.abspath(options.instantiation_cache)
+        os.makedirs(cache_dir, exist_ok=True)
+        for obj in root.descendants():
+            if "instantiation_cache" not in obj._params:
+                continue
+            if not obj.instantiation_cache:
+                obj.instantiation_cache = cache_dir
+
     # Unproxy in sorted order for determinism
     for obj in root.descendants():
         obj.unproxyParams()
 
+    # The hierarchy is final from here on, so walk it only once and
+    # remember the path of every object.
+    all_objs = list(root.descendants())
+    for obj in all_objs:
+        obj.freezePath()
+    startupPhase("resolving parameters")
+
     if options.dump_config:
-        ini_file = open(os.path.join(options.outdir, options.dump_config), "w")
         # Print ini sections in sorted order for easier diffing
-        for obj in sorted(root.descendants(), key=lambda o: o.path()):
-            obj.print_ini(ini_file)
-        ini_file.close()
+        with open(os.path.join(options.outdir, options.dump_config), "w") as f:
+            f.write(
+                "".join(
+                    obj.ini_section()
+                    for obj in sorted(all_objs, key=lambda o: o.path())
+                )
+            )
 
     if options.json_config:
         try:
             import json
 
-            json_file = open(
-                os.path.join(options.outdir, options.json_config), "w"
-            )
+            # json.dump() writes every token separately, so encode the
+            # whole configuration first.
             d = root.get_config_as_dict()
-            json.dump(d, json_file, indent=4)
-            json_file.close()
+            with open(
+                os.path.join(options.outdir, options.json_config), "w"
+            ) as f:
+                f.write(json.dumps(d, indent=4))
         except ImportError:
             pass
 
@@ -127,30 +173,37 @@ def instantiate(ckpt_dir=None):
         do_dot(root, options.outdir, options.dot_config)
         do_ruby_dot(root, options.outdir, options.dot_config)
 
+    startupPhase("writing configuration")
+
     # Initialize the global statistics
     stats.initSimStats()
 
     # Create the C++ sim objects and connect ports
-    for obj in root.descendants():
+    for obj in all_objs:
         obj.createCCObject()
-    for obj in root.descendants():
+    startupPhase("creating C++ objects")
+    for obj in all_objs:
         obj.connectPorts()
+    startupPhase("connecting ports")
 
     # Do a second pass to finish initializing the sim objects
-    for obj in root.descendants():
+    for obj in all_objs:
         obj.init()
+    startupPhase("init()")
 
     # Do a third pass to initialize statistics
     stats._bindStatHierarchy(root)
     root.regStats()
+    startupPhase("registering stats")
 
     # Do a fourth pass to initialize probe points
-    for obj in root.descendants():
+    for obj in all_objs:
         obj.regProbePoints()
 
     # Do a fifth pass to connect probe listeners
-    for obj in root.descendants():
+    for obj in all_objs:
         obj.regProbeListeners()
+    startupPhase("registering probes")
 
     # We want to generate the DVFS diagram for the system. This can only be
     # done once all of the CPP objects have been created and initialised so
@@ -165,11 +218,13 @@ def instantiate(ckpt_dir=None):
     if ckpt_dir:
         _drain_manager.preCheckpointRestore()
         ckpt = _m5.core.getCheckpoint(ckpt_dir)
-        for obj in root.descendants():
+        for obj in all_objs:
             obj.loadState(ckpt)
+        startupPhase("restoring checkpoint")
     else:
-        for obj in root.descendants():
+        for obj in all_objs:
             obj.initState()
+        startupPhase("initState()")
 
     # Check to see if any of the stat events are in the past after resuming from
     # a checkpoint, If so, this call will shift them to be at a valid time.
@@ -177,6 +232,11 @@ def instantiate(ckpt_dir=None):
 
     gather_citations(root)
 
+    if options.startup_report:
+        _write_startup_report(
+            os.path.join(options.outdir, options.startup_report)
+        )
+
 
 need_startup = True
 
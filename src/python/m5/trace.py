@@ -29,6 +29,8 @@ from _m5.trace import (
     activate,
     disable,
     enable,
+    flush,
     ignore,
     output,
+    outputBinary,
 )
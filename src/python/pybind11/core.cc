@@ -46,6 +46,7 @@
 #include <ctime>
 
 #include "base/addr_range.hh"
+#include "base/debug.hh"
 #include "base/inet.hh"
 #include "base/loader/elf_object.hh"
 #include "base/logging.hh"
@@ -326,6 +327,7 @@ pybind_init_core(py::module_ &m_native)
     m_core.attr("gem5Version") = py::cast(gem5Version);
 
     m_core.attr("TRACING_ON") = py::cast(TRACING_ON);
+    m_core.attr("TRACING_KEPT_FLAGS") = py::cast(TRACING_KEPT_FLAGS);
 
     m_core.attr("MaxTick") = py::cast(MaxTick);
 
@@ -42,13 +42,21 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
 #include <map>
+#include <string>
 #include <vector>
 
 #include "base/compiler.hh"
 #include "base/debug.hh"
+#include "base/logging.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -67,6 +75,33 @@ output(const char *filename)
     trace::setDebugLogger(new trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+outputBinary(const char *filename, size_t entries)
+{
+    // The ring is written with write(2), possibly from a fatal signal
+    // handler, so it needs a file descriptor rather than a stream.
+    const std::string name(filename);
+    int fd;
+    if (name == "cout" || name == "stdout") {
+        fd = dup(STDOUT_FILENO);
+    } else if (name == "cerr" || name == "stderr") {
+        fd = dup(STDERR_FILENO);
+    } else {
+        fd = open(simout.resolve(name).c_str(),
+                  O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    }
+    fatal_if(fd < 0, "Cannot open debug ring file %s: %s\n", name,
+             strerror(errno));
+
+    auto *logger = new trace::BinaryLogger(fd, entries);
+    trace::setDebugLogger(logger);
+    registerExitCallback([logger]() {
+        // Record any partial line before writing the ring out
+        logger->getOstream().flush();
+        logger->flush();
+    });
+}
+
 static void
 activate(const char *expr)
 {
@@ -129,6 +164,8 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("outputBinary", &outputBinary)
+        .def("flush", []() { trace::getDebugLogger()->flush(); })
         .def("activate", &activate)
         .def("ignore", &ignore)
         .def("enable", &trace::enable)
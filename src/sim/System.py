@@ -79,6 +79,33 @@ class System(SimObject):
         False, "mmap the backing store without reserving swap"
     )
 
+    # A sparse backing store is mapped without reserving swap, and only
+    # the host pages the simulation touches are committed, checkpointed
+    # and accounted for in the stats. This allows simulating a large
+    # memory of which only a small part is used, on a modest host.
+    sparse_backstore = Param.Bool(
+        False, "Only commit and checkpoint the touched backing store pages"
+    )
+    # Huge pages save host page table memory and TLB misses, but in a
+    # sparse backing store they are only used where the touched pages
+    # are dense enough not to waste host memory.
+    backstore_huge_pages = Param.Bool(
+        False, "Back the backing store with transparent huge pages"
+    )
+    backstore_huge_page_density = Param.Percent(
+        50,
+        "Percentage of touched pages above which a huge page of a sparse "
+        "backing store is considered dense",
+    )
+    # Finding the touched pages means reading the host page tables, so
+    # the touched memory stat is only updated at checkpoints, and at the
+    # stats dumps that are far enough apart
+    touched_memory_interval = Param.Latency(
+        "1ms",
+        "Minimum time between two updates of the touched memory of a "
+        "sparse backing store at stats dumps",
+    )
+
     # The memory ranges are to be populated when creating the system
     # such that these can be passed from the I/O subsystem through an
     # I/O bridge or cache
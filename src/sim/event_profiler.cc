@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_profiler.hh"
+
+#include <algorithm>
+
+#include "base/cprintf.hh"
+#include "base/output.hh"
+#include "sim/core.hh"
+#include "sim/root.hh"
+
+namespace gem5
+{
+
+EventProfiler::EventProfiler(const Params &p)
+    : SimObject(p), samplePeriod(p.sample_period), outputName(p.output),
+      stats(this)
+{
+    fatal_if(samplePeriod == 0, "%s: sample_period must be at least 1.",
+             name());
+
+    registerExitCallback([this]() { dump(); });
+}
+
+void
+EventProfiler::init()
+{
+    SimObject::init();
+
+    // All the event queues exist once every object has been constructed.
+    // Reserve first so that the queues' pointers stay valid.
+    profiles.reserve(numMainEventQueues);
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        profiles.emplace_back(samplePeriod);
+        getEventQueue(i)->setProfile(&profiles.back());
+    }
+}
+
+void
+EventProfiler::collectObjects(const statistics::Group *group)
+{
+    if (auto *obj = dynamic_cast<const SimObject *>(group)) {
+        objectIndex[obj->name()] = objectNames.size();
+        objectNames.push_back(obj->name());
+    }
+
+    for (const auto &[name, child] : group->getStatGroups())
+        collectObjects(child);
+}
+
+void
+EventProfiler::regStats()
+{
+    SimObject::regStats();
+
+    if (Root::root())
+        collectObjects(Root::root());
+
+    stats.objectCycles.init(objectNames.size() + 1);
+    for (size_t i = 0; i < objectNames.size(); ++i)
+        stats.objectCycles.subname(i, objectNames[i]);
+    stats.objectCycles.subname(objectNames.size(), "unattributed");
+}
+
+size_t
+EventProfiler::attribute(const std::string &event_name) const
+{
+    // Events are named after their owner, possibly with extra components
+    // such as ".wrapped_function_event", so strip components until a
+    // SimObject matches.
+    std::string name = event_name;
+    while (true) {
+        auto it = objectIndex.find(name);
+        if (it != objectIndex.end())
+            return it->second;
+
+        auto dot = name.rfind('.');
+        if (dot == std::string::npos)
+            return objectNames.size();
+        name.resize(dot);
+    }
+}
+
+void
+EventProfiler::preDumpStats()
+{
+    SimObject::preDumpStats();
+
+    std::vector<uint64_t> cycles(objectNames.size() + 1, 0);
+    uint64_t samples = 0;
+    uint64_t total = 0;
+    for (const auto &profile : profiles) {
+        for (const auto &[key, entry] : profile.getEntries()) {
+            cycles[attribute(entry.name)] += entry.cycles;
+            samples += entry.samples;
+            total += entry.cycles;
+        }
+    }
+
+    stats.sampledEvents = samples;
+    stats.sampledCycles = total;
+    for (size_t i = 0; i < cycles.size(); ++i)
+        stats.objectCycles[i] = cycles[i];
+}
+
+void
+EventProfiler::resetStats()
+{
+    SimObject::resetStats();
+
+    for (auto &profile : profiles)
+        profile.reset();
+}
+
+void
+EventProfiler::dump()
+{
+    // Merge the queues, which may have serviced events of the same name.
+    EventQueueProfile::EntryMap merged;
+    uint64_t total = 0;
+    for (const auto &profile : profiles) {
+        for (const auto &[key, entry] : profile.getEntries()) {
+            auto &m = merged[key];
+            m.name = entry.name;
+            m.description = entry.description;
+            m.cycles += entry.cycles;
+            m.samples += entry.samples;
+            total += entry.cycles;
+        }
+    }
+
+    std::vector<const EventQueueProfile::Entry *> sorted;
+    std::map<std::string, std::pair<uint64_t, uint64_t>> by_class;
+    for (const auto &[key, entry] : merged) {
+        sorted.push_back(&entry);
+        auto &c = by_class[entry.description];
+        c.first += entry.cycles;
+        c.second += entry.samples;
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](auto *a, auto *b) { return a->cycles > b->cycles; });
+
+    const double scale = total ? 100.0 / total : 0.0;
+
+    OutputStream *report = simout.create(outputName + ".txt");
+    std::ostream &os = *report->stream();
+    ccprintf(os, "# One in %d events timed, %d host cycles sampled\n",
+             samplePeriod, total);
+    ccprintf(os, "\n# By event class\n");
+    ccprintf(os, "%7s %16s %12s  %s\n", "%", "cycles", "samples", "class");
+    for (const auto &[desc, c] : by_class) {
+        ccprintf(os, "%7.3f %16d %12d  %s\n", c.first * scale, c.first,
+                 c.second, desc);
+    }
+    ccprintf(os, "\n# By event\n");
+    ccprintf(os, "%7s %16s %12s %10s  %s\n", "%", "cycles", "samples",
+             "cyc/sample", "event (class)");
+    for (const auto *entry : sorted) {
+        ccprintf(os, "%7.3f %16d %12d %10d  %s (%s)\n",
+                 entry->cycles * scale, entry->cycles, entry->samples,
+                 entry->samples ? entry->cycles / entry->samples : 0,
+                 entry->name, entry->description);
+    }
+    simout.close(report);
+
+    // One line per event with its owner's path as the stack, in the
+    // folded format consumed by flamegraph.pl.
+    OutputStream *folded = simout.create(outputName + ".folded");
+    for (const auto *entry : sorted) {
+        std::string stack = entry->name;
+        std::replace(stack.begin(), stack.end(), '.', ';');
+        std::string desc = entry->description;
+        std::replace(desc.begin(), desc.end(), ' ', '_');
+        ccprintf(*folded->stream(), "%s;%s %d\n", stack, desc,
+                 entry->cycles);
+    }
+    simout.close(folded);
+}
+
+EventProfiler::EventProfilerStats::EventProfilerStats(
+        statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(sampledEvents, statistics::units::Count::get(),
+               "Number of events timed on the host"),
+      // Host cycle counter ticks, which are not simulated cycles
+      ADD_STAT(sampledCycles, statistics::units::Count::get(),
+               "Host cycles spent in the timed events"),
+      ADD_STAT(objectCycles, statistics::units::Count::get(),
+               "Host cycles spent in the timed events of each SimObject")
+{
+    objectCycles.flags(statistics::nozero);
+}
+
+} // namespace gem5
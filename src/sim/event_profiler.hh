@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_EVENT_PROFILER_HH__
+#define __SIM_EVENT_PROFILER_HH__
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "params/EventProfiler.hh"
+#include "sim/eventq_profile.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * Attributes host time to the SimObjects whose events consume it. When
+ * added to a configuration, the profiler hooks into every main event
+ * queue at init and exports the sampled host cycles per SimObject as
+ * stats. At exit, it writes a per event report and a folded stack file
+ * which can be rendered with flamegraph.pl.
+ */
+class EventProfiler : public SimObject
+{
+  protected:
+    std::vector<EventQueueProfile> profiles;
+
+    const uint64_t samplePeriod;
+    const std::string outputName;
+
+    /** Names of the SimObjects events are attributed to, by stat index. */
+    std::vector<std::string> objectNames;
+    std::unordered_map<std::string, size_t> objectIndex;
+
+    /** Find the stat index of the innermost SimObject owning an event. */
+    size_t attribute(const std::string &event_name) const;
+
+    void collectObjects(const statistics::Group *group);
+
+    void dump();
+
+    struct EventProfilerStats : public statistics::Group
+    {
+        EventProfilerStats(statistics::Group *parent);
+
+        statistics::Scalar sampledEvents;
+        statistics::Scalar sampledCycles;
+        statistics::Vector objectCycles;
+    } stats;
+
+  public:
+    PARAMS(EventProfiler);
+    EventProfiler(const Params &p);
+
+    void init() override;
+    void regStats() override;
+    void preDumpStats() override;
+    void resetStats() override;
+};
+
+} // namespace gem5
+
+#endif // __SIM_EVENT_PROFILER_HH__
@@ -41,6 +41,7 @@
 #include "base/trace.hh"
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
+#include "sim/eventq_profile.hh"
 
 namespace gem5
 {
@@ -246,7 +247,10 @@ EventQueue::serviceOne()
         setCurTick(event->when());
         if (debug::Event)
             event->trace("executed");
-        event->process();
+        if (GEM5_UNLIKELY(profile))
+            profile->process(event);
+        else
+            event->process();
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
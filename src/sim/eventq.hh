@@ -59,6 +59,7 @@ namespace gem5
 {
 
 class EventQueue;       // forward declaration
+class EventQueueProfile;
 class BaseGlobalEvent;
 
 //! Simulation Quantum for multiple eventq simulation.
@@ -627,6 +628,9 @@ class EventQueue
     //! List of events added by other threads to this event queue.
     std::list<Event*> async_queue;
 
+    //! Host time profile of the serviced events, if profiling.
+    EventQueueProfile *profile = nullptr;
+
     /**
      * Lock protecting event handling.
      *
@@ -836,6 +840,12 @@ class EventQueue
     Tick nextTick() const { return head->when(); }
     void setCurTick(Tick newVal) { _curTick = newVal; }
 
+    /**
+     * Time the serviced events on the host and record them in a profile,
+     * or stop doing so if the profile is nullptr.
+     */
+    void setProfile(EventQueueProfile *_profile) { profile = _profile; }
+
     /**
      * While curTick() is useful for any object assigned to this event queue,
      * if an object that is assigned to another event queue (or a non-event
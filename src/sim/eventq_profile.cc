@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/eventq_profile.hh"
+
+#include <typeinfo>
+
+namespace gem5
+{
+
+EventQueueProfile::Entry &
+EventQueueProfile::findEntry(const std::string &name, const char *desc)
+{
+    auto key = std::make_pair(name, std::string(desc));
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        it = entries.emplace(key, Entry()).first;
+        it->second.name = name;
+        it->second.description = desc;
+    }
+    return it->second;
+}
+
+void
+EventQueueProfile::record(const Event *event, uint64_t cycles)
+{
+    // Entries are looked up by name rather than by event address, since
+    // addresses are reused as events are deleted and created. The default
+    // name is unique to each event, so whether a class has names of its
+    // own is only checked on its first sample. The entries don't move
+    // once created, so the unnamed ones are then found from the class.
+    const char *desc = event->description();
+    auto [it, first] = classes.try_emplace(std::type_index(typeid(*event)));
+    EventClass &event_class = it->second;
+    if (first)
+        event_class.named = event->name() != event->Event::name();
+
+    Entry *entry;
+    if (event_class.named) {
+        entry = &findEntry(event->name(), desc);
+    } else {
+        if (event_class.description != desc) {
+            event_class.description = desc;
+            event_class.entry = &findEntry("unnamed", desc);
+        }
+        entry = event_class.entry;
+    }
+
+    entry->cycles += cycles;
+    entry->samples++;
+}
+
+void
+EventQueueProfile::reset()
+{
+    for (auto &[key, entry] : entries) {
+        entry.cycles = 0;
+        entry.samples = 0;
+    }
+}
+
+} // namespace gem5
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_EVENTQ_PROFILE_HH__
+#define __SIM_EVENTQ_PROFILE_HH__
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+/** Read a cheap, monotonic host cycle counter. */
+inline uint64_t
+hostCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t cycles;
+    asm volatile("mrs %0, cntvct_el0" : "=r" (cycles));
+    return cycles;
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+/**
+ * Host time spent in the events serviced by one event queue. Every
+ * samplePeriod-th event is timed with the host cycle counter, and its
+ * cost is accumulated under the event's name and description. Events
+ * which don't override Event::name() would each get a name of their own,
+ * so they are only told apart by their description. Only the thread
+ * servicing the queue touches its profile.
+ */
+class EventQueueProfile
+{
+  public:
+    struct Entry
+    {
+        std::string name;
+        std::string description;
+        uint64_t cycles = 0;
+        uint64_t samples = 0;
+    };
+
+    typedef std::map<std::pair<std::string, std::string>, Entry> EntryMap;
+
+  protected:
+    const uint64_t samplePeriod;
+    uint64_t countdown;
+
+    EntryMap entries;
+
+    /** What is known of the sampled events of a class. */
+    struct EventClass
+    {
+        /** Whether the class overrides Event::name(). */
+        bool named = false;
+        /** Entry of the last unnamed event sampled, and its description. */
+        const char *description = nullptr;
+        Entry *entry = nullptr;
+    };
+    std::unordered_map<std::type_index, EventClass> classes;
+
+    Entry &findEntry(const std::string &name, const char *desc);
+
+    void record(const Event *event, uint64_t cycles);
+
+  public:
+    EventQueueProfile(uint64_t sample_period)
+        : samplePeriod(sample_period), countdown(sample_period)
+    {}
+
+    /** Process an event, timing it if it is sampled. */
+    void
+    process(Event *event)
+    {
+        if (--countdown) {
+            event->process();
+            return;
+        }
+        countdown = samplePeriod;
+
+        const uint64_t start = hostCycles();
+        event->process();
+        record(event, hostCycles() - start);
+    }
+
+    const EntryMap &getEntries() const { return entries; }
+
+    void reset();
+};
+
+} // namespace gem5
+
+#endif // __SIM_EVENTQ_PROFILE_HH__
@@ -28,6 +28,9 @@
 
 #include <sim/futex_map.hh>
 
+#include "cpu/base.hh"
+#include "sim/eventq.hh"
+
 namespace gem5
 {
 
@@ -55,50 +58,69 @@ FutexMap::suspend(Addr addr, uint64_t tgid, ThreadContext *tc)
     suspend_bitset(addr, tgid, tc, 0xffffffff);
 }
 
+void
+FutexMap::activate(const std::vector<ThreadContext *> &tcs)
+{
+    for (auto *tc : tcs) {
+        // The CPU of tc may be simulated by another thread, on its own
+        // event queue.
+        EventQueue::ScopedMigration migrate(tc->getCpuPtr()->eventQueue());
+        tc->activate();
+    }
+}
+
 int
 FutexMap::wakeup(Addr addr, uint64_t tgid, int count)
 {
-    FutexKey key(addr, tgid);
-    auto it = find(key);
-
-    if (it == end())
-        return 0;
+    std::vector<ThreadContext *> woken;
+    {
+        std::lock_guard<std::mutex> lock(mapLock);
+
+        FutexKey key(addr, tgid);
+        auto it = find(key);
+
+        if (it == end())
+            return 0;
+
+        auto &waiterList = it->second;
+
+        while (!waiterList.empty() && (int)woken.size() < count) {
+            // Threads may be woken up by access to locked
+            // memory addresses outside of syscalls, so we
+            // must only count threads that were actually
+            // woken up by this syscall.
+            auto& tc = waiterList.front().tc;
+            woken.push_back(tc);
+            waitingTcs.erase(tc);
+            waiterList.pop_front();
+        }
 
-    int woken_up = 0;
-    auto &waiterList = it->second;
-
-    while (!waiterList.empty() && woken_up < count) {
-        // Threads may be woken up by access to locked
-        // memory addresses outside of syscalls, so we
-        // must only count threads that were actually
-        // woken up by this syscall.
-        auto& tc = waiterList.front().tc;
-        tc->activate();
-        woken_up++;
-        waiterList.pop_front();
-        waitingTcs.erase(tc);
+        if (waiterList.empty())
+            erase(it);
     }
 
-    if (waiterList.empty())
-        erase(it);
-
-    return woken_up;
+    activate(woken);
+    return woken.size();
 }
 
 void
 FutexMap::suspend_bitset(Addr addr, uint64_t tgid, ThreadContext *tc,
                int bitmask)
 {
-    FutexKey key(addr, tgid);
-    auto it = find(key);
+    {
+        std::lock_guard<std::mutex> lock(mapLock);
 
-    if (it == end()) {
-        WaiterList waiterList {WaiterState(tc, bitmask)};
-        insert({key, waiterList});
-    } else {
-        it->second.push_back(WaiterState(tc, bitmask));
+        FutexKey key(addr, tgid);
+        auto it = find(key);
+
+        if (it == end()) {
+            WaiterList waiterList {WaiterState(tc, bitmask)};
+            insert({key, waiterList});
+        } else {
+            it->second.push_back(WaiterState(tc, bitmask));
+        }
+        waitingTcs.emplace(tc);
     }
-    waitingTcs.emplace(tc);
 
     /** Suspend the thread context */
     tc->suspend();
@@ -107,39 +129,45 @@ FutexMap::suspend_bitset(Addr addr, uint64_t tgid, ThreadContext *tc,
 int
 FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask)
 {
-    FutexKey key(addr, tgid);
-    auto it = find(key);
+    std::vector<ThreadContext *> woken;
+    {
+        std::lock_guard<std::mutex> lock(mapLock);
 
-    if (it == end())
-        return 0;
+        FutexKey key(addr, tgid);
+        auto it = find(key);
 
-    int woken_up = 0;
+        if (it == end())
+            return 0;
 
-    auto &waiterList = it->second;
-    auto iter = waiterList.begin();
+        auto &waiterList = it->second;
+        auto iter = waiterList.begin();
 
-    while (iter != waiterList.end()) {
-        WaiterState& waiter = *iter;
+        while (iter != waiterList.end()) {
+            WaiterState& waiter = *iter;
 
-        if (waiter.checkMask(bitmask)) {
-            waiter.tc->activate();
-            waitingTcs.erase(waiter.tc);
-            iter = waiterList.erase(iter);
-            woken_up++;
-        } else {
-            ++iter;
+            if (waiter.checkMask(bitmask)) {
+                woken.push_back(waiter.tc);
+                waitingTcs.erase(waiter.tc);
+                iter = waiterList.erase(iter);
+            } else {
+                ++iter;
+            }
         }
-    }
 
-    if (waiterList.empty())
-        erase(it);
+        if (waiterList.empty())
+            erase(it);
+    }
 
-    return woken_up;
+    activate(woken);
+    return woken.size();
 }
 
 int
 FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
 {
+    std::vector<ThreadContext *> woken;
+    std::unique_lock<std::mutex> lock(mapLock);
+
     FutexKey key1(addr1, tgid);
     auto it1 = find(key1);
 
@@ -150,7 +178,8 @@ FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
     auto &waiterList1 = it1->second;
 
     while (!waiterList1.empty() && woken_up < count) {
-        waiterList1.front().tc->activate();
+        woken.push_back(waiterList1.front().tc);
+        waitingTcs.erase(waiterList1.front().tc);
         waiterList1.pop_front();
         woken_up++;
     }
@@ -178,12 +207,15 @@ FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
     if (waiterList1.empty())
         erase(it1);
 
+    lock.unlock();
+    activate(woken);
     return woken_up + requeued;
 }
 
 bool
 FutexMap::is_waiting(ThreadContext *tc)
 {
+    std::lock_guard<std::mutex> lock(mapLock);
     return waitingTcs.find(tc) != waitingTcs.end();
 }
 
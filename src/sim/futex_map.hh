@@ -29,8 +29,10 @@
 #ifndef __FUTEX_MAP_HH__
 #define __FUTEX_MAP_HH__
 
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <cpu/thread_context.hh>
 
@@ -104,7 +106,10 @@ class WaiterState
 typedef std::list<WaiterState> WaiterList;
 
 /**
- * FutexMap class holds a map of all futexes used in the system
+ * FutexMap class holds a map of all futexes used in the system. It is
+ * safe to use from several threads when CPUs are simulated in parallel.
+ * Waiters are suspended and woken after the map has been unlocked, since
+ * waking a thread context may need to lock the event queue of its CPU.
  */
 class FutexMap : public std::unordered_map<FutexKey, WaiterList>
 {
@@ -141,6 +146,11 @@ class FutexMap : public std::unordered_map<FutexKey, WaiterList>
   private:
 
     std::unordered_set<ThreadContext *> waitingTcs;
+
+    std::mutex mapLock;
+
+    /** Activate thread contexts woken up while the map was locked. */
+    static void activate(const std::vector<ThreadContext *> &tcs);
 };
 
 } // namespace gem5
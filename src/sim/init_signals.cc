@@ -56,6 +56,7 @@
 #include "base/atomicio.hh"
 #include "base/cprintf.hh"
 #include "base/logging.hh"
+#include "base/trace.hh"
 #include "sim/async.hh"
 #include "sim/backtrace.hh"
 #include "sim/eventq.hh"
@@ -157,6 +158,7 @@ abortHandler(int sigtype)
     }
 
     print_backtrace();
+    trace::getDebugLogger()->flush();
     raiseFatalSignal(sigtype);
 }
 
@@ -167,6 +169,7 @@ segvHandler(int sigtype)
     STATIC_ERR("gem5 has encountered a segmentation fault!\n\n");
 
     print_backtrace();
+    trace::getDebugLogger()->flush();
     raiseFatalSignal(SIGSEGV);
 }
 
@@ -31,10 +31,13 @@
 #include <cassert>
 
 #include "arch/generic/mmu.hh"
+#include "cpu/base.hh"
 #include "debug/Vma.hh"
 #include "mem/se_translating_port_proxy.hh"
+#include "sim/eventq.hh"
 #include "sim/process.hh"
 #include "sim/syscall_debug_macros.hh"
+#include "sim/syscall_desc.hh"
 #include "sim/system.hh"
 #include "sim/vma.hh"
 
@@ -94,7 +97,7 @@ MemState::isUnmapped(Addr start_addr, Addr length)
      */
     for (auto start = start_addr; start < end_addr;
          start += _pageBytes) {
-        if (_ownerProcess->pTable->lookup(start) != nullptr) {
+        if (_ownerProcess->pTable->lookup(start).has_value()) {
             panic("Someone allocated physical memory at VA %p without "
                   "creating a VMA!\n", start);
             return false;
@@ -266,6 +269,7 @@ MemState::unmapRegion(Addr start_addr, Addr length)
      * that can flush just part of the address space.
      */
     for (auto *tc: _ownerProcess->system->threads) {
+        EventQueue::ScopedMigration migrate(tc->getCpuPtr()->eventQueue());
         tc->getMMUPtr()->flushAll();
     }
 
@@ -367,6 +371,7 @@ MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
      * that can flush just part of the address space.
      */
     for (auto *tc: _ownerProcess->system->threads) {
+        EventQueue::ScopedMigration migrate(tc->getCpuPtr()->eventQueue());
         tc->getMMUPtr()->flushAll();
     }
 
@@ -388,9 +393,50 @@ MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
     } while (length > 0);
 }
 
+void
+MemState::fillFilePages(const VMA &vma, Addr vaddr, Addr size)
+{
+    /**
+     * The physical pages were allocated in one go, so they are contiguous
+     * and can share a single host mapping of the file. A sparse backing
+     * store only checkpoints the pages the host has committed, which the
+     * file pages that are never read are not, so they are copied instead.
+     */
+    auto &physmem = _ownerProcess->system->getPhysMem();
+    Addr paddr;
+    if (!physmem.sparse() && _ownerProcess->pTable->translate(vaddr, paddr)) {
+        const auto backing_store = physmem.getBackingStore();
+        for (const auto &entry : backing_store) {
+            if (entry.shmFd != -1 || entry.range.interleaved() ||
+                    !entry.range.contains(paddr) ||
+                    !entry.range.contains(paddr + size - 1)) {
+                continue;
+            }
+            uint8_t *host_mem = entry.pmem + (paddr - entry.range.start());
+            if (vma.mapMemPages(vaddr, size, host_mem))
+                return;
+            break;
+        }
+    }
+
+    /**
+     * Otherwise copy the file contents in through the first thread of the
+     * process. All of its threads share the same page table.
+     */
+    auto *tc = _ownerProcess->system->threads[_ownerProcess->contextIds[0]];
+    EventQueue::ScopedMigration migrate(tc->getCpuPtr()->eventQueue());
+    SETranslatingPortProxy virt_mem(tc, SETranslatingPortProxy::Always);
+    for (Addr page = vaddr; page < vaddr + size; page += _pageBytes)
+        vma.fillMemPages(page, _pageBytes, virt_mem);
+}
+
 bool
 MemState::fixupFault(Addr vaddr)
 {
+    // Faults are taken outside of syscalls too, but allocate memory just
+    // like them.
+    auto lock = SyscallDesc::lock();
+
     /**
      * Check if we are accessing a mapped virtual address. If so then we
      * just haven't allocated it a physical page yet and can do so here.
@@ -398,7 +444,6 @@ MemState::fixupFault(Addr vaddr)
     for (const auto &vma : _vmaList) {
         if (vma.contains(vaddr)) {
             Addr vpage_start = roundDown(vaddr, _pageBytes);
-            _ownerProcess->allocateMem(vpage_start, _pageBytes);
 
             /**
              * We are assuming that fresh pages are zero-filled, so there is
@@ -406,18 +451,23 @@ MemState::fixupFault(Addr vaddr)
              * This assumption will not hold true if/when physical pages
              * are recycled.
              */
-            if (vma.hasHostBuf()) {
-                /**
-                 * Write the memory for the host buffer contents for all
-                 * ThreadContexts associated with this process.
-                 */
-                for (auto &cid : _ownerProcess->contextIds) {
-                    auto *tc = _ownerProcess->system->threads[cid];
-                    SETranslatingPortProxy
-                        virt_mem(tc, SETranslatingPortProxy::Always);
-                    vma.fillMemPages(vpage_start, _pageBytes, virt_mem);
-                }
+            if (!vma.hasHostBuf()) {
+                _ownerProcess->allocateMem(vpage_start, _pageBytes);
+                return true;
+            }
+
+            // Another thread may have brought the page in already.
+            if (_ownerProcess->pTable->lookup(vpage_start))
+                return true;
+
+            Addr size = _pageBytes;
+            while (size < FileFaultAroundBytes &&
+                   vma.contains(vpage_start + size) &&
+                   !_ownerProcess->pTable->lookup(vpage_start + size)) {
+                size += _pageBytes;
             }
+            _ownerProcess->allocateMem(vpage_start, size);
+            fillFilePages(vma, vpage_start, size);
             return true;
         }
     }
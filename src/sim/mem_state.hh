@@ -263,6 +263,20 @@ class MemState : public Serializable
      */
     System * system() const;
 
+    /**
+     * Fill freshly allocated pages of a file-backed VMA with the file
+     * contents, mapping the file directly into the host memory of the
+     * physical pages where possible.
+     */
+    void fillFilePages(const VMA &vma, Addr vaddr, Addr size);
+
+    /**
+     * Number of bytes of a file mapping brought in by a single fault.
+     * Files are mostly read sequentially, so faulting around the accessed
+     * page saves most of the faults.
+     */
+    static constexpr Addr FileFaultAroundBytes = 64 * 1024;
+
     /**
      * Owner process of MemState. Used to manipulate page tables.
      */
@@ -328,7 +328,7 @@ Process::allocateMem(Addr vaddr, int64_t size, bool clobber)
     // a physical page frame to map with the virtual page. Other cores can
     // return if the page has been mapped and `!clobber`.
     if (!clobber) {
-        const EmulationPageTable::Entry *pte = pTable->lookup(page_addr);
+        auto pte = pTable->lookup(page_addr);
         if (pte) {
             warn("Process::allocateMem: addr %#x already mapped\n", vaddr);
             return;
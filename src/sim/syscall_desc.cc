@@ -29,6 +29,8 @@
 
 #include "sim/syscall_desc.hh"
 
+#include <mutex>
+
 #include "base/types.hh"
 #include "sim/eventq.hh"
 #include "sim/syscall_debug_macros.hh"
@@ -38,9 +40,32 @@ namespace gem5
 
 class ThreadContext;
 
+namespace
+{
+
+// Recursive, since page faults taken while copying syscall arguments also
+// lock it.
+std::recursive_mutex syscallMutex;
+
+} // anonymous namespace
+
+std::unique_lock<std::recursive_mutex>
+SyscallDesc::lock()
+{
+    if (!inParallelMode)
+        return std::unique_lock<std::recursive_mutex>();
+
+    // Release the event queue while waiting, so that the thread emulating
+    // a syscall can migrate to it to wake up or halt a thread context.
+    EventQueue::ScopedRelease release(curEventQueue());
+    return std::unique_lock<std::recursive_mutex>(syscallMutex);
+}
+
 void
 SyscallDesc::doSyscall(ThreadContext *tc)
 {
+    auto lock = SyscallDesc::lock();
+
     DPRINTF_SYSCALL(Base, "Calling %s...\n", dumper(name(), tc));
 
     SyscallReturn retval = executor(this, tc);
@@ -60,6 +85,8 @@ SyscallDesc::doSyscall(ThreadContext *tc)
 void
 SyscallDesc::retrySyscall(ThreadContext *tc)
 {
+    auto lock = SyscallDesc::lock();
+
     DPRINTF_SYSCALL(Base, "Retrying %s...\n", dumper(name(), tc));
 
     SyscallReturn retval = executor(this, tc);
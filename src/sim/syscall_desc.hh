@@ -44,6 +44,7 @@
 
 #include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 
 #include "base/logging.hh"
@@ -77,6 +78,15 @@ class SyscallDesc
      */
     void doSyscall(ThreadContext *tc);
 
+    /**
+     * Syscalls share process state such as file descriptors, memory maps
+     * and futexes between threads. When CPUs are simulated in parallel on
+     * their own event queues, only one of them may emulate a syscall, or
+     * otherwise change that state, at a time. The returned lock is empty
+     * when simulating on a single thread.
+     */
+    static std::unique_lock<std::recursive_mutex> lock();
+
     std::string name() const { return _name; }
     int num() const { return _num; }
 
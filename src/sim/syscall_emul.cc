@@ -157,6 +157,8 @@ exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
                  * all threads in the group.
                  */
                 if (*(p->exitGroup)) {
+                    EventQueue::ScopedMigration migrate(
+                            tc->getCpuPtr()->eventQueue());
                     tc->halt();
                 } else {
                     last_thread = false;
@@ -201,6 +203,7 @@ exitImpl(SyscallDesc *desc, ThreadContext *tc, bool group, int status)
     if (!p->vforkContexts.empty()) {
         ThreadContext *vtc = sys->threads[p->vforkContexts.front()];
         assert(vtc->status() == ThreadContext::Suspended);
+        EventQueue::ScopedMigration migrate(vtc->getCpuPtr()->eventQueue());
         vtc->activate();
     }
 
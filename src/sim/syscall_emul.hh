@@ -1701,13 +1701,19 @@ doClone(SyscallDesc *desc, ThreadContext *tc, RegVal flags, RegVal newStack,
     if (flags & OS::TGT_CLONE_CHILD_CLEARTID)
         cp->childClearTID = (uint64_t)ctidPtr;
 
-    ctc->clearArchRegs();
+    {
+        // The CPU of ctc may be simulated by another thread, on its own
+        // event queue.
+        EventQueue::ScopedMigration migrate(ctc->getCpuPtr()->eventQueue());
+
+        ctc->clearArchRegs();
 
-    OS::archClone(flags, p, cp, tc, ctc, newStack, tlsPtr);
+        OS::archClone(flags, p, cp, tc, ctc, newStack, tlsPtr);
 
-    desc->returnInto(ctc, 0);
+        desc->returnInto(ctc, 0);
 
-    ctc->activate();
+        ctc->activate();
+    }
 
     if (flags & OS::TGT_CLONE_VFORK) {
         tc->suspend();
@@ -2234,6 +2240,7 @@ execveFunc(SyscallDesc *desc, ThreadContext *tc,
     if (!p->vforkContexts.empty()) {
         ThreadContext *vtc = p->system->threads[p->vforkContexts.front()];
         assert(vtc->status() == ThreadContext::Suspended);
+        EventQueue::ScopedMigration migrate(vtc->getCpuPtr()->eventQueue());
         vtc->activate();
     }
 
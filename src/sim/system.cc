@@ -171,7 +171,10 @@ System::System(const Params &p)
       physProxy(_systemPort, p.cache_line_size),
       workload(p.workload),
       physmem(name() + ".physmem", p.memories, p.mmap_using_noreserve,
-              p.shared_backstore, p.auto_unlink_shared_backstore),
+              p.shared_backstore, p.auto_unlink_shared_backstore,
+              p.sparse_backstore, p.backstore_huge_pages,
+              p.backstore_huge_page_density),
+      touchedMemoryInterval(p.touched_memory_interval),
       ShadowRomRanges(p.shadow_rom_ranges.begin(),
                       p.shadow_rom_ranges.end()),
       memoryMode(p.mem_mode),
@@ -371,6 +374,24 @@ System::regStats()
                          .desc("Run time stat for" + namestr.str())
                          .prereq(*workItemStats[j]);
     }
+
+    if (physmem.sparse()) {
+        touchedMemory = new statistics::Value(this);
+        touchedMemory->name("touchedMemory")
+            .unit(statistics::units::Byte::get())
+            .desc("Bytes of the sparse backing store touched by the "
+                  "simulation")
+            .functor([this]() {
+                // checkpoints update the touched size too
+                if (touchedMemoryUpdate == MaxTick ||
+                        curTick() - touchedMemoryUpdate >=
+                        touchedMemoryInterval) {
+                    physmem.updateTouchedSize();
+                    touchedMemoryUpdate = curTick();
+                }
+                return physmem.touchedSize();
+            });
+    }
 }
 
 void
@@ -401,6 +401,18 @@ class System : public SimObject, public PCEventScope
 
     memory::PhysicalMemory physmem;
 
+    /**
+     * Host memory committed for a sparse backing store, only registered
+     * if the backing store is sparse.
+     */
+    statistics::Value *touchedMemory = nullptr;
+
+    /** Minimum time between two updates of the touched memory. */
+    const Tick touchedMemoryInterval;
+
+    /** When the touched memory was last updated, MaxTick if never. */
+    Tick touchedMemoryUpdate = MaxTick;
+
     AddrRangeList ShadowRomRanges;
 
     enums::MemoryMode memoryMode;
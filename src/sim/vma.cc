@@ -30,7 +30,12 @@
 
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
+#include <cerrno>
+#include <cstring>
+
+#include "base/intmath.hh"
 #include "base/types.hh"
 
 namespace gem5
@@ -50,6 +55,40 @@ VMA::fillMemPages(Addr start, Addr size, PortProxy &port) const
     }
 }
 
+bool
+VMA::mapMemPages(Addr start, Addr size, uint8_t *host_mem) const
+{
+    static const Addr host_page_bytes = sysconf(_SC_PAGESIZE);
+
+    auto offset = start - _addrRange.start();
+    if (offset >= _hostBufLen)
+        return true;
+
+    /**
+     * Pages past the end of the file are left zero-filled. Within the last
+     * page, the host zero-fills the part past the end of the file.
+     */
+    auto length = std::min(size, roundUp(_hostBufLen - offset, _pageBytes));
+    const uint8_t *host_buf = (uint8_t *)_hostBuf + offset;
+    off_t file_offset = _origHostBuf->getOffset() +
+        (host_buf - (uint8_t *)_origHostBuf->getBuffer());
+
+    if ((uintptr_t)host_mem % host_page_bytes ||
+            file_offset % host_page_bytes || length % host_page_bytes) {
+        return false;
+    }
+
+    void *ret = mmap(host_mem, length, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_FIXED, _origHostBuf->getFD(),
+                     file_offset);
+    if (ret == MAP_FAILED) {
+        DPRINTF(Vma, "Cannot map file pages at %#x: %s\n", start,
+                strerror(errno));
+        return false;
+    }
+    return true;
+}
+
 bool
 VMA::isStrictSuperset(const AddrRange &r) const
 {
@@ -120,7 +159,7 @@ VMA::sanityCheck()
 
 VMA::MappedFileBuffer::MappedFileBuffer(int fd, size_t length,
                                         off_t offset)
-    : _buffer(nullptr), _length(length), _offset(offset)
+    : _buffer(nullptr), _length(length), _offset(offset), _fd(-1)
 {
     panic_if(_length == 0, "Tried to mmap file of length zero");
 
@@ -145,6 +184,10 @@ VMA::MappedFileBuffer::MappedFileBuffer(int fd, size_t length,
     } else {
         panic("Tried to mmap 0 bytes");
     }
+
+    // Keep the file open to map its pages directly into simulated memory,
+    // since the target may close its descriptor right after mmap.
+    _fd = dup(fd);
 }
 
 VMA::MappedFileBuffer::~MappedFileBuffer()
@@ -154,6 +197,8 @@ VMA::MappedFileBuffer::~MappedFileBuffer()
                  "mmap: failed to unmap file-backed host memory: %s",
                  strerror(errno));
     }
+    if (_fd != -1)
+        close(_fd);
 }
 
 } // namespace gem5
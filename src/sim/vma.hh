@@ -88,6 +88,21 @@ class VMA
      */
     void fillMemPages(Addr start, Addr size, PortProxy &port) const;
 
+    /**
+     * Map the host file pages backing a section of this area directly over
+     * the host memory of the simulated physical pages, so that they are
+     * read from the host page cache on first access instead of being
+     * copied. The mapping is private, so writes are not propagated to the
+     * file, as with fillMemPages().
+     *
+     * @param start Target virtual address of the section.
+     * @param size Size of the section in bytes.
+     * @param host_mem Host memory of the physical pages of the section.
+     * @return False if the section cannot be mapped (e.g. it is not
+     * aligned to host pages) and has to be filled with fillMemPages().
+     */
+    bool mapMemPages(Addr start, Addr size, uint8_t *host_mem) const;
+
     /**
      * Returns true if desired range exists within this virtual memory area
      * and does not include the start and end addresses.
@@ -196,11 +211,13 @@ class VMA
         void *getBuffer() const { return _buffer; }
         uint64_t getLength() const { return _length; }
         off_t getOffset() const { return _offset; }
+        int getFD() const { return _fd; }
 
       private:
         void *_buffer;       // Host buffer ptr
         size_t _length;       // Length of host ptr
         off_t _offset;       // Offset in file at which mapping starts
+        int _fd;             // Private copy of the file descriptor
     };
 };
 
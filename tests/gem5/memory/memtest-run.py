@@ -24,14 +24,45 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import argparse
+
 import m5
 from m5.objects import *
 
 m5.util.addToPath("../../../configs/")
 from common.Caches import *
 
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "--atomic", action="store_true", help="Use atomic (non-timing) mode"
+)
+parser.add_argument(
+    "--snoop-filter-sets",
+    type=int,
+    default=0,
+    help="Bound the L2 crossbar snoop filter to this many sets",
+)
+parser.add_argument(
+    "--cores",
+    type=int,
+    default=8,
+    help="Number of testers, at most 8 with the false sharing method",
+)
+parser.add_argument(
+    "--functional-warming",
+    type=int,
+    default=0,
+    metavar="TICKS",
+    help="Bypass the caches and warm them functionally for this many "
+    "ticks before running in atomic mode",
+)
+args = parser.parse_args()
+if args.functional_warming and not args.atomic:
+    # The testers pick the way they access memory once and for all
+    parser.error("--functional-warming requires --atomic")
+
 # MAX CORES IS 8 with the fals sharing method
-nb_cores = 8
+nb_cores = args.cores
 cpus = [MemTest(max_loads=1e5, progress_interval=1e4) for i in range(nb_cores)]
 
 # system simulated
@@ -49,6 +80,11 @@ system.cpu_clk_domain = SrcClockDomain(
 )
 
 system.toL2Bus = L2XBar(clk_domain=system.cpu_clk_domain)
+if args.snoop_filter_sets:
+    # A filter much smaller than the L1s forces it to recall lines,
+    # dirty ones included, from the caches above
+    system.toL2Bus.snoop_filter.sets = args.snoop_filter_sets
+    system.toL2Bus.snoop_filter.assoc = 4
 system.l2c = L2Cache(clk_domain=system.cpu_clk_domain, size="64kB", assoc=8)
 system.l2c.cpu_side = system.toL2Bus.mem_side_ports
 
@@ -60,7 +96,16 @@ for cpu in cpus:
     # All cpus are associated with cpu_clk_domain
     cpu.clk_domain = system.cpu_clk_domain
     cpu.l1c = L1Cache(size="32kB", assoc=4)
-    cpu.l1c.cpu_side = cpu.port
+    if args.functional_warming:
+        # The warmer replays the accesses the monitor sees on the tags
+        cpu.monitor = CommMonitor()
+        cpu.monitor.cpu_side_port = cpu.port
+        cpu.monitor.mem_side_port = cpu.l1c.cpu_side
+        cpu.warmer = CacheWarmer(
+            manager=cpu.monitor, dcaches=[cpu.l1c, system.l2c]
+        )
+    else:
+        cpu.l1c.cpu_side = cpu.port
     cpu.l1c.mem_side = system.toL2Bus.cpu_side_ports
 
 system.system_port = system.membus.cpu_side_ports
@@ -74,9 +119,19 @@ system.physmem.port = system.membus.mem_side_ports
 # -----------------------
 
 root = Root(full_system=False, system=system)
-root.system.mem_mode = "timing"
+root.system.mem_mode = "atomic" if args.atomic else "timing"
+if args.functional_warming:
+    root.system.mem_mode = "atomic_noncaching"
 
 m5.instantiate()
+if args.functional_warming:
+    # The testers check the data the warmed caches hold afterwards
+    exit_event = m5.simulate(args.functional_warming)
+    if exit_event.getCause() != "simulate() limit reached":
+        exit(1)
+    m5.drain()
+    MemoryMode = m5.params.allEnums["MemoryMode"]
+    system.setMemoryMode(MemoryMode("atomic").getValue())
 exit_event = m5.simulate()
 if exit_event.getCause() != "maximum number of loads reached":
     exit(1)
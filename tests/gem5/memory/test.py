@@ -70,6 +70,35 @@ gem5_verify_config(
     length=constants.long_tag,
 )
 
+# A bounded snoop filter recalls lines from the L1s, and must not lose the
+# data of dirty ones
+for mode_args, mode in (([], "timing"), (["--atomic"], "atomic")):
+    gem5_verify_config(
+        name="memtest-bounded-snoop-filter-" + mode,
+        verifiers=(),  # No need for verfiers this will return non-zero on fail
+        config=joinpath(getcwd(), "memtest-run.py"),
+        config_args=["--snoop-filter-sets", "16"] + mode_args,
+        valid_isas=(constants.null_tag,),
+        length=constants.long_tag,
+    )
+
+# The caches of two testers sharing lines are warmed functionally, and
+# must be left coherent when they are used again
+gem5_verify_config(
+    name="memtest-functional-warming",
+    verifiers=(),  # No need for verfiers this will return non-zero on fail
+    config=joinpath(getcwd(), "memtest-run.py"),
+    config_args=[
+        "--atomic",
+        "--cores",
+        "2",
+        "--functional-warming",
+        "10000000",
+    ],
+    valid_isas=(constants.null_tag,),
+    length=constants.long_tag,
+)
+
 null_tests = [
     ("garnet_synth_traffic", None, ["--sim-cycles", "5000000"]),
     ("memcheck", None, ["--maxtick", "2000000000", "--prefetchers"]),
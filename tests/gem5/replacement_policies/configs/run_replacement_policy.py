@@ -54,12 +54,22 @@ argparser.add_argument(
     type=str,
     help="Path to the python file" "specified by config_name.",
 )
+argparser.add_argument(
+    "--rp",
+    type=str,
+    default=None,
+    help="Name of a replacement policy class to use instead of the one "
+    "imported by the python file, to replay its traffic with a policy "
+    "which must make the same choices.",
+)
 
 args = argparser.parse_args()
 
 module = SourceFileLoader(args.config_name, args.config_path).load_module()
 python_generator = module.python_generator
 rp_class = module.rp
+if args.rp:
+    rp_class = getattr(m5.objects, args.rp)
 
 flags["RubyHitMiss"].enable()
 
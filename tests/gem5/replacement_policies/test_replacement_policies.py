@@ -30,8 +30,14 @@ import os
 from testlib import *
 
 
-def test_replacement_policy(config_name: str, config_path: str) -> None:
+def test_replacement_policy(
+    config_name: str, config_path: str, rp: str = None
+) -> None:
     name = f"test-replacement-policy-{config_name}"
+    config_args = [config_name, config_path]
+    if rp:
+        name += f"-{rp}"
+        config_args += ["--rp", rp]
 
     verifiers = (
         verifier.MatchStdoutNoPerf(joinpath(getcwd(), "ref", config_name[7:])),
@@ -48,7 +54,7 @@ def test_replacement_policy(config_name: str, config_path: str) -> None:
             "configs",
             "run_replacement_policy.py",
         ),
-        config_args=[config_name, config_path],
+        config_args=config_args,
         valid_isas=(constants.null_tag,),
         protocol="MI_example",
         valid_hosts=constants.supported_hosts,
@@ -56,12 +62,12 @@ def test_replacement_policy(config_name: str, config_path: str) -> None:
     )
 
 
-def create_replacement_policy_tests(traces):
+def create_replacement_policy_tests(traces, rp=None):
     this_dir = os.path.dirname(__file__)
     for trace in traces:
         config_name = trace.split(".")[0]
         config_path = os.path.join(this_dir, trace)
-        test_replacement_policy(config_name, config_path)
+        test_replacement_policy(config_name, config_path, rp)
 
 
 traces = [
@@ -109,3 +115,21 @@ traces = [
     "traces/tree_plru_test3_st.py",
 ]
 create_replacement_policy_tests(traces)
+
+# The packed policies replay the traces of the policies they pack, and must
+# match the same references
+packed_policies = {
+    "lru_": "PackedLRURP",
+    "nru_": "PackedNRURP",
+    "rrip_": "PackedRRIPRP",
+    "tree_plru_": "PackedTreePLRURP",
+}
+for prefix, rp in packed_policies.items():
+    create_replacement_policy_tests(
+        [
+            trace
+            for trace in traces
+            if os.path.basename(trace).startswith(prefix)
+        ],
+        rp,
+    )
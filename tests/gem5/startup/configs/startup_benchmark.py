@@ -0,0 +1,87 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Time m5.instantiate() on a large configuration, to catch regressions in
+the cost of starting gem5 up. The configuration is a hierarchy of
+clusters, each with its own clock domain and many objects resolving
+proxies to it, much like the controllers and message buffers of a
+many-core Ruby system.
+"""
+
+import argparse
+import time
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "--clusters", type=int, default=128, help="Number of clusters"
+)
+parser.add_argument(
+    "--objects",
+    type=int,
+    default=64,
+    help="Number of objects per cluster",
+)
+parser.add_argument(
+    "--max-seconds",
+    type=float,
+    default=None,
+    help="Fail if instantiating takes longer than this",
+)
+args = parser.parse_args()
+
+system = System()
+system.voltage_domain = VoltageDomain()
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=Parent.voltage_domain
+)
+
+clusters = []
+for i in range(args.clusters):
+    cluster = SubSystem()
+    cluster.clk_domain = SrcClockDomain(
+        clock="2GHz", voltage_domain=Parent.voltage_domain
+    )
+    cluster.domains = [
+        DerivedClockDomain(clk_domain=Parent.clk_domain, clk_divider=2)
+        for _ in range(args.objects)
+    ]
+    clusters.append(cluster)
+system.clusters = clusters
+
+root = Root(full_system=False, system=system)
+
+num_objs = len(list(root.descendants()))
+start = time.perf_counter()
+m5.instantiate()
+elapsed = time.perf_counter() - start
+
+print(f"Instantiated {num_objs} SimObjects in {elapsed:.3f}s")
+if args.max_seconds is not None and elapsed > args.max_seconds:
+    m5.util.fatal(f"Instantiation took longer than {args.max_seconds:.3f}s")
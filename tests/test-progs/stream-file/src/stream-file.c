@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Streams a file through read(), pread() or readv() and optionally copies
+ * it to a second file with write(), to measure how fast syscall emulation
+ * moves buffers in and out of simulated memory. The program does almost no
+ * computation, so the host time spent is dominated by the syscalls.
+ *
+ * Usage: stream_file [-m read|pread|readv] [-b block_size] <in> [<out>]
+ *
+ * A checksum of the data is printed so runs can be checked against the
+ * same program run natively.
+ */
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+enum Mode { ModeRead, ModePread, ModeReadv };
+
+static void
+usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [-m read|pread|readv] [-b block_size] <in> [<out>]\n",
+            prog);
+    exit(2);
+}
+
+int
+main(int argc, char *argv[])
+{
+    enum Mode mode = ModeRead;
+    size_t block_size = 1 << 20;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "m:b:")) != -1) {
+        if (opt == 'm' && strcmp(optarg, "read") == 0)
+            mode = ModeRead;
+        else if (opt == 'm' && strcmp(optarg, "pread") == 0)
+            mode = ModePread;
+        else if (opt == 'm' && strcmp(optarg, "readv") == 0)
+            mode = ModeReadv;
+        else if (opt == 'b')
+            block_size = strtoul(optarg, NULL, 0);
+        else
+            usage(argv[0]);
+    }
+    if (optind >= argc || block_size < 2)
+        usage(argv[0]);
+
+    int in = open(argv[optind], O_RDONLY);
+    if (in < 0) {
+        perror(argv[optind]);
+        return 1;
+    }
+    int out = -1;
+    if (optind + 1 < argc) {
+        out = open(argv[optind + 1], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out < 0) {
+            perror(argv[optind + 1]);
+            return 1;
+        }
+    }
+
+    uint8_t *buf = malloc(block_size);
+    if (!buf) {
+        perror("malloc");
+        return 1;
+    }
+
+    uint64_t total = 0;
+    uint32_t sum_a = 1, sum_b = 0;
+    for (;;) {
+        ssize_t got;
+        if (mode == ModePread) {
+            got = pread(in, buf, block_size, total);
+        } else if (mode == ModeReadv) {
+            // Split the buffer so that the iovecs don't share a page.
+            struct iovec iov[2] = {
+                { buf, block_size / 2 },
+                { buf + block_size / 2, block_size - block_size / 2 },
+            };
+            got = readv(in, iov, 2);
+        } else {
+            got = read(in, buf, block_size);
+        }
+        if (got < 0) {
+            perror("read");
+            return 1;
+        }
+        if (got == 0)
+            break;
+
+        // Adler-32, touching each byte once so the copy can't be elided.
+        for (ssize_t i = 0; i < got; i++) {
+            sum_a = (sum_a + buf[i]) % 65521;
+            sum_b = (sum_b + sum_a) % 65521;
+        }
+        if (out >= 0 && write(out, buf, got) != got) {
+            perror("write");
+            return 1;
+        }
+        total += got;
+    }
+
+    printf("%llu bytes, adler32 %08x\n", (unsigned long long)total,
+           (sum_b << 16) | sum_a);
+
+    free(buf);
+    close(in);
+    if (out >= 0)
+        close(out);
+    return 0;
+}
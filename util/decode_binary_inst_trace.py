@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script prints an instruction trace written by the InstBinTrace
+# tracer as text similar to the Exec debug output. Instructions are
+# disassembled with capstone (https://www.capstone-engine.org) when its
+# Python module is installed and an ISA is given, and are otherwise shown
+# as raw bytes.
+#
+# Usage: decode_binary_inst_trace.py [--isa ISA] <trace> [<out>]
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = b"gem5itr\0"
+VERSION = 1
+
+MEM_VALID = 0x01
+DATA_VALID = 0x02
+DATA_WIDE = 0x04
+DATA_FLOAT = 0x08
+MICROOP = 0x10
+PREDICATED_FALSE = 0x20
+FAULTING = 0x40
+USER_MODE = 0x80
+
+MASK64 = 2**64 - 1
+
+# Capstone architecture and mode for each ISA, as attribute names so that
+# capstone is only needed when disassembling.
+CAPSTONE_ISAS = {
+    "arm": ("CS_ARCH_ARM", "CS_MODE_ARM"),
+    "thumb": ("CS_ARCH_ARM", "CS_MODE_THUMB"),
+    "arm64": ("CS_ARCH_ARM64", "CS_MODE_ARM"),
+    "x86": ("CS_ARCH_X86", "CS_MODE_64"),
+    "riscv": ("CS_ARCH_RISCV", "CS_MODE_RISCV64"),
+    "mips": ("CS_ARCH_MIPS", "CS_MODE_MIPS64"),
+    "power": ("CS_ARCH_PPC", "CS_MODE_64"),
+    "sparc": ("CS_ARCH_SPARC", "CS_MODE_V9"),
+}
+
+
+def read_frames(data):
+    """Yield the uncompressed blocks framed by AsyncWriter."""
+    pos = 0
+    while pos + 8 <= len(data):
+        raw_size, stored_size = struct.unpack_from("<II", data, pos)
+        pos += 8
+        block = data[pos : pos + stored_size]
+        pos += stored_size
+        yield zlib.decompress(block) if stored_size < raw_size else block
+
+
+class Columns:
+    def __init__(self, block):
+        self.block = block
+        self.pos = 0
+
+    def take(self, fmt, count):
+        values = struct.unpack_from(f"<{count}{fmt}", self.block, self.pos)
+        self.pos += struct.calcsize(f"<{count}{fmt}")
+        return values
+
+    def bytes(self, length):
+        value = self.block[self.pos : self.pos + length]
+        self.pos += length
+        return value
+
+
+def decode_block(block):
+    """Turn a columnar block back into a list of records."""
+    cols = Columns(block)
+    (count,) = cols.take("I", 1)
+    tick_deltas = cols.take("Q", count)
+    pc_deltas = cols.take("Q", count)
+    upcs = cols.take("H", count)
+    cpus = cols.take("H", count)
+    flags = cols.take("B", count)
+    sizes = cols.take("B", count)
+    insts = [cols.bytes(size) for size in sizes]
+    num_mem = sum(1 for f in flags if f & MEM_VALID)
+    mem_addrs = iter(cols.take("Q", num_mem))
+    mem_sizes = iter(cols.take("I", num_mem))
+    datas = iter(cols.take("Q", sum(1 for f in flags if f & DATA_VALID)))
+
+    tick = pc = 0
+    records = []
+    for i in range(count):
+        tick = (tick + tick_deltas[i]) & MASK64
+        pc = (pc + pc_deltas[i]) & MASK64
+        rec = {
+            "tick": tick,
+            "pc": pc,
+            "upc": upcs[i],
+            "cpu": cpus[i],
+            "flags": flags[i],
+            "inst": insts[i],
+        }
+        if flags[i] & MEM_VALID:
+            rec["addr"] = next(mem_addrs)
+            rec["size"] = next(mem_sizes)
+        if flags[i] & DATA_VALID:
+            rec["data"] = next(datas)
+        records.append(rec)
+    return records
+
+
+class Disassembler:
+    def __init__(self, isa):
+        self.md = None
+        if not isa:
+            return
+        try:
+            import capstone
+        except ImportError:
+            print(
+                "capstone is not installed, printing raw instructions",
+                file=sys.stderr,
+            )
+            return
+        arch, mode = CAPSTONE_ISAS[isa]
+        self.md = capstone.Cs(
+            getattr(capstone, arch), getattr(capstone, mode)
+        )
+        self.cache = {}
+
+    def __call__(self, inst, pc):
+        if not inst:
+            return ""
+        if not self.md:
+            return inst.hex()
+        # Loops run the same instructions over and over, so remember them
+        # by PC. The PC is part of the key as relative branches and loads
+        # disassemble to different targets at different addresses.
+        key = (pc, inst)
+        text = self.cache.get(key)
+        if text is None:
+            decoded = next(self.md.disasm(inst, pc, 1), None)
+            if decoded is None:
+                text = f".byte {inst.hex()}"
+            else:
+                text = f"{decoded.mnemonic} {decoded.op_str}".strip()
+            self.cache[key] = text
+        return text
+
+
+def format_record(rec, disassemble):
+    flags = rec["flags"]
+    line = [f"{rec['tick']:7d}: cpu{rec['cpu']}: {rec['pc']:#x}"]
+    line.append(f".{rec['upc']:2d}" if flags & MICROOP else "   ")
+    line.append(f" : {disassemble(rec['inst'], rec['pc']):26s} :")
+    if flags & PREDICATED_FALSE:
+        line.append(" Predicated False")
+    if flags & DATA_VALID:
+        if flags & DATA_FLOAT:
+            value = struct.unpack("<d", struct.pack("<Q", rec["data"]))[0]
+            line.append(f" D={value:f}")
+        else:
+            line.append(f" D={rec['data']:#018x}")
+        if flags & DATA_WIDE:
+            line.append("...")
+    if flags & MEM_VALID:
+        line.append(f" A={rec['addr']:#x} S={rec['size']}")
+    if flags & FAULTING:
+        line.append(" (faulting)")
+    return "".join(line)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Print a gem5 binary instruction trace as text"
+    )
+    parser.add_argument("trace", help="Trace written by InstBinTrace")
+    parser.add_argument(
+        "out", nargs="?", default="-", help="Output file [Default: stdout]"
+    )
+    parser.add_argument(
+        "--isa",
+        choices=sorted(CAPSTONE_ISAS),
+        help="Disassemble the instructions with capstone for this ISA",
+    )
+    parser.add_argument(
+        "--user", action="store_true", help="Only print user mode records"
+    )
+    args = parser.parse_args()
+
+    with open(args.trace, "rb") as f:
+        frames = read_frames(f.read())
+
+    header = next(frames, b"")
+    if header[: len(MAGIC)] != MAGIC:
+        sys.exit(f"{args.trace} is not a gem5 binary instruction trace")
+    version, tick_freq = struct.unpack_from("<IQ", header, len(MAGIC))
+    if version != VERSION:
+        sys.exit(f"Unsupported binary instruction trace version {version}")
+
+    disassemble = Disassembler(args.isa)
+    out = sys.stdout if args.out == "-" else open(args.out, "w")
+    print(f"# Tick frequency: {tick_freq}", file=out)
+    for block in frames:
+        for rec in decode_block(block):
+            if args.user and not rec["flags"] & USER_MODE:
+                continue
+            print(format_record(rec, disassemble), file=out)
+
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
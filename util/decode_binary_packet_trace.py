@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts a packet trace written by the MemBinTraceProbe to
+# the same ASCII format as decode_packet_trace.py, one packet per line:
+# <cmd>,<addr>,<size>,<flags>,<tick>[,<pc>], followed by the requestor
+# name with --requestors.
+#
+# Usage: decode_binary_packet_trace.py [--requestors] <trace> [<out>]
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = b"gem5ptr\0"
+VERSION = 1
+RECORD = struct.Struct("<QQQQIHH")
+
+
+def read_frames(data):
+    """Yield the uncompressed blocks framed by AsyncWriter."""
+    pos = 0
+    while pos + 8 <= len(data):
+        raw_size, stored_size = struct.unpack_from("<II", data, pos)
+        pos += 8
+        block = data[pos : pos + stored_size]
+        pos += stored_size
+        yield zlib.decompress(block) if stored_size < raw_size else block
+
+
+def read_header(header):
+    if header[: len(MAGIC)] != MAGIC:
+        return None
+    pos = len(MAGIC)
+    version, tick_freq, sample_period = struct.unpack_from("<IQQ", header, pos)
+    pos += 20
+
+    def string():
+        nonlocal pos
+        (length,) = struct.unpack_from("<I", header, pos)
+        pos += 4
+        pos += length
+        return header[pos - length : pos].decode(errors="replace")
+
+    name = string()
+    (count,) = struct.unpack_from("<I", header, pos)
+    pos += 4
+    requestors = [string() for _ in range(count)]
+    return version, tick_freq, sample_period, name, requestors
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert a gem5 binary packet trace to ASCII"
+    )
+    parser.add_argument("trace", help="Trace written by MemBinTraceProbe")
+    parser.add_argument(
+        "out", nargs="?", default="-", help="Output file [Default: stdout]"
+    )
+    parser.add_argument(
+        "--requestors",
+        action="store_true",
+        help="Append the name of the requestor to each packet",
+    )
+    args = parser.parse_args()
+
+    with open(args.trace, "rb") as f:
+        frames = read_frames(f.read())
+
+    header = read_header(next(frames, b""))
+    if header is None:
+        sys.exit(f"{args.trace} is not a gem5 binary packet trace")
+    version, tick_freq, sample_period, name, requestors = header
+    if version != VERSION:
+        sys.exit(f"Unsupported binary packet trace version {version}")
+
+    print("Object id:", name, file=sys.stderr)
+    print("Tick frequency:", tick_freq, file=sys.stderr)
+    if sample_period > 1:
+        print(f"Sampled 1 in {sample_period} packets", file=sys.stderr)
+
+    out = sys.stdout if args.out == "-" else open(args.out, "w")
+    num_packets = 0
+    for block in frames:
+        for tick, addr, pc, flags, size, cmd, req in RECORD.iter_unpack(
+            block
+        ):
+            num_packets += 1
+            # ReadReq is 1 and WriteReq is 4 in src/mem/packet.hh Command enum
+            kind = "r" if cmd == 1 else ("w" if cmd == 4 else "u")
+            line = f"{kind},{addr},{size},{flags},{tick}"
+            if pc:
+                line += f",{pc}"
+            if args.requestors:
+                name = requestors[req] if req < len(requestors) else req
+                line += f" {name}"
+            print(line, file=out)
+
+    print("Parsed packets:", num_packets, file=sys.stderr)
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
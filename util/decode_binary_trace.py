@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script renders a binary debug trace, as written by gem5 when run
+# with --debug-ring=N, as the text gem5 would have printed with the same
+# debug flags. Formatting follows base/cprintf.cc: a conversion consumes
+# one argument and non-matching argument types are printed the way
+# cprintf would print them.
+#
+# Usage: decode_binary_trace.py [--flags] [--no-ticks] <trace> [<out>]
+
+import argparse
+import gzip
+import re
+import struct
+import sys
+
+MAGIC = b"gem5btr\0"
+VERSION = 2
+MAX_TICK = 2**64 - 1
+
+ARG_SIGNED, ARG_UNSIGNED, ARG_FLOAT, ARG_CHAR, ARG_STRING, ARG_POINTER = range(
+    6
+)
+
+# %[flags][width][.precision][length]conversion, or %% / literal text
+FORMAT_RE = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<prec>\*|\d+))?"
+    r"[hlqLjzt]*(?P<conv>[a-zA-Z%])"
+)
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def unpack(self, fmt):
+        values = struct.unpack_from("<" + fmt, self.data, self.pos)
+        self.pos += struct.calcsize("<" + fmt)
+        return values if len(values) > 1 else values[0]
+
+    def bytes(self, length):
+        value = self.data[self.pos : self.pos + length]
+        self.pos += length
+        return value
+
+    def table(self):
+        count = self.unpack("I")
+        return [
+            self.bytes(self.unpack("I")).decode(errors="replace")
+            for _ in range(count)
+        ]
+
+
+def decode_args(payload, num_args):
+    reader = Reader(payload)
+    args = []
+    for _ in range(num_args):
+        kind = reader.unpack("B")
+        if kind == ARG_SIGNED:
+            args.append((kind, reader.unpack("q")))
+        elif kind in (ARG_UNSIGNED, ARG_POINTER):
+            args.append((kind, reader.unpack("Q")))
+        elif kind == ARG_FLOAT:
+            args.append((kind, reader.unpack("d")))
+        elif kind == ARG_CHAR:
+            args.append((kind, reader.unpack("B")))
+        elif kind == ARG_STRING:
+            length = reader.unpack("H")
+            args.append((kind, reader.bytes(length).decode(errors="replace")))
+        else:
+            raise ValueError(f"Unknown argument type {kind}")
+    return args
+
+
+def format_one(flags, width, prec, conv, arg):
+    kind, value = arg
+
+    if kind == ARG_STRING:
+        spec = "%" + ("-" if "-" in flags else "") + (width or "") + "s"
+        return spec % value
+
+    if conv in "sc" and kind == ARG_CHAR:
+        return ("%" + flags + (width or "") + "c") % value
+
+    if conv in "eEfgG":
+        spec = "%" + flags + (width or "")
+        if prec is not None:
+            spec += "." + prec
+        return (spec + conv) % float(value)
+
+    if kind == ARG_FLOAT:
+        return ("%" + flags + (width or "") + "g") % value
+
+    # Integers. cprintf treats a precision on an integer as a zero-filled
+    # width, and %p as %#x.
+    if prec is not None:
+        width = prec
+        flags += "0"
+    if conv == "p" or kind == ARG_POINTER and conv == "s":
+        conv = "x"
+        flags += "#"
+    if conv in "xXo":
+        return ("%" + flags + (width or "") + conv) % value
+    if conv == "c":
+        return ("%" + flags + (width or "") + "c") % (value & 0xFF)
+    return ("%" + flags + (width or "") + "d") % value
+
+
+def render(fmt, args, truncated):
+    out = []
+    pos = 0
+    args = list(args)
+    for match in FORMAT_RE.finditer(fmt):
+        out.append(fmt[pos : match.start()])
+        pos = match.end()
+        conv = match.group("conv")
+        if conv == "%":
+            out.append("%")
+            continue
+        width = match.group("width")
+        prec = match.group("prec")
+        if width == "*":
+            width = str(args.pop(0)[1]) if args else None
+        if prec == "*":
+            prec = str(args.pop(0)[1]) if args else None
+        if not args:
+            out.append("<truncated>" if truncated else "<missing arg>")
+            continue
+        try:
+            out.append(
+                format_one(match.group("flags"), width, prec, conv, args[0])
+            )
+        except (TypeError, ValueError, OverflowError):
+            out.append(str(args[0][1]))
+        args.pop(0)
+    out.append(fmt[pos:])
+    if truncated:
+        out.append("<truncated>\n" if not out[-1].endswith("\n") else "")
+    return "".join(out).replace("\r\n", "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Render a gem5 binary debug trace as text"
+    )
+    parser.add_argument("trace", help="Binary trace written by gem5")
+    parser.add_argument(
+        "out", nargs="?", default="-", help="Output file [Default: stdout]"
+    )
+    parser.add_argument(
+        "--flags",
+        action="store_true",
+        help="Prefix each line with its debug flag, like FmtFlag",
+    )
+    parser.add_argument(
+        "--no-ticks",
+        action="store_true",
+        help="Do not print the tick, like FmtTicksOff",
+    )
+    args = parser.parse_args()
+
+    opener = gzip.open if args.trace.endswith(".gz") else open
+    with opener(args.trace, "rb") as f:
+        reader = Reader(f.read())
+
+    if reader.bytes(len(MAGIC)) != MAGIC:
+        sys.exit(f"{args.trace} is not a gem5 binary trace")
+    version = reader.unpack("I")
+    if version != VERSION:
+        sys.exit(f"Unsupported binary trace version {version}")
+
+    flags = reader.table()
+    formats = reader.table()
+    written = reader.unpack("Q")
+
+    # Records follow until the end of the file. Slots being overwritten
+    # while the ring was dumped are left out, so count what is there.
+    records = []
+    header = struct.calcsize("<QIIBBHH")
+    while reader.pos + header <= len(reader.data):
+        when, flag, fmt, num_args, truncated, name_size, size = reader.unpack(
+            "QIIBBHH"
+        )
+        name = reader.bytes(name_size).decode(errors="replace")
+        payload = reader.bytes(size)
+        records.append((when, flag, fmt, num_args, truncated, name, payload))
+
+    out = sys.stdout if args.out == "-" else open(args.out, "w")
+    dropped = written - len(records)
+    if dropped:
+        print(
+            f"{dropped} earlier messages were overwritten in the ring",
+            file=sys.stderr,
+        )
+
+    for when, flag, fmt, num_args, truncated, name, payload in records:
+        message = render(
+            formats[fmt], decode_args(payload, num_args), truncated
+        )
+
+        line = []
+        if not args.no_ticks and when != MAX_TICK:
+            line.append(f"{when:7d}: ")
+        if args.flags and flags[flag]:
+            line.append(f"{flags[flag]}: ")
+        if name:
+            line.append(f"{name}: ")
+        line.append(message)
+        out.write("".join(line))
+
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
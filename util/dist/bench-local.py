@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script compares the host run time of a dist-gem5 simulation on a
+# single host with each combination of message transport (TCP sockets or
+# shared memory) and synchronisation mode (fixed or adaptive quantum).
+# All gem5 processes (the switch and one per simulated node) are started
+# locally, so the host needs at least nodes + 1 cores for the numbers to
+# be meaningful.
+#
+# Usage: bench-local.py -x <gem5 binary> -n <nodes> --fs-args "<args>"
+#
+# The node arguments are passed to the full system config, e.g.
+#   --fs-args "--kernel=vmlinux --disk-image=disk.img --script=run.rcS"
+# and should make every node exit (m5 exit) at the end of the workload.
+
+import argparse
+import os
+import re
+import shlex
+import subprocess
+import sys
+import time
+
+M5_PATH = os.path.dirname(os.path.dirname(os.path.dirname(__file__)))
+
+MODES = {
+    "tcp": ["--dist-transport=tcp"],
+    "tcp-adaptive": ["--dist-transport=tcp", "--dist-adaptive-sync"],
+    "shm": ["--dist-transport=shm"],
+    "shm-adaptive": ["--dist-transport=shm", "--dist-adaptive-sync"],
+}
+
+PORT_REGEX = re.compile(r"tcp_iface listening on port ([0-9]+)")
+
+
+def wait_for_port(log_path, proc, timeout):
+    """Return the port the switch listens on, as reported in its log."""
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        with open(log_path) as f:
+            match = PORT_REGEX.search(f.read())
+        if match:
+            return int(match.group(1))
+        if proc.poll() is not None:
+            break
+        time.sleep(0.1)
+    return None
+
+
+def sim_seconds(stats_path):
+    """Return the simulated seconds of the first stats dump."""
+    try:
+        with open(stats_path) as f:
+            for line in f:
+                if line.startswith("simSeconds"):
+                    return float(line.split()[1])
+    except OSError:
+        pass
+    return None
+
+
+def run_mode(args, mode):
+    rundir = os.path.join(args.rundir, mode)
+    os.makedirs(rundir, exist_ok=True)
+    common = MODES[mode] + [f"--dist-size={args.nodes}"]
+    procs = []
+
+    start = time.monotonic()
+    sw_log = os.path.join(rundir, "log.switch")
+    switch = subprocess.Popen(
+        [args.gem5, "-d", os.path.join(rundir, "m5out.switch")]
+        + [args.sw_config]
+        + shlex.split(args.sw_args)
+        + ["--is-switch", f"--dist-server-port={args.port}"]
+        + common,
+        stdout=open(sw_log, "w"),
+        stderr=subprocess.STDOUT,
+    )
+    procs.append(switch)
+
+    port = args.port
+    if mode.startswith("tcp"):
+        port = wait_for_port(sw_log, switch, args.timeout)
+        if port is None:
+            switch.kill()
+            print(f"{mode}: switch did not start, see {sw_log}")
+            return None
+
+    for rank in range(args.nodes):
+        procs.append(
+            subprocess.Popen(
+                [args.gem5, "-d", os.path.join(rundir, f"m5out.{rank}")]
+                + [args.fs_config]
+                + shlex.split(args.fs_args)
+                + [
+                    "--dist",
+                    f"--dist-rank={rank}",
+                    "--dist-server-name=127.0.0.1",
+                    f"--dist-server-port={port}",
+                ]
+                + common,
+                stdout=open(os.path.join(rundir, f"log.{rank}"), "w"),
+                stderr=subprocess.STDOUT,
+            )
+        )
+
+    failed = 0
+    for proc in procs:
+        try:
+            remaining = max(0, start + args.timeout - time.monotonic())
+            if proc.wait(timeout=remaining) != 0:
+                failed += 1
+        except subprocess.TimeoutExpired:
+            proc.kill()
+            failed += 1
+    elapsed = time.monotonic() - start
+
+    if failed:
+        print(f"{mode}: {failed} gem5 processes failed, see {rundir}")
+        return None
+    return elapsed, sim_seconds(os.path.join(rundir, "m5out.0", "stats.txt"))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark dist-gem5 transports and sync modes on "
+        "the local host"
+    )
+    parser.add_argument(
+        "-x", "--gem5", required=True, help="gem5 binary to benchmark"
+    )
+    parser.add_argument(
+        "-n", "--nodes", type=int, default=2, help="Number of nodes"
+    )
+    parser.add_argument(
+        "--modes",
+        default=",".join(MODES),
+        help="Comma separated list of modes [Default: all of %(default)s]",
+    )
+    parser.add_argument(
+        "--fs-config",
+        default=os.path.join(M5_PATH, "configs/deprecated/example/fs.py"),
+        help="Full system config of the nodes",
+    )
+    parser.add_argument(
+        "--fs-args", default="", help="Arguments for the node config"
+    )
+    parser.add_argument(
+        "--sw-config",
+        default=os.path.join(M5_PATH, "configs/dist/sw.py"),
+        help="Config of the switch",
+    )
+    parser.add_argument(
+        "--sw-args", default="", help="Arguments for the switch config"
+    )
+    parser.add_argument(
+        "-r", "--rundir", default="bench-local", help="Output directory"
+    )
+    parser.add_argument(
+        "-p",
+        "--port",
+        type=int,
+        default=2200,
+        help="Switch port (also names the shared memory segments)",
+    )
+    parser.add_argument(
+        "--timeout",
+        type=float,
+        default=3600,
+        help="Seconds before a mode is given up [Default: %(default)s]",
+    )
+    args = parser.parse_args()
+
+    modes = args.modes.split(",")
+    for mode in modes:
+        if mode not in MODES:
+            sys.exit(f"Unknown mode {mode}, choose from {', '.join(MODES)}")
+
+    results = {mode: run_mode(args, mode) for mode in modes}
+
+    baseline = results[modes[0]]
+    print(f"{'mode':<14} {'host s':>10} {'sim s':>12} {'speedup':>8}")
+    for mode, result in results.items():
+        if result is None:
+            print(f"{mode:<14} {'failed':>10}")
+            continue
+        elapsed, simulated = result
+        simulated = f"{simulated:.6f}" if simulated is not None else "-"
+        speedup = f"{baseline[0] / elapsed:.2f}" if baseline else "-"
+        print(f"{mode:<14} {elapsed:>10.1f} {simulated:>12} {speedup:>8}")
+
+
+if __name__ == "__main__":
+    main()
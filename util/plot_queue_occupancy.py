@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script summarises and plots the queue occupancy time series written
+# by a QueueSampler. For every sampled queue it reports the mean and
+# maximum occupancy, how often the queue was not empty and, for bounded
+# queues (MSHRs, write buffers, memory controller queues), how often it
+# was full. The queues are listed most saturated first, so the level of
+# the hierarchy that limits bandwidth is at the top.
+#
+# Usage: plot_queue_occupancy.py [--match REGEX] [--plot FILE] <series>
+
+import argparse
+import gzip
+import re
+import struct
+import sys
+
+MAGIC = b"gem5qoc\0"
+VERSION = 1
+
+
+class Series:
+    def __init__(self, name, capacity):
+        self.name = name
+        self.capacity = capacity
+        self.values = []
+
+    def summary(self):
+        samples = len(self.values)
+        if not samples:
+            return 0.0, 0, 0.0, None
+        mean = sum(self.values) / samples
+        busy = sum(1 for v in self.values if v) / samples
+        full = None
+        if self.capacity:
+            full = sum(1 for v in self.values if v >= self.capacity) / samples
+        return mean, max(self.values), busy, full
+
+
+def read_series(path):
+    opener = gzip.open if path.endswith(".gz") else open
+    with opener(path, "rb") as f:
+        data = f.read()
+
+    if data[: len(MAGIC)] != MAGIC:
+        sys.exit(f"{path} is not a queue occupancy time series")
+    pos = len(MAGIC)
+    version, interval, count = struct.unpack_from("<IQI", data, pos)
+    pos += struct.calcsize("<IQI")
+    if version != VERSION:
+        sys.exit(f"Unsupported time series version {version}")
+
+    series = []
+    for _ in range(count):
+        (length,) = struct.unpack_from("<I", data, pos)
+        pos += 4
+        name = data[pos : pos + length].decode()
+        pos += length
+        (capacity,) = struct.unpack_from("<I", data, pos)
+        pos += 4
+        series.append(Series(name, capacity))
+
+    record = struct.Struct(f"<Q{count}H")
+    # A run killed while writing leaves a partial record at the end.
+    end = pos + (len(data) - pos) // record.size * record.size
+    ticks = []
+    for values in record.iter_unpack(data[pos:end]):
+        ticks.append(values[0])
+        for s, v in zip(series, values[1:]):
+            s.values.append(v)
+
+    return interval, ticks, series
+
+
+def plot(path, ticks, series):
+    try:
+        import matplotlib
+
+        matplotlib.use("Agg")
+        import matplotlib.pyplot as plt
+    except ImportError:
+        sys.exit("Plotting requires matplotlib")
+
+    # One panel per sampled object, bounded queues in % of their capacity.
+    objects = {}
+    for s in series:
+        objects.setdefault(s.name.rsplit(".", 1)[0], []).append(s)
+
+    fig, axes = plt.subplots(
+        len(objects),
+        1,
+        sharex=True,
+        squeeze=False,
+        figsize=(10, 2.2 * len(objects)),
+    )
+    xs = [t / 1e12 for t in ticks]
+    for ax, (obj, members) in zip(axes[:, 0], objects.items()):
+        for s in members:
+            label = s.name.rsplit(".", 1)[1]
+            if s.capacity:
+                ys = [100.0 * v / s.capacity for v in s.values]
+                label += f" (/{s.capacity})"
+            else:
+                ys = s.values
+                label += " (entries)"
+            ax.step(xs, ys, where="post", label=label, linewidth=0.8)
+        ax.set_title(obj, fontsize="small")
+        ax.set_ylabel("% full / entries", fontsize="small")
+        ax.legend(fontsize="x-small", loc="upper right")
+    axes[-1, 0].set_xlabel("Simulated time (s)")
+    fig.tight_layout()
+    fig.savefig(path)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Summarise and plot a QueueSampler time series"
+    )
+    parser.add_argument("series", help="Time series written by gem5")
+    parser.add_argument(
+        "--match", help="Only consider the queues matching this regex"
+    )
+    parser.add_argument("--plot", help="Plot the time series to this file")
+    args = parser.parse_args()
+
+    interval, ticks, series = read_series(args.series)
+    if args.match:
+        series = [s for s in series if re.search(args.match, s.name)]
+    if not ticks or not series:
+        sys.exit("No samples to report")
+
+    print(
+        f"{len(ticks)} samples every {interval} ticks, "
+        f"from {ticks[0]} to {ticks[-1]}"
+    )
+    rows = [(s, *s.summary()) for s in series]
+    rows.sort(key=lambda r: (r[4] or 0.0, r[3]), reverse=True)
+    print(
+        f"{'queue':50s} {'capacity':>8s} {'mean':>8s} {'max':>6s} "
+        f"{'busy %':>7s} {'full %':>7s}"
+    )
+    for s, mean, peak, busy, full in rows:
+        print(
+            f"{s.name:50s} {s.capacity or '-':>8} {mean:8.2f} {peak:6d} "
+            f"{100 * busy:7.2f} "
+            + (f"{100 * full:7.2f}" if full is not None else f"{'-':>7s}")
+        )
+
+    if args.plot:
+        plot(args.plot, ticks, series)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+# This script evaluates many prefetcher configurations on a packet trace
+# written by the MemBinTraceProbe. Each configuration is a run of
+# configs/example/replay_prefetch.py in its own output directory, and the
+# runs are spread over the host cores. A baseline without a prefetcher is
+# always run as well, as timeliness and speedup are relative to it.
+#
+# A sweep is a prefetcher name followed by NAME=V1,V2,... parameters, and
+# every combination of the values is run:
+#   prefetch_sweep.py --gem5 build/ALL/gem5.opt --trace l2.ptrc \
+#       --sweep "StridePrefetcher degree=1,2,4 table_entries=64,256" \
+#       --sweep "AMPMPrefetcher" -- --size 512KiB --assoc 8
+#
+# Arguments after "--" are passed on to replay_prefetch.py. Reported
+# metrics, from the stats of the replayed cache:
+#   accuracy    useful prefetches / issued prefetches
+#   coverage    useful prefetches / (useful + demand MSHR misses)
+#   redundant   prefetches dropped because the line was already in the
+#               cache, an MSHR or the write buffer (gem5's pfLate)
+#   late        demands that hit an MSHR more often than in the baseline,
+#               that is demands which found their prefetch in flight
+#   timeliness  useful / (useful + late)
+#   speedup     baseline average read latency / average read latency
+#
+# Runs whose stats.txt already exists are not repeated unless --force is
+# given, so an interrupted sweep can be resumed.
+
+import argparse
+import concurrent.futures
+import csv
+import itertools
+import os
+import re
+import subprocess
+import sys
+
+CONFIG = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)),
+    os.pardir,
+    "configs",
+    "example",
+    "replay_prefetch.py",
+)
+
+CACHE = "system.cache."
+STATS = {
+    "pfIssued": CACHE + "prefetcher.pfIssued",
+    "pfUseful": CACHE + "prefetcher.pfUseful",
+    "pfUnused": CACHE + "prefetcher.pfUnused",
+    "redundant": CACHE + "prefetcher.pfLate",
+    "demandMshrHits": CACHE + "demandMshrHits::total",
+    "demandMshrMisses": CACHE + "demandMshrMisses::total",
+    "avgReadLatency": "system.replayer.avgReadLatency",
+}
+
+COLUMNS = [
+    "name",
+    "pfIssued",
+    "accuracy",
+    "coverage",
+    "redundant",
+    "late",
+    "timeliness",
+    "demandMshrMisses",
+    "missReduction",
+    "speedup",
+]
+
+STAT_RE = re.compile(r"^(\S+)\s+(\S+)")
+
+
+def parse_sweep(spec):
+    """Expand a sweep into (name, prefetcher, [NAME=VALUE, ...]) runs."""
+    words = spec.split()
+    if not words:
+        raise argparse.ArgumentTypeError("empty sweep")
+    prefetcher, axes = words[0], []
+    for word in words[1:]:
+        name, sep, values = word.partition("=")
+        if not sep or not values:
+            raise argparse.ArgumentTypeError(f"'{word}' is not NAME=VALUES")
+        axes.append([f"{name}={value}" for value in values.split(",")])
+
+    runs = []
+    for params in itertools.product(*axes):
+        label = "_".join([prefetcher] + [p.replace("=", "-") for p in params])
+        runs.append((re.sub(r"[^\w.-]", "_", label), prefetcher, list(params)))
+    return runs
+
+
+def read_stats(path):
+    """Read the values of STATS from the first dump of a stats file."""
+    wanted = {stat: key for key, stat in STATS.items()}
+    values = dict.fromkeys(STATS, 0.0)
+    with open(path) as f:
+        for line in f:
+            if line.startswith("---------- End"):
+                break
+            match = STAT_RE.match(line)
+            if match and match.group(1) in wanted:
+                try:
+                    values[wanted[match.group(1)]] = float(match.group(2))
+                except ValueError:
+                    pass
+    return values
+
+
+def run(args, name, prefetcher, params):
+    outdir = os.path.join(args.outdir, name)
+    stats = os.path.join(outdir, "stats.txt")
+    if args.force or not os.path.exists(stats):
+        cmd = [
+            args.gem5,
+            "-r",
+            "-e",
+            "-d",
+            outdir,
+            CONFIG,
+            "--trace",
+            args.trace,
+        ]
+        if prefetcher:
+            cmd += ["--prefetcher", prefetcher]
+        for param in params:
+            cmd += ["--param", param]
+        cmd += args.extra
+        os.makedirs(outdir, exist_ok=True)
+        result = subprocess.run(
+            cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL
+        )
+        if result.returncode != 0 or not os.path.exists(stats):
+            return name, None
+    return name, read_stats(stats)
+
+
+def metrics(name, values, base):
+    useful = values["pfUseful"]
+    issued = values["pfIssued"]
+    misses = values["demandMshrMisses"]
+    late = max(0.0, values["demandMshrHits"] - base["demandMshrHits"])
+
+    def ratio(num, den):
+        return num / den if den else 0.0
+
+    return {
+        "name": name,
+        "pfIssued": int(issued),
+        "accuracy": ratio(useful, issued),
+        "coverage": ratio(useful, useful + misses),
+        "redundant": int(values["redundant"]),
+        "late": int(late),
+        "timeliness": ratio(useful, useful + late),
+        "demandMshrMisses": int(misses),
+        "missReduction": ratio(
+            base["demandMshrMisses"] - misses, base["demandMshrMisses"]
+        ),
+        "speedup": ratio(base["avgReadLatency"], values["avgReadLatency"]),
+    }
+
+
+def format_cell(value):
+    if isinstance(value, float):
+        return f"{value:>17.4f}"
+    return f"{value:>17}"
+
+
+def main():
+    argv = sys.argv[1:]
+    extra = []
+    if "--" in argv:
+        extra = argv[argv.index("--") + 1 :]
+        argv = argv[: argv.index("--")]
+
+    parser = argparse.ArgumentParser(
+        description="Evaluate prefetcher configurations on a packet trace"
+    )
+    parser.add_argument("--gem5", required=True, help="gem5 binary to run")
+    parser.add_argument("--trace", required=True, help="Packet trace")
+    parser.add_argument(
+        "--outdir", default="prefetch_sweep", help="Directory of the runs"
+    )
+    parser.add_argument(
+        "--sweep",
+        type=parse_sweep,
+        action="append",
+        default=[],
+        help="Prefetcher followed by NAME=V1,V2,... parameters",
+    )
+    parser.add_argument(
+        "-j",
+        "--jobs",
+        type=int,
+        default=os.cpu_count(),
+        help="Number of gem5 runs at a time",
+    )
+    parser.add_argument("--csv", help="Also write the results to this file")
+    parser.add_argument(
+        "--force", action="store_true", help="Repeat finished runs"
+    )
+    args = parser.parse_args(argv)
+    args.extra = extra
+    args.trace = os.path.abspath(args.trace)
+
+    runs = [("baseline", None, [])]
+    for sweep in args.sweep:
+        runs += sweep
+    names = [name for name, _, _ in runs]
+    if len(set(names)) != len(names):
+        sys.exit("The sweeps contain the same configuration twice")
+
+    results = {}
+    with concurrent.futures.ThreadPoolExecutor(args.jobs) as pool:
+        futures = [pool.submit(run, args, *r) for r in runs]
+        for future in concurrent.futures.as_completed(futures):
+            name, values = future.result()
+            if values is None:
+                print(
+                    f"{name}: gem5 failed, see {args.outdir}/{name}",
+                    file=sys.stderr,
+                )
+            results[name] = values
+            print(f"[{len(results)}/{len(runs)}] {name}", file=sys.stderr)
+
+    base = results["baseline"]
+    if base is None:
+        sys.exit("The baseline run failed")
+
+    rows = [
+        metrics(name, results[name], base)
+        for name in names
+        if results[name] is not None
+    ]
+
+    width = max(len(name) for name in names)
+    print(f"{'name':<{width}}" + "".join(f"{c:>17}" for c in COLUMNS[1:]))
+    for row in rows:
+        cells = [format_cell(row[c]) for c in COLUMNS[1:]]
+        print(f"{row['name']:<{width}}" + "".join(cells))
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.DictWriter(f, fieldnames=COLUMNS)
+            writer.writeheader()
+            writer.writerows(rows)
+
+
+if __name__ == "__main__":
+    main()